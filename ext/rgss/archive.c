@@ -0,0 +1,724 @@
+#include "rgss.h"
+#include "vec.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+VALUE rb_cArchive;
+
+// Archives are little-endian, consisting of a header, the file contents, an index of entries sorted by the hash of
+// their path, and the null-terminated paths the index refers to.
+#define RGSS_ARCHIVE_MAGIC "RGSA"
+#define RGSS_ARCHIVE_VERSION 1
+#define RGSS_ARCHIVE_MAX_PATH 1024
+
+#define RGSS_ARCHIVE_STORED 0
+#define RGSS_ARCHIVE_LZ4 1
+
+typedef struct
+{
+    char magic[4];         /** Identifies the file as an archive. */
+    uint32_t version;      /** The version of the format. */
+    uint32_t count;        /** The number of entries. */
+    uint32_t reserved;     /** Unused, must be zero. */
+    uint64_t index_offset; /** The offset of the index from the start of the file. */
+    uint64_t names_offset; /** The offset of the path table from the start of the file. */
+} RGSS_ArchiveHeader;
+
+typedef struct
+{
+    uint64_t hash;        /** The FNV-1a hash of the normalized path. */
+    uint64_t offset;      /** The offset of the contents from the start of the file. */
+    uint32_t size;        /** The size of the contents as stored, in bytes. */
+    uint32_t raw_size;    /** The size of the contents when decompressed, in bytes. */
+    uint32_t name;        /** The offset of the normalized path within the path table. */
+    uint32_t compression; /** The compression method of the contents. */
+} RGSS_ArchiveEntry;
+
+typedef struct
+{
+    const unsigned char *data;        /** The mapped contents of the archive file. */
+    size_t size;                      /** The size of the archive file, in bytes. */
+    const RGSS_ArchiveEntry *entries; /** The sorted index. */
+    uint32_t count;                   /** The number of entries in the index. */
+    const char *names;                /** The path table. */
+    size_t names_size;                /** The size of the path table, in bytes. */
+    int mounted;                      /** Flag indicating if the archive is searched by file loads. */
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+} RGSS_Archive;
+
+static vec_void_t RGSS_ARCHIVES; /** The mounted archives, searched from last to first. */
+static VALUE RGSS_ARCHIVE_REFS;  /** Keeps mounted archives from being garbage collected. */
+
+static uint64_t RGSS_Archive_Hash(const char *path)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (; *path; path++)
+    {
+        hash ^= (unsigned char)*path;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static int RGSS_Archive_Normalize(const char *path, char *result)
+{
+    // Paths are matched case-insensitively, with either separator, and ignoring a leading "./"
+    while (path[0] == '.' && (path[1] == '/' || path[1] == '\\'))
+        path += 2;
+
+    size_t length = 0;
+    for (; *path; path++)
+    {
+        char c = *path == '\\' ? '/' : *path;
+        if (c == '/' && (length == 0 || result[length - 1] == '/'))
+            continue;
+        if (length + 1 >= RGSS_ARCHIVE_MAX_PATH)
+            return false;
+        result[length++] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+    result[length] = '\0';
+    return length > 0;
+}
+
+static int RGSS_LZ4_Decompress(const unsigned char *src, size_t src_size, unsigned char *dst, size_t dst_size)
+{
+    const unsigned char *ip = src, *iend = src + src_size;
+    unsigned char *op = dst, *oend = dst + dst_size;
+
+    while (ip < iend)
+    {
+        unsigned token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= iend)
+                    return false;
+                b = *ip++;
+                literals += b;
+            } while (b == 255);
+        }
+        if (literals > (size_t)(iend - ip) || literals > (size_t)(oend - op))
+            return false;
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+
+        // The last sequence consists only of literals
+        if (ip >= iend)
+            break;
+        if (iend - ip < 2)
+            return false;
+
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst))
+            return false;
+
+        size_t length = token & 15;
+        if (length == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= iend)
+                    return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+        }
+        length += 4;
+        if (length > (size_t)(oend - op))
+            return false;
+
+        const unsigned char *match = op - offset;
+        if (offset >= length)
+        {
+            memcpy(op, match, length);
+            op += length;
+        }
+        else
+        {
+            while (length--)
+                *op++ = *match++;
+        }
+    }
+    return op == oend;
+}
+
+static inline unsigned char *RGSS_LZ4_Length(unsigned char *op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *op++ = 255;
+    *op++ = (unsigned char)length;
+    return op;
+}
+
+static unsigned char *RGSS_LZ4_Sequence(unsigned char *op, const unsigned char *literals, size_t count, size_t offset,
+                                        size_t match)
+{
+    unsigned char *token = op++;
+    *token = (unsigned char)(RGSS_MIN(count, 15) << 4);
+    if (count >= 15)
+        op = RGSS_LZ4_Length(op, count - 15);
+    memcpy(op, literals, count);
+    op += count;
+
+    if (match)
+    {
+        *op++ = (unsigned char)offset;
+        *op++ = (unsigned char)(offset >> 8);
+        *token |= (unsigned char)RGSS_MIN(match - 4, 15);
+        if (match - 4 >= 15)
+            op = RGSS_LZ4_Length(op, match - 4 - 15);
+    }
+    return op;
+}
+
+static size_t RGSS_LZ4_Compress(const unsigned char *src, size_t size, unsigned char *dst, uint32_t *table)
+{
+    // Greedy matching with a single hash probe, the output is a standard LZ4 block
+    const size_t hash_bits = 16, limit = size > 12 ? size - 12 : 0;
+    unsigned char *op = dst;
+    size_t anchor = 0, pos = 0;
+    memset(table, 0, sizeof(uint32_t) << hash_bits);
+
+    while (pos < limit)
+    {
+        uint32_t sequence;
+        memcpy(&sequence, src + pos, 4);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - hash_bits);
+        size_t candidate = table[hash];
+        table[hash] = (uint32_t)pos + 1;
+
+        uint32_t other;
+        if (candidate == 0 || pos - (candidate - 1) > 65535 || (memcpy(&other, src + candidate - 1, 4), other != sequence))
+        {
+            pos++;
+            continue;
+        }
+
+        // The last five bytes must always be literals
+        size_t ref = candidate - 1, length = 4;
+        while (pos + length < size - 5 && src[ref + length] == src[pos + length])
+            length++;
+
+        op = RGSS_LZ4_Sequence(op, src + anchor, pos - anchor, pos - ref, length);
+        pos += length;
+        anchor = pos;
+    }
+
+    op = RGSS_LZ4_Sequence(op, src + anchor, size - anchor, 0, 0);
+    return (size_t)(op - dst);
+}
+
+static const RGSS_ArchiveEntry *RGSS_Archive_Lookup(const RGSS_Archive *archive, const char *normalized, uint64_t hash)
+{
+    size_t lo = 0, hi = archive->count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (archive->entries[mid].hash < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    // Hash collisions are resolved by comparing the paths
+    for (; lo < archive->count && archive->entries[lo].hash == hash; lo++)
+    {
+        const RGSS_ArchiveEntry *entry = &archive->entries[lo];
+        if (entry->name < archive->names_size && strcmp(archive->names + entry->name, normalized) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+static void RGSS_Archive_Extract(const RGSS_Archive *archive, const RGSS_ArchiveEntry *entry, RGSS_Resource *resource)
+{
+    const unsigned char *data = archive->data + entry->offset;
+    resource->buffer = NULL;
+
+    if (entry->compression == RGSS_ARCHIVE_STORED)
+    {
+        resource->data = data;
+        resource->size = entry->size;
+        return;
+    }
+
+    unsigned char *buffer = xmalloc(RGSS_MAX(entry->raw_size, 1));
+    if (!RGSS_LZ4_Decompress(data, entry->size, buffer, entry->raw_size))
+    {
+        xfree(buffer);
+        rb_raise(rb_eRGSSError, "corrupt archive entry: %s", archive->names + entry->name);
+    }
+    resource->data = buffer;
+    resource->size = entry->raw_size;
+    resource->buffer = buffer;
+}
+
+int RGSS_Archive_Find(const char *path, RGSS_Resource *resource)
+{
+    if (path == NULL || RGSS_ARCHIVES.length == 0)
+        return false;
+
+    char normalized[RGSS_ARCHIVE_MAX_PATH];
+    if (!RGSS_Archive_Normalize(path, normalized))
+        return false;
+
+    uint64_t hash = RGSS_Archive_Hash(normalized);
+    for (int i = RGSS_ARCHIVES.length - 1; i >= 0; i--)
+    {
+        RGSS_Archive *archive = RGSS_ARCHIVES.data[i];
+        const RGSS_ArchiveEntry *entry = RGSS_Archive_Lookup(archive, normalized, hash);
+        if (entry)
+        {
+            RGSS_Archive_Extract(archive, entry, resource);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RGSS_Resource_Free(RGSS_Resource *resource)
+{
+    if (resource->buffer)
+        xfree(resource->buffer);
+    resource->buffer = NULL;
+    resource->data = NULL;
+    resource->size = 0;
+}
+
+static void RGSS_Archive_Unmap(RGSS_Archive *archive)
+{
+    if (archive->data == NULL)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(archive->data);
+    CloseHandle(archive->mapping);
+#else
+    munmap((void *)archive->data, archive->size);
+#endif
+    archive->data = NULL;
+    archive->entries = NULL;
+    archive->count = 0;
+}
+
+static void RGSS_Archive_Free(void *data)
+{
+    RGSS_Archive *archive = data;
+    RGSS_Archive_Unmap(archive);
+    xfree(archive);
+}
+
+static VALUE RGSS_Archive_Alloc(VALUE klass)
+{
+    RGSS_Archive *archive = ALLOC(RGSS_Archive);
+    memset(archive, 0, sizeof(RGSS_Archive));
+    return Data_Wrap_Struct(klass, NULL, RGSS_Archive_Free, archive);
+}
+
+static void RGSS_Archive_Map(RGSS_Archive *archive, const char *path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        rb_raise(rb_eRGSSError, "failed to open archive: %s", path);
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    archive->size = (size_t)size.QuadPart;
+    archive->mapping = archive->size ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    CloseHandle(file);
+    if (archive->mapping)
+        archive->data = MapViewOfFile(archive->mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        rb_raise(rb_eRGSSError, "failed to open archive: %s", path);
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        archive->size = (size_t)info.st_size;
+        void *data = mmap(NULL, archive->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        archive->data = (data == MAP_FAILED) ? NULL : data;
+    }
+    close(fd);
+#endif
+
+    if (archive->data == NULL)
+        rb_raise(rb_eRGSSError, "failed to map archive: %s", path);
+}
+
+static VALUE RGSS_Archive_Initialize(VALUE self, VALUE path)
+{
+    RGSS_Archive *archive = DATA_PTR(self);
+    RGSS_Archive_Unmap(archive);
+
+    const char *file = StringValueCStr(path);
+    RGSS_Archive_Map(archive, file);
+
+    // Validate everything the index refers to up front, so lookups can trust it
+    const RGSS_ArchiveHeader *header = (const RGSS_ArchiveHeader *)archive->data;
+    size_t index_size = header ? (size_t)header->count * sizeof(RGSS_ArchiveEntry) : 0;
+    int valid = archive->size >= sizeof(RGSS_ArchiveHeader) && memcmp(header->magic, RGSS_ARCHIVE_MAGIC, 4) == 0 &&
+                header->version == RGSS_ARCHIVE_VERSION && header->index_offset % 8 == 0 &&
+                header->index_offset <= archive->size && index_size <= archive->size - header->index_offset &&
+                header->names_offset <= archive->size;
+
+    if (valid)
+    {
+        archive->entries = (const RGSS_ArchiveEntry *)(archive->data + header->index_offset);
+        archive->count = header->count;
+        archive->names = (const char *)(archive->data + header->names_offset);
+        archive->names_size = archive->size - header->names_offset;
+
+        for (uint32_t i = 0; i < archive->count && valid; i++)
+        {
+            const RGSS_ArchiveEntry *entry = &archive->entries[i];
+            valid = entry->offset <= archive->size && entry->size <= archive->size - entry->offset &&
+                    entry->name < archive->names_size && entry->compression <= RGSS_ARCHIVE_LZ4 &&
+                    (entry->compression != RGSS_ARCHIVE_STORED || entry->size == entry->raw_size) &&
+                    (i == 0 || archive->entries[i - 1].hash <= entry->hash);
+        }
+        valid = valid && (archive->names_size == 0 || archive->names[archive->names_size - 1] == '\0');
+    }
+
+    if (!valid)
+    {
+        RGSS_Archive_Unmap(archive);
+        rb_raise(rb_eRGSSError, "invalid archive: %s", file);
+    }
+    return self;
+}
+
+static RGSS_Archive *RGSS_Archive_Get(VALUE self)
+{
+    RGSS_Archive *archive = DATA_PTR(self);
+    if (archive->data == NULL)
+        rb_raise(rb_eRGSSError, "closed archive");
+    return archive;
+}
+
+static VALUE RGSS_Archive_Mount(VALUE self)
+{
+    RGSS_Archive *archive = RGSS_Archive_Get(self);
+    if (!archive->mounted)
+    {
+        vec_push(&RGSS_ARCHIVES, archive);
+        rb_ary_push(RGSS_ARCHIVE_REFS, self);
+        archive->mounted = true;
+    }
+    return self;
+}
+
+static VALUE RGSS_Archive_Unmount(VALUE self)
+{
+    RGSS_Archive *archive = DATA_PTR(self);
+    if (archive->mounted)
+    {
+        vec_remove(&RGSS_ARCHIVES, archive);
+        rb_ary_delete(RGSS_ARCHIVE_REFS, self);
+        archive->mounted = false;
+    }
+    return self;
+}
+
+static VALUE RGSS_Archive_Close(VALUE self)
+{
+    RGSS_Archive_Unmount(self);
+    RGSS_Archive_Unmap(DATA_PTR(self));
+    return Qnil;
+}
+
+static VALUE RGSS_Archive_IsClosed(VALUE self)
+{
+    return RB_BOOL(((RGSS_Archive *)DATA_PTR(self))->data == NULL);
+}
+
+static VALUE RGSS_Archive_IsMounted(VALUE self)
+{
+    return RB_BOOL(((RGSS_Archive *)DATA_PTR(self))->mounted);
+}
+
+static VALUE RGSS_Archive_GetSize(VALUE self)
+{
+    return UINT2NUM(RGSS_Archive_Get(self)->count);
+}
+
+static VALUE RGSS_Archive_Include(VALUE self, VALUE path)
+{
+    RGSS_Archive *archive = RGSS_Archive_Get(self);
+    char normalized[RGSS_ARCHIVE_MAX_PATH];
+    if (!RGSS_Archive_Normalize(StringValueCStr(path), normalized))
+        return Qfalse;
+    return RB_BOOL(RGSS_Archive_Lookup(archive, normalized, RGSS_Archive_Hash(normalized)) != NULL);
+}
+
+static VALUE RGSS_Archive_Read(VALUE self, VALUE path)
+{
+    RGSS_Archive *archive = RGSS_Archive_Get(self);
+    char normalized[RGSS_ARCHIVE_MAX_PATH];
+    if (!RGSS_Archive_Normalize(StringValueCStr(path), normalized))
+        return Qnil;
+
+    const RGSS_ArchiveEntry *entry = RGSS_Archive_Lookup(archive, normalized, RGSS_Archive_Hash(normalized));
+    if (entry == NULL)
+        return Qnil;
+
+    RGSS_Resource resource;
+    RGSS_Archive_Extract(archive, entry, &resource);
+    VALUE str = rb_str_new(resource.data, (long)resource.size);
+    RGSS_Resource_Free(&resource);
+    return str;
+}
+
+static VALUE RGSS_Archive_GetEntries(VALUE self)
+{
+    RGSS_Archive *archive = RGSS_Archive_Get(self);
+    VALUE ary = rb_ary_new_capa(archive->count);
+    for (uint32_t i = 0; i < archive->count; i++)
+        rb_ary_push(ary, rb_str_new_cstr(archive->names + archive->entries[i].name));
+    return ary;
+}
+
+static VALUE RGSS_Archive_ReadMounted(VALUE klass, VALUE path)
+{
+    RGSS_Resource resource;
+    if (!RGSS_Archive_Find(StringValueCStr(path), &resource))
+        return Qnil;
+
+    VALUE str = rb_str_new(resource.data, (long)resource.size);
+    RGSS_Resource_Free(&resource);
+    return str;
+}
+
+static VALUE RGSS_Archive_Exist(VALUE klass, VALUE path)
+{
+    char normalized[RGSS_ARCHIVE_MAX_PATH];
+    if (!RGSS_Archive_Normalize(StringValueCStr(path), normalized))
+        return Qfalse;
+
+    uint64_t hash = RGSS_Archive_Hash(normalized);
+    for (int i = 0; i < RGSS_ARCHIVES.length; i++)
+    {
+        if (RGSS_Archive_Lookup(RGSS_ARCHIVES.data[i], normalized, hash))
+            return Qtrue;
+    }
+    return Qfalse;
+}
+
+static VALUE RGSS_Archive_Open(VALUE klass, VALUE path)
+{
+    return RGSS_Archive_Mount(rb_class_new_instance(1, &path, klass));
+}
+
+typedef struct
+{
+    RGSS_ArchiveEntry entry;
+    VALUE source;
+    char *name;
+} RGSS_ArchiveItem;
+
+static int RGSS_Archive_CompareItems(const void *a, const void *b)
+{
+    const RGSS_ArchiveItem *x = a, *y = b;
+    if (x->entry.hash != y->entry.hash)
+        return x->entry.hash < y->entry.hash ? -1 : 1;
+    return strcmp(x->name, y->name);
+}
+
+static int RGSS_Archive_Write(FILE *file, const void *data, size_t size)
+{
+    return size == 0 || fwrite(data, size, 1, file) == 1;
+}
+
+typedef struct
+{
+    VALUE path;              /** The path of the archive to create. */
+    VALUE files;             /** The hash of archive paths to the files to read their contents from. */
+    int compress;            /** Flag indicating if contents are compressed when it makes them smaller. */
+    RGSS_ArchiveItem *items; /** The entries being written, with their sources. */
+    char *names;             /** The normalized names of all entries, each terminated by a null character. */
+    uint32_t *table;         /** The hash table used by the compressor, or @c NULL. */
+    FILE *file;              /** The file being written, or @c NULL once closed. */
+} RGSS_ArchiveBuild;
+
+static VALUE RGSS_Archive_BuildFree(VALUE value)
+{
+    RGSS_ArchiveBuild *build = (RGSS_ArchiveBuild *)value;
+    if (build->file)
+        fclose(build->file);
+    if (build->table)
+        xfree(build->table);
+    if (build->items)
+        xfree(build->items);
+    if (build->names)
+        xfree(build->names);
+    return Qnil;
+}
+
+static VALUE RGSS_Archive_Build(VALUE value)
+{
+    RGSS_ArchiveBuild *build = (RGSS_ArchiveBuild *)value;
+    VALUE keys = rb_funcall(build->files, rb_intern("keys"), 0);
+    long count = RARRAY_LEN(keys);
+
+    // Normalizing never makes a path longer, so the names fit in the combined length of the keys
+    size_t capacity = 1;
+    for (long i = 0; i < count; i++)
+    {
+        VALUE key = rb_ary_entry(keys, i);
+        capacity += strlen(StringValueCStr(key)) + 1;
+    }
+
+    RGSS_ArchiveItem *items = build->items = ALLOC_N(RGSS_ArchiveItem, RGSS_MAX(count, 1));
+    char *names = build->names = ALLOC_N(char, capacity);
+    size_t names_size = 0;
+
+    for (long i = 0; i < count; i++)
+    {
+        VALUE key = rb_ary_entry(keys, i);
+        char *name = names + names_size;
+        if (!RGSS_Archive_Normalize(StringValueCStr(key), name))
+            rb_raise(rb_eArgError, "invalid archive path: %s", StringValueCStr(key));
+
+        items[i].name = name;
+        items[i].source = rb_hash_aref(build->files, key);
+        memset(&items[i].entry, 0, sizeof(RGSS_ArchiveEntry));
+        items[i].entry.hash = RGSS_Archive_Hash(name);
+        items[i].entry.name = (uint32_t)names_size;
+        names_size += strlen(name) + 1;
+    }
+    qsort(items, count, sizeof(RGSS_ArchiveItem), RGSS_Archive_CompareItems);
+
+    // Different keys may normalize to the same path, which would make all but one of them unreachable
+    for (long i = 1; i < count; i++)
+    {
+        if (RGSS_Archive_CompareItems(&items[i - 1], &items[i]) == 0)
+            rb_raise(rb_eArgError, "duplicate archive path: %s", items[i].name);
+    }
+
+    FILE *file = build->file = fopen(StringValueCStr(build->path), "wb");
+    if (file == NULL)
+        rb_raise(rb_eRGSSError, "failed to create archive: %s", StringValueCStr(build->path));
+
+    RGSS_ArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RGSS_ARCHIVE_MAGIC, 4);
+    header.version = RGSS_ARCHIVE_VERSION;
+    header.count = (uint32_t)count;
+
+    uint64_t offset = sizeof(header);
+    int ok = RGSS_Archive_Write(file, &header, sizeof(header));
+    uint32_t *table = build->table = build->compress ? ALLOC_N(uint32_t, 1 << 16) : NULL;
+
+    for (long i = 0; i < count && ok; i++)
+    {
+        // Sources are read with Ruby, so they are never resolved through a mounted archive
+        VALUE contents = rb_funcall(rb_cFile, rb_intern("binread"), 1, items[i].source);
+        const unsigned char *data = (const unsigned char *)RSTRING_PTR(contents);
+        size_t size = RSTRING_LEN(contents);
+        if (size > UINT32_MAX)
+        {
+            ok = false;
+            break;
+        }
+
+        RGSS_ArchiveEntry *entry = &items[i].entry;
+        entry->offset = offset;
+        entry->raw_size = (uint32_t)size;
+        entry->size = (uint32_t)size;
+        entry->compression = RGSS_ARCHIVE_STORED;
+
+        // Contents that do not shrink by at least an eighth are kept stored, so they can be used without a copy
+        unsigned char *packed = NULL;
+        if (build->compress && size > 64)
+        {
+            packed = xmalloc(size + size / 255 + 16);
+            size_t packed_size = RGSS_LZ4_Compress(data, size, packed, table);
+            if (packed_size < size - size / 8)
+            {
+                entry->compression = RGSS_ARCHIVE_LZ4;
+                entry->size = (uint32_t)packed_size;
+                data = packed;
+            }
+        }
+
+        ok = RGSS_Archive_Write(file, data, entry->size);
+        offset += entry->size;
+        if (packed)
+            xfree(packed);
+        RB_GC_GUARD(contents);
+    }
+
+    // The index is aligned so it can be used directly from the mapped file
+    static const char padding[8] = {0};
+    size_t pad = (8 - offset % 8) % 8;
+    ok = ok && RGSS_Archive_Write(file, padding, pad);
+    header.index_offset = offset + pad;
+    for (long i = 0; i < count && ok; i++)
+        ok = RGSS_Archive_Write(file, &items[i].entry, sizeof(RGSS_ArchiveEntry));
+    header.names_offset = header.index_offset + count * sizeof(RGSS_ArchiveEntry);
+    ok = ok && RGSS_Archive_Write(file, names, names_size);
+
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && RGSS_Archive_Write(file, &header, sizeof(header));
+    ok = (fclose(file) == 0) && ok;
+    build->file = NULL;
+
+    if (!ok)
+        rb_raise(rb_eRGSSError, "failed to write archive: %s", StringValueCStr(build->path));
+    return Qnil;
+}
+
+static VALUE RGSS_Archive_Create(int argc, VALUE *argv, VALUE klass)
+{
+    VALUE path, files, opts;
+    rb_scan_args(argc, argv, "2:", &path, &files, &opts);
+    Check_Type(files, T_HASH);
+    StringValueCStr(path);
+
+    VALUE opt = NIL_P(opts) ? Qundef : rb_hash_lookup2(opts, STR2SYM("compress"), Qundef);
+    RGSS_ArchiveBuild build = {path, files, opt == Qundef || RTEST(opt)};
+
+    // Reading sources and writing may raise at any point, so everything allocated is released when it does
+    return rb_ensure(RGSS_Archive_Build, (VALUE)&build, RGSS_Archive_BuildFree, (VALUE)&build);
+}
+
+void RGSS_Init_Archive(VALUE parent)
+{
+    vec_init(&RGSS_ARCHIVES);
+    RGSS_ARCHIVE_REFS = rb_ary_new();
+    rb_gc_register_address(&RGSS_ARCHIVE_REFS);
+
+    rb_cArchive = rb_define_class_under(parent, "Archive", rb_cObject);
+    rb_define_alloc_func(rb_cArchive, RGSS_Archive_Alloc);
+
+    rb_define_method1(rb_cArchive, "initialize", RGSS_Archive_Initialize, 1);
+    rb_define_method0(rb_cArchive, "mount", RGSS_Archive_Mount, 0);
+    rb_define_method0(rb_cArchive, "unmount", RGSS_Archive_Unmount, 0);
+    rb_define_method0(rb_cArchive, "mounted?", RGSS_Archive_IsMounted, 0);
+    rb_define_method0(rb_cArchive, "close", RGSS_Archive_Close, 0);
+    rb_define_method0(rb_cArchive, "closed?", RGSS_Archive_IsClosed, 0);
+    rb_define_method0(rb_cArchive, "size", RGSS_Archive_GetSize, 0);
+    rb_define_method0(rb_cArchive, "entries", RGSS_Archive_GetEntries, 0);
+    rb_define_method1(rb_cArchive, "include?", RGSS_Archive_Include, 1);
+    rb_define_method1(rb_cArchive, "read", RGSS_Archive_Read, 1);
+
+    rb_define_singleton_methodm1(rb_cArchive, "create", RGSS_Archive_Create, -1);
+    rb_define_singleton_method1(rb_cArchive, "mount", RGSS_Archive_Open, 1);
+    rb_define_singleton_method1(rb_cArchive, "read", RGSS_Archive_ReadMounted, 1);
+    rb_define_singleton_method1(rb_cArchive, "exist?", RGSS_Archive_Exist, 1);
+}
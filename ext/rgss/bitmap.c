@@ -0,0 +1,528 @@
+#include "game.h"
+#include "pixels.h"
+
+VALUE rb_cBitmap;
+
+#define RGSS_BITMAP_MAX_DIRTY 8
+
+/**
+ * @brief A texture with a CPU-side copy of its pixels, which is the source of truth for all drawing operations.
+ * Changes are tracked as dirty areas, and uploaded to the texture before it is next used by the GPU.
+ */
+typedef struct
+{
+    RGSS_Texture texture;                   /** The texture, first so a bitmap can be used as any other texture. */
+    uint32_t *pixels;                       /** The pixel data, tightly packed RGBA. */
+    GLuint pbo;                             /** The pixel buffer object used to stream dirty areas to the texture. */
+    int dirty_count;                        /** The number of areas pending upload. */
+    RGSS_Rect dirty[RGSS_BITMAP_MAX_DIRTY]; /** The areas pending upload. */
+} RGSS_Bitmap;
+
+#define RGSS_ASSERT_BITMAP(bitmap)                                                                                     \
+    if ((bitmap)->pixels == NULL)                                                                                      \
+    rb_raise(rb_eRuntimeError, "disposed bitmap")
+
+static inline void RGSS_Bitmap_Modify(RGSS_Bitmap *bitmap)
+{
+    RGSS_ASSERT_BITMAP(bitmap);
+    // Pending blits of other textures upload the pixels when they are executed, so they must see them unchanged
+    if (bitmap->texture.pending_reads > 0)
+        RGSS_Texture_FlushAll();
+}
+
+static inline int RGSS_Bitmap_Clip(RGSS_Bitmap *bitmap, RGSS_Rect *rect)
+{
+    int x1 = RGSS_MIN(rect->x + rect->width, bitmap->texture.width);
+    int y1 = RGSS_MIN(rect->y + rect->height, bitmap->texture.height);
+    rect->x = RGSS_MAX(rect->x, 0);
+    rect->y = RGSS_MAX(rect->y, 0);
+    rect->width = x1 - rect->x;
+    rect->height = y1 - rect->y;
+    return rect->width > 0 && rect->height > 0;
+}
+
+static inline void RGSS_Rect_Union(RGSS_Rect *a, const RGSS_Rect *b)
+{
+    int x1 = RGSS_MAX(a->x + a->width, b->x + b->width);
+    int y1 = RGSS_MAX(a->y + a->height, b->y + b->height);
+    a->x = RGSS_MIN(a->x, b->x);
+    a->y = RGSS_MIN(a->y, b->y);
+    a->width = x1 - a->x;
+    a->height = y1 - a->y;
+}
+
+static void RGSS_Bitmap_Invalidate(RGSS_Bitmap *bitmap, const RGSS_Rect *rect)
+{
+    // Touching or overlapping areas are merged, and once the list is full an area is merged into whichever existing
+    // one grows the least, which keeps many small writes (i.e. set_pixel) from becoming many small uploads
+    int best = 0;
+    long growth = LONG_MAX;
+    for (int i = 0; i < bitmap->dirty_count; i++)
+    {
+        RGSS_Rect merged = bitmap->dirty[i];
+        RGSS_Rect_Union(&merged, rect);
+        long added = (long)merged.width * merged.height - (long)bitmap->dirty[i].width * bitmap->dirty[i].height;
+        if (merged.width <= bitmap->dirty[i].width + rect->width && merged.height <= bitmap->dirty[i].height + rect->height)
+        {
+            bitmap->dirty[i] = merged;
+            return;
+        }
+        if (added < growth)
+        {
+            growth = added;
+            best = i;
+        }
+    }
+
+    if (bitmap->dirty_count < RGSS_BITMAP_MAX_DIRTY)
+        bitmap->dirty[bitmap->dirty_count++] = *rect;
+    else
+        RGSS_Rect_Union(&bitmap->dirty[best], rect);
+}
+
+static void RGSS_Bitmap_Upload(RGSS_Texture *texture)
+{
+    RGSS_Bitmap *bitmap = (RGSS_Bitmap *)texture;
+    if (bitmap->dirty_count == 0 || texture->id == GL_NONE)
+        return;
+
+    GLsizeiptr size = 0;
+    for (int i = 0; i < bitmap->dirty_count; i++)
+        size += (GLsizeiptr)bitmap->dirty[i].width * bitmap->dirty[i].height * sizeof(uint32_t);
+
+    if (bitmap->pbo == GL_NONE)
+        glGenBuffers(1, &bitmap->pbo);
+
+    // Orphan the buffer so writing to it never waits on a previous upload still in flight
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bitmap->pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+    unsigned char *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+
+    if (mapped)
+    {
+        unsigned char *dst = mapped;
+        for (int i = 0; i < bitmap->dirty_count; i++)
+        {
+            RGSS_Rect *r = &bitmap->dirty[i];
+            size_t row_size = r->width * sizeof(uint32_t);
+            for (int y = 0; y < r->height; y++, dst += row_size)
+                memcpy(dst, bitmap->pixels + (size_t)(r->y + y) * texture->width + r->x, row_size);
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        GLintptr offset = 0;
+        for (int i = 0; i < bitmap->dirty_count; i++)
+        {
+            RGSS_Rect *r = &bitmap->dirty[i];
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r->x, r->y, r->width, r->height, GL_RGBA, GL_UNSIGNED_BYTE, (void *)offset);
+            offset += (GLintptr)r->width * r->height * sizeof(uint32_t);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, GL_NONE);
+    }
+    else
+    {
+        // Mapping can fail (i.e. out of memory), fallback to uploading directly from the pixel data
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, GL_NONE);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->width);
+        for (int i = 0; i < bitmap->dirty_count; i++)
+        {
+            RGSS_Rect *r = &bitmap->dirty[i];
+            void *data = bitmap->pixels + (size_t)r->y * texture->width + r->x;
+            glTexSubImage2D(GL_TEXTURE_2D, 0, r->x, r->y, r->width, r->height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    bitmap->dirty_count = 0;
+    if (texture->mipmaps)
+        texture->mipmaps_dirty = true;
+}
+
+static void RGSS_Bitmap_Free(void *data)
+{
+    RGSS_Bitmap *bitmap = data;
+    if (bitmap->pixels)
+        xfree(bitmap->pixels);
+    RGSS_Texture_Free(data);
+}
+
+static VALUE RGSS_Bitmap_Alloc(VALUE klass)
+{
+    RGSS_Bitmap *bitmap = ALLOC(RGSS_Bitmap);
+    memset(bitmap, 0, sizeof(RGSS_Bitmap));
+    bitmap->texture.sync = RGSS_Bitmap_Upload;
+    return Data_Wrap_Struct(klass, RGSS_Texture_Mark, RGSS_Bitmap_Free, bitmap);
+}
+
+static VALUE RGSS_Bitmap_Initialize(int argc, VALUE *argv, VALUE self)
+{
+    VALUE a1, a2, opts;
+    rb_scan_args(argc, argv, "11:", &a1, &a2, &opts);
+
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    int width, height;
+    unsigned char *pixels;
+
+    if (!NIL_P(a2))
+    {
+        width = NUM2INT(a1);
+        height = NUM2INT(a2);
+        RGSS_SizeNotEmpty(width, height);
+        pixels = xcalloc((size_t)width * height, sizeof(uint32_t));
+    }
+    else if (rb_obj_is_kind_of(a1, rb_cImage) == Qtrue)
+    {
+        RGSS_Image *image = DATA_PTR(a1);
+        if (image->pixels == NULL)
+            rb_raise(rb_eArgError, "disposed image");
+        width = image->width;
+        height = image->height;
+        pixels = xmalloc((size_t)width * height * sizeof(uint32_t));
+        memcpy(pixels, image->pixels, (size_t)width * height * sizeof(uint32_t));
+    }
+    else
+    {
+        RGSS_Image_Load(StringValueCStr(a1), &width, &height, &pixels);
+    }
+
+    bitmap->pixels = (uint32_t *)pixels;
+    RGSS_Texture_Generate(width, height, pixels, opts, &bitmap->texture);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_Load(int argc, VALUE *argv, VALUE klass)
+{
+    VALUE path, opts;
+    rb_scan_args(argc, argv, "1:", &path, &opts);
+
+    if (NIL_P(path))
+        rb_raise(rb_eArgError, "path cannot be nil");
+    return rb_class_new_instance_kw(argc, argv, klass, RB_PASS_CALLED_KEYWORDS);
+}
+
+static VALUE RGSS_Bitmap_Dispose(VALUE self)
+{
+    rb_call_super(0, NULL);
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    if (bitmap->pbo)
+    {
+        glDeleteBuffers(1, &bitmap->pbo);
+        bitmap->pbo = GL_NONE;
+    }
+    if (bitmap->pixels)
+    {
+        xfree(bitmap->pixels);
+        bitmap->pixels = NULL;
+    }
+    bitmap->dirty_count = 0;
+    return Qnil;
+}
+
+static VALUE RGSS_Bitmap_GetPixel(VALUE self, VALUE x, VALUE y)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_ASSERT_BITMAP(bitmap);
+
+    int px = NUM2INT(x), py = NUM2INT(y);
+    if (px < 0 || py < 0 || px >= bitmap->texture.width || py >= bitmap->texture.height)
+        return RGSS_Color_New(rb_cColor, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    RGSS_Color color;
+    RGSS_UnpackColor(bitmap->pixels[(size_t)py * bitmap->texture.width + px], color);
+    return RGSS_Color_New(rb_cColor, color[0], color[1], color[2], color[3]);
+}
+
+static VALUE RGSS_Bitmap_SetPixel(VALUE self, VALUE x, VALUE y, VALUE color)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    int px = NUM2INT(x), py = NUM2INT(y);
+    if (px < 0 || py < 0 || px >= bitmap->texture.width || py >= bitmap->texture.height)
+        return self;
+
+    unsigned int packed;
+    RGSS_PackColor(DATA_PTR(color), &packed);
+    bitmap->pixels[(size_t)py * bitmap->texture.width + px] = packed;
+
+    RGSS_Rect rect = {px, py, 1, 1};
+    RGSS_Bitmap_Invalidate(bitmap, &rect);
+    return self;
+}
+
+static void RGSS_Bitmap_FillImpl(RGSS_Bitmap *bitmap, RGSS_Rect *rect, float *color)
+{
+    if (!RGSS_Bitmap_Clip(bitmap, rect))
+        return;
+
+    unsigned int packed;
+    RGSS_PackColor(color, &packed);
+    uint32_t *start = bitmap->pixels + (size_t)rect->y * bitmap->texture.width + rect->x;
+    RGSS_Pixels_Fill(start, bitmap->texture.width, rect->width, rect->height, packed);
+    RGSS_Bitmap_Invalidate(bitmap, rect);
+}
+
+static VALUE RGSS_Bitmap_FillRect(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect rect;
+    float *color = RGSS_Texture_ParseFill(argc, argv, &rect);
+    RGSS_Bitmap_FillImpl(bitmap, &rect, color);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_Clear(VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect rect = {0, 0, bitmap->texture.width, bitmap->texture.height};
+    float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    RGSS_Bitmap_FillImpl(bitmap, &rect, color);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_ClearRect(int argc, VALUE *argv, VALUE self)
+{
+    VALUE a0, a1, a2, a3;
+    rb_scan_args(argc, argv, "13", &a0, &a1, &a2, &a3);
+
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect rect;
+    if (argc == 1)
+        memcpy(&rect, DATA_PTR(a0), sizeof(RGSS_Rect));
+    else if (argc == 4)
+        rect = (RGSS_Rect){NUM2INT(a0), NUM2INT(a1), NUM2INT(a2), NUM2INT(a3)};
+    else
+        rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 1 or 4)", argc);
+
+    float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    RGSS_Bitmap_FillImpl(bitmap, &rect, color);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_GradientFillRect(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect rect;
+    VALUE color1, color2, vertical;
+    if (argc == 3 || argc == 4)
+    {
+        memcpy(&rect, DATA_PTR(argv[0]), sizeof(RGSS_Rect));
+        color1 = argv[1];
+        color2 = argv[2];
+        vertical = argc == 4 ? argv[3] : Qfalse;
+    }
+    else if (argc == 6 || argc == 7)
+    {
+        rect = (RGSS_Rect){NUM2INT(argv[0]), NUM2INT(argv[1]), NUM2INT(argv[2]), NUM2INT(argv[3])};
+        color1 = argv[4];
+        color2 = argv[5];
+        vertical = argc == 7 ? argv[6] : Qfalse;
+    }
+    else
+    {
+        rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 3, 4, 6, or 7)", argc);
+    }
+
+    RGSS_Rect area = rect;
+    if (rect.width < 1 || rect.height < 1 || !RGSS_Bitmap_Clip(bitmap, &area))
+        return self;
+
+    // The gradient is computed across the unclipped area, so clipping does not change the colors
+    float *c1 = DATA_PTR(color1), *c2 = DATA_PTR(color2);
+    int stride = bitmap->texture.width;
+    uint32_t *start = bitmap->pixels + (size_t)area.y * stride + area.x;
+    RGSS_Color color;
+    unsigned int packed;
+
+    if (RTEST(vertical))
+    {
+        float span = (float)RGSS_MAX(rect.height - 1, 1);
+        for (int y = 0; y < area.height; y++)
+        {
+            glm_vec4_lerp(c1, c2, (area.y + y - rect.y) / span, color);
+            RGSS_PackColor(color, &packed);
+            RGSS_Pixels_Fill(start + (size_t)y * stride, stride, area.width, 1, packed);
+        }
+    }
+    else
+    {
+        float span = (float)RGSS_MAX(rect.width - 1, 1);
+        for (int x = 0; x < area.width; x++)
+        {
+            glm_vec4_lerp(c1, c2, (area.x + x - rect.x) / span, color);
+            RGSS_PackColor(color, &packed);
+            start[x] = packed;
+        }
+        for (int y = 1; y < area.height; y++)
+            memcpy(start + (size_t)y * stride, start, area.width * sizeof(uint32_t));
+    }
+
+    RGSS_Bitmap_Invalidate(bitmap, &area);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_Blit(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect dst_rect, src_rect;
+    float opacity;
+    VALUE source = RGSS_Texture_ParseBlit(argc, argv, &dst_rect, &src_rect, &opacity);
+
+    // Pixel operations happen on the CPU, so the source must have its pixels there as well
+    if (rb_obj_is_kind_of(source, rb_cBitmap) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not a Bitmap", CLASS_NAME(source));
+
+    RGSS_Bitmap *src = DATA_PTR(source);
+    RGSS_ASSERT_BITMAP(src);
+
+    // Blitting a bitmap onto itself must read from a copy of the source area
+    uint32_t *pixels = src->pixels;
+    RGSS_Size src_size = {src->texture.width, src->texture.height};
+    if (src == bitmap)
+    {
+        RGSS_Rect area = src_rect;
+        if (!RGSS_Bitmap_Clip(src, &area))
+            return self;
+        pixels = xmalloc((size_t)area.width * area.height * sizeof(uint32_t));
+        for (int y = 0; y < area.height; y++)
+            memcpy(pixels + (size_t)y * area.width, src->pixels + (size_t)(area.y + y) * src_size.width + area.x,
+                   area.width * sizeof(uint32_t));
+        src_rect.x -= area.x;
+        src_rect.y -= area.y;
+        src_size = area.size;
+    }
+
+    RGSS_Size dst_size = {bitmap->texture.width, bitmap->texture.height};
+    int alpha = (int)roundf(opacity * 255.0f);
+    RGSS_Pixels_StretchBlend(bitmap->pixels, &dst_size, &dst_rect, pixels, &src_size, &src_rect, alpha);
+
+    if (pixels != src->pixels)
+        xfree(pixels);
+    if (RGSS_Bitmap_Clip(bitmap, &dst_rect))
+        RGSS_Bitmap_Invalidate(bitmap, &dst_rect);
+    return self;
+}
+
+static void RGSS_Bitmap_Transform(RGSS_Bitmap *bitmap, const float *matrix)
+{
+    RGSS_Pixels_ColorMatrix(bitmap->pixels, bitmap->texture.width, bitmap->texture.width, bitmap->texture.height,
+                            matrix);
+    RGSS_Rect rect = {0, 0, bitmap->texture.width, bitmap->texture.height};
+    RGSS_Bitmap_Invalidate(bitmap, &rect);
+}
+
+static VALUE RGSS_Bitmap_HueChange(VALUE self, VALUE hue)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    float matrix[12];
+    RGSS_Pixels_HueToneMatrix(NUM2FLT(hue), NULL, matrix);
+    RGSS_Bitmap_Transform(bitmap, matrix);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_ToneChange(VALUE self, VALUE tone)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    if (rb_obj_is_kind_of(tone, rb_cTone) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not a Tone", CLASS_NAME(tone));
+
+    float matrix[12];
+    RGSS_Pixels_HueToneMatrix(0.0f, DATA_PTR(tone), matrix);
+    RGSS_Bitmap_Transform(bitmap, matrix);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_Blur(int argc, VALUE *argv, VALUE self)
+{
+    VALUE radius;
+    rb_scan_args(argc, argv, "01", &radius);
+
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    int w = bitmap->texture.width, h = bitmap->texture.height;
+    RGSS_Pixels_BoxBlur(bitmap->pixels, w, w, h, NIL_P(radius) ? 1 : NUM2INT(radius));
+
+    RGSS_Rect rect = {0, 0, w, h};
+    RGSS_Bitmap_Invalidate(bitmap, &rect);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_DrawText(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_Bitmap_Modify(bitmap);
+
+    RGSS_Rect area;
+    uint32_t *data;
+    int row_length;
+    if (!RGSS_Texture_RenderText(argc, argv, bitmap->texture.width, bitmap->texture.height, &area, &data, &row_length))
+        return self;
+
+    // The text replaces the area the same as it does for a texture, only written to the pixels instead
+    uint32_t *dst = bitmap->pixels + (size_t)area.y * bitmap->texture.width + area.x;
+    for (int y = 0; y < area.height; y++)
+        RGSS_Pixels_FromARGB(dst + (size_t)y * bitmap->texture.width, data + (size_t)y * row_length, area.width);
+
+    RGSS_Bitmap_Invalidate(bitmap, &area);
+    return self;
+}
+
+static VALUE RGSS_Bitmap_ToImage(VALUE self)
+{
+    RGSS_Bitmap *bitmap = DATA_PTR(self);
+    RGSS_ASSERT_BITMAP(bitmap);
+
+    size_t size = (size_t)bitmap->texture.width * bitmap->texture.height * sizeof(uint32_t);
+    unsigned char *pixels = xmalloc(size);
+    memcpy(pixels, bitmap->pixels, size);
+    return RGSS_Image_New(bitmap->texture.width, bitmap->texture.height, pixels);
+}
+
+void RGSS_Init_Bitmap(VALUE parent)
+{
+    rb_cBitmap = rb_define_class_under(parent, "Bitmap", rb_cTexture);
+    rb_define_alloc_func(rb_cBitmap, RGSS_Bitmap_Alloc);
+
+    rb_define_methodm1(rb_cBitmap, "initialize", RGSS_Bitmap_Initialize, -1);
+    rb_define_method0(rb_cBitmap, "dispose", RGSS_Bitmap_Dispose, 0);
+    rb_define_method2(rb_cBitmap, "get_pixel", RGSS_Bitmap_GetPixel, 2);
+    rb_define_method3(rb_cBitmap, "set_pixel", RGSS_Bitmap_SetPixel, 3);
+    rb_define_methodm1(rb_cBitmap, "fill_rect", RGSS_Bitmap_FillRect, -1);
+    rb_define_methodm1(rb_cBitmap, "gradient_fill_rect", RGSS_Bitmap_GradientFillRect, -1);
+    rb_define_method0(rb_cBitmap, "clear", RGSS_Bitmap_Clear, 0);
+    rb_define_methodm1(rb_cBitmap, "clear_rect", RGSS_Bitmap_ClearRect, -1);
+    rb_define_methodm1(rb_cBitmap, "blit", RGSS_Bitmap_Blit, -1);
+    rb_define_method1(rb_cBitmap, "hue_change", RGSS_Bitmap_HueChange, 1);
+    rb_define_method1(rb_cBitmap, "tone_change", RGSS_Bitmap_ToneChange, 1);
+    rb_define_methodm1(rb_cBitmap, "blur", RGSS_Bitmap_Blur, -1);
+    rb_define_methodm1(rb_cBitmap, "draw_text", RGSS_Bitmap_DrawText, -1);
+    rb_define_method0(rb_cBitmap, "to_image", RGSS_Bitmap_ToImage, 0);
+
+    rb_define_singleton_methodm1(rb_cBitmap, "load", RGSS_Bitmap_Load, -1);
+
+    rb_define_alias(rb_cBitmap, "blt", "blit");
+    rb_define_alias(rb_cBitmap, "stretch_blt", "blit");
+
+    // Drawing with the GPU would make the texture diverge from the pixels
+    rb_undef_method(rb_cBitmap, "target");
+    rb_undef_method(rb_cBitmap, "copy");
+    rb_undef_method(rb_singleton_class(rb_cBitmap), "wrap");
+}
@@ -47,7 +47,6 @@ typedef struct {
         vec2 size;
     } texture;
     VALUE viewport;
-    GLuint sampler;
     vec2 zoom;
     vec2 scroll;
     vec2 origin;
@@ -746,7 +745,7 @@ static VALUE RGSS_Renderable_Render(VALUE self, VALUE alpha)
     glBlendEquation(obj->blend.op);
     glBlendFunc(obj->blend.src, obj->blend.dst);
 
-    glUseProgram(RGSS_SHADER.id);
+    RGSS_Graphics_UseProgram(RGSS_SHADER.id);
     glUniformMatrix4fv(RGSS_SHADER.model, 1, false, obj->entity.model[0]);
     glUniform4fv(RGSS_SHADER.color, 1, obj->color);
     glUniform4fv(RGSS_SHADER.tone, 1, obj->tone);
@@ -921,11 +920,13 @@ static VALUE RGSS_Sprite_Render(VALUE self, VALUE alpha)
 
     rb_call_super(1, &alpha);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, sprite->texture.id);
+    RGSS_Entity *entity = &sprite->base.entity;
+    int minified = entity->scale[0] < 1.0f || entity->scale[1] < 1.0f;
+    RGSS_Texture_BindSampled(DATA_PTR(sprite->texture.value), 0, NULL, minified);
     glBindVertexArray(sprite->base.vao);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL);
     glBindVertexArray(GL_NONE);
+    glBindSampler(0, GL_NONE);
     return Qnil;
 }
 
@@ -1180,18 +1181,6 @@ static VALUE RGSS_Plane_Alloc(VALUE klass)
     return Data_Wrap_Struct(klass, RGSS_Plane_Mark, RGSS_Renderable_Free, plane);
 }
 
-static VALUE RGSS_Plane_Dispose(VALUE self)
-{
-    rb_call_super(0, NULL);
-    RGSS_Plane *plane = DATA_PTR(self);
-    if (plane->sampler)
-    {
-        glDeleteSamplers(1, &plane->sampler);
-        plane->sampler = GL_NONE;
-    }
-    return Qnil;
-}
-
 static VALUE RGSS_Plane_GetViewport(VALUE self)
 {
     RGSS_Plane *plane = DATA_PTR(self);
@@ -1297,12 +1286,6 @@ static VALUE RGSS_Plane_Initialize(int argc, VALUE *argv, VALUE self)
         plane->viewport = viewport;
     }
 
-    glGenSamplers(1, &plane->sampler);
-    glSamplerParameteri(plane->sampler, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glSamplerParameteri(plane->sampler, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glSamplerParameteri(plane->sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glSamplerParameteri(plane->sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
     glm_vec2_zero(plane->scroll);
     glm_vec2_zero(plane->origin);
     glm_vec2_one(plane->zoom);
@@ -1399,9 +1382,14 @@ static VALUE RGSS_Plane_Render(VALUE self, VALUE alpha)
 
     rb_call_super(1, &alpha);
 
-    glBindSampler(0, plane->sampler);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, plane->texture.id);
+    // The zoom scales the span of texture coordinates, so zooming in further than the entity scale samples more
+    // texels than are drawn, and the texture is minified.
+    RGSS_Texture *tex = DATA_PTR(plane->texture.value);
+    RGSS_SamplerState state = {GL_LINEAR, GL_LINEAR, GL_REPEAT, GL_REPEAT, tex->sampler.anisotropy};
+    float *scale = plane->base.entity.scale;
+    int minified = plane->zoom[0] > scale[0] || plane->zoom[1] > scale[1];
+
+    RGSS_Texture_BindSampled(tex, 0, &state, minified);
     glBindVertexArray(plane->base.vao);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL);
     glBindVertexArray(GL_NONE);
@@ -1501,7 +1489,6 @@ void RGSS_Init_Entity(VALUE parent)
     rb_cPlane = rb_define_class_under(parent, "Plane", rb_cRenderable);
     rb_define_alloc_func(rb_cPlane, RGSS_Plane_Alloc);
     rb_define_method0(rb_cPlane, "viewport", RGSS_Plane_GetViewport, 0);
-    rb_define_method0(rb_cPlane, "dispose", RGSS_Plane_Dispose, 0);
     rb_define_methodm1(rb_cPlane, "initialize", RGSS_Plane_Initialize, -1);
     DEFINE_ACCESSOR(rb_cPlane, RGSS_Plane, Zoom, "zoom");
     DEFINE_ACCESSOR(rb_cPlane, RGSS_Plane, Scroll, "scroll");
@@ -1,106 +1,240 @@
-#include "game.h"
-// #include <cairo/cairo.h>
-#include <pango/pangocairo.h>
+#include "font.h"
 #include "pango/pangofc-font.h"
-#include "glad.h"
+#include <pthread.h>
+#include <ruby/thread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#endif
 
 #define RGSS_DEFAULT_FONT_SIZE 16
+#define RGSS_LAYOUT_CACHE_CAPACITY 256 /** The default number of laid out texts kept by the layout cache. */
+#define RGSS_LAYOUT_POOL_SIZE 32       /** The number of evicted layouts kept to be reused. */
 
 #define RGSS_IV_COLOR "@default_color"
 #define RGSS_IV_SIZE  "@default_size"
 
+VALUE rb_cFont;
 
-typedef struct {
-    PangoFontDescription *desc;
-    PangoLayout *layout;
-    cairo_t *context;
-    RGSS_Color color;
-} RGSS_NewFont;
+static VALUE RGSS_Font_ToString(VALUE self)
+{
+    RGSS_NewFont *font = DATA_PTR(self);
+    char *str = pango_font_description_to_string(font->desc);
+    if (str == NULL)
+        return Qnil;
 
-VALUE rb_cFont;
+    VALUE value = rb_str_new_cstr(str);
+    g_free(str);
+    return value;
+}
 
-static unsigned int create_texture(unsigned int width, unsigned int height, unsigned char *pixels)
+typedef struct
 {
-    unsigned int texture_id;
+    unsigned int serial; /** The serial of the font description the text is laid out with. */
+    int width;           /** The width lines are wrapped at in pixels, or @c -1 to not wrap. */
+    int height;          /** The height the text is limited to in pixels, or @c -1 for no limit. */
+    int align;           /** The alignment of lines. */
+    int plain;           /** Flag indicating if the text is laid out as-is instead of parsed as markup. */
+} RGSS_LayoutKey;
 
-    glGenTextures(1, &texture_id);
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+typedef struct
+{
+    char *key;           /** The layout settings followed by the text, compared as raw bytes. */
+    size_t length;       /** The size of the key, in bytes. */
+    PangoLayout *layout; /** The shaped and laid out text. */
+    int width;           /** The width of the layout, in pixels. */
+    int height;          /** The height of the layout, in pixels. */
+    UT_hash_handle hh;   /** Makes the structure hashable by its key. */
+} RGSS_LayoutEntry;
 
-    return texture_id;
-}
+static struct
+{
+    RGSS_LayoutEntry *entries; /** The cached layouts, ordered from least to most recently used. */
+    char *scratch;             /** Reused buffer the key of a lookup is built in. */
+    size_t scratch_size;       /** The size of the scratch buffer, in bytes. */
+    int capacity;              /** The maximum number of layouts that are kept. */
+    unsigned long hits;        /** The number of layouts that were found in the cache. */
+    unsigned long misses;      /** The number of layouts that had to be shaped. */
+    vec_t(PangoLayout *) pool; /** Layouts of evicted entries, reused instead of creating new ones. */
+} RGSS_LAYOUT_CACHE = {NULL, NULL, 0, RGSS_LAYOUT_CACHE_CAPACITY, 0, 0};
 
-static inline void get_text_size(PangoLayout *layout, unsigned int *width, unsigned int *height)
+static struct
 {
-    pango_layout_get_size(layout, width, height);
-    /* Divide by pango scale to get dimensions in pixels. */
-    *width /= PANGO_SCALE;
-    *height /= PANGO_SCALE;
+    pthread_t thread;  /** The thread warming fontconfig and the given fonts. */
+    int running;       /** Flag indicating if the thread was started and no Ruby thread has claimed joining it. */
+    int joining;       /** Flag set while the thread is being joined, accessed atomically. */
+    int done;          /** Flag set by the thread when it has finished, accessed atomically. */
+    char **names;      /** The descriptions of the fonts to load, owned by the thread. */
+    int count;         /** The number of descriptions. */
+} RGSS_FONT_PRELOAD;
+
+static PangoContext *RGSS_FONT_CONTEXT; /** The context all fonts are laid out with. */
+
+static unsigned int RGSS_FONT_SERIAL; /** The last serial given to a font description. */
+
+static void RGSS_Font_Changed(RGSS_NewFont *font)
+{
+    // Serials are never reused, so layouts of a changed (or freed) description can no longer be found
+    font->serial = ++RGSS_FONT_SERIAL;
 }
 
-static inline cairo_t *RGSS_Font_CreateCairo(int width, int height, int channels, cairo_surface_t **surf,
-                                             unsigned char **buffer)
+static void *RGSS_Font_JoinPreload(void *thread)
 {
-    *buffer = calloc(channels * width * height, sizeof(unsigned char));
-    *surf = cairo_image_surface_create_for_data(*buffer, CAIRO_FORMAT_ARGB32, width, height, channels * width);
-    return cairo_create(*surf);
+    pthread_join(*(pthread_t *)thread, NULL);
+    __atomic_store_n(&RGSS_FONT_PRELOAD.joining, false, __ATOMIC_RELEASE);
+    return NULL;
 }
 
-static unsigned int RGSS_Font_CreateTexture(const char *text, RGSS_NewFont *font, unsigned int *text_width,
-                                            unsigned int *text_height, unsigned int *texture_id)
+static void *RGSS_Font_AwaitJoin(void *unused)
 {
-    cairo_t *render_context;
-    cairo_surface_t *surface;
-    unsigned char *surface_data = NULL;
+    while (__atomic_load_n(&RGSS_FONT_PRELOAD.joining, __ATOMIC_ACQUIRE))
+        g_usleep(1000);
+    return NULL;
+}
 
-    pango_layout_set_markup(font->layout, text, -1);
-    // pango_layout_set_text (layout, text, -1);
+static int RGSS_Font_IsPreloadPending(void)
+{
+    return RGSS_FONT_PRELOAD.running || __atomic_load_n(&RGSS_FONT_PRELOAD.joining, __ATOMIC_ACQUIRE);
+}
 
+static void RGSS_Font_WaitPreload(void)
+{
+    // Fontconfig may not be used from another thread while the preload is still initializing it
+    if (RGSS_FONT_PRELOAD.running)
+    {
+        // Claimed while holding the GVL, so only a single thread ever joins the preload
+        pthread_t thread = RGSS_FONT_PRELOAD.thread;
+        RGSS_FONT_PRELOAD.running = false;
+        __atomic_store_n(&RGSS_FONT_PRELOAD.joining, true, __ATOMIC_RELEASE);
+        rb_thread_call_without_gvl(RGSS_Font_JoinPreload, &thread, NULL, NULL);
+    }
+    else if (__atomic_load_n(&RGSS_FONT_PRELOAD.joining, __ATOMIC_ACQUIRE))
+    {
+        rb_thread_call_without_gvl(RGSS_Font_AwaitJoin, NULL, NULL, NULL);
+    }
+}
 
-    /* Get text dimensions and create a context to render to */
-    get_text_size(font->layout, text_width, text_height);
-    render_context = RGSS_Font_CreateCairo(*text_width, *text_height, 4, &surface, &surface_data);
+static PangoContext *RGSS_Font_GetContext(void)
+{
+    // The default font map is per-thread, and this is only ever called from Ruby threads holding the GVL
+    if (RGSS_FONT_CONTEXT == NULL)
+        RGSS_FONT_CONTEXT = pango_font_map_create_context(pango_cairo_font_map_get_default());
+    return RGSS_FONT_CONTEXT;
+}
 
-    /* Render */
-    cairo_set_source_rgba(render_context, 1, 1, 1, 1);
-    pango_cairo_show_layout(render_context, font->layout);
-    *texture_id = create_texture(*text_width, *text_height, surface_data);
+static PangoLayout *RGSS_Font_AcquireLayout(void)
+{
+    if (RGSS_LAYOUT_CACHE.pool.length > 0)
+        return vec_pop(&RGSS_LAYOUT_CACHE.pool);
+    return pango_layout_new(RGSS_Font_GetContext());
+}
 
-    /* Clean up */
-    free(surface_data);
-    cairo_destroy(render_context);
-    cairo_surface_destroy(surface);
+static void RGSS_LayoutEntry_Free(RGSS_LayoutEntry *entry)
+{
+    HASH_DEL(RGSS_LAYOUT_CACHE.entries, entry);
+    if (RGSS_LAYOUT_CACHE.pool.length < RGSS_LAYOUT_POOL_SIZE)
+        vec_push(&RGSS_LAYOUT_CACHE.pool, entry->layout);
+    else
+        g_object_unref(entry->layout);
+    xfree(entry->key);
+    xfree(entry);
 }
 
-#if 0
-static VALUE RGSS_Font_TestTexture(VALUE klass, VALUE str, VALUE fontname, VALUE dimen)
+static void RGSS_Font_TrimCache(int capacity)
 {
-    char *text = StringValueCStr(str);
-    char *font = StringValueCStr(fontname);
-    RGSS_Size *size = DATA_PTR(dimen);
+    // Entries are re-added when used, so the head of the hash is always the least recently used
+    while (HASH_COUNT(RGSS_LAYOUT_CACHE.entries) > (unsigned int)capacity)
+        RGSS_LayoutEntry_Free(RGSS_LAYOUT_CACHE.entries);
+}
 
-    unsigned int w, h, id;
+PangoLayout *RGSS_Font_GetLayout(RGSS_NewFont *font, const char *text, long length, int width, int height, int align,
+                                 int plain, int *pixel_width, int *pixel_height)
+{
+    // Waiting releases the GVL, so it is done before the shared scratch key and cache are touched, and the text is
+    // copied in case another thread changes its string meanwhile
+    VALUE buffer = 0;
+    if (RGSS_Font_IsPreloadPending())
+    {
+        char *copy = ALLOCV(buffer, RGSS_MAX(length, 1));
+        memcpy(copy, text, length);
+        text = copy;
+        RGSS_Font_WaitPreload();
+    }
 
+    RGSS_LayoutKey settings;
+    memset(&settings, 0, sizeof(RGSS_LayoutKey));
+    settings.serial = font->serial;
+    settings.width = width < 0 ? -1 : width;
+    settings.height = height < 0 ? -1 : height;
+    settings.align = align;
+    settings.plain = plain;
 
-    RGSS_Font_CreateTexture(text, NULL, &w, &h, &id);
+    size_t size = sizeof(RGSS_LayoutKey) + length;
+    if (size > RGSS_LAYOUT_CACHE.scratch_size)
+    {
+        RGSS_LAYOUT_CACHE.scratch = xrealloc(RGSS_LAYOUT_CACHE.scratch, size);
+        RGSS_LAYOUT_CACHE.scratch_size = size;
+    }
+    memcpy(RGSS_LAYOUT_CACHE.scratch, &settings, sizeof(RGSS_LayoutKey));
+    memcpy(RGSS_LAYOUT_CACHE.scratch + sizeof(RGSS_LayoutKey), text, length);
 
-    return rb_ary_new_from_args(3, UINT2NUM(id), UINT2NUM(w), UINT2NUM(h));
+    RGSS_LayoutEntry *entry;
+    HASH_FIND(hh, RGSS_LAYOUT_CACHE.entries, RGSS_LAYOUT_CACHE.scratch, size, entry);
+    if (entry)
+    {
+        // Moved to the tail, marking it as the most recently used
+        HASH_DEL(RGSS_LAYOUT_CACHE.entries, entry);
+        HASH_ADD_KEYPTR(hh, RGSS_LAYOUT_CACHE.entries, entry->key, entry->length, entry);
+        RGSS_LAYOUT_CACHE.hits++;
+    }
+    else
+    {
+        PangoLayout *layout = RGSS_Font_AcquireLayout();
+        pango_layout_set_font_description(layout, font->desc);
+        pango_layout_set_width(layout, settings.width < 0 ? -1 : settings.width * PANGO_SCALE);
+        pango_layout_set_height(layout, settings.height < 0 ? -1 : settings.height * PANGO_SCALE);
+        pango_layout_set_alignment(layout, align);
+        if (plain)
+        {
+            // Pooled layouts may still have the attributes of previous markup
+            pango_layout_set_attributes(layout, NULL);
+            pango_layout_set_text(layout, text, (int)length);
+        }
+        else
+        {
+            pango_layout_set_markup(layout, text, (int)length);
+        }
+
+        entry = ALLOC(RGSS_LayoutEntry);
+        entry->key = xmalloc(size);
+        memcpy(entry->key, RGSS_LAYOUT_CACHE.scratch, size);
+        entry->length = size;
+        entry->layout = layout;
+        pango_layout_get_pixel_size(layout, &entry->width, &entry->height);
+        HASH_ADD_KEYPTR(hh, RGSS_LAYOUT_CACHE.entries, entry->key, entry->length, entry);
+        RGSS_LAYOUT_CACHE.misses++;
+
+        // At least the new entry is always kept, as it is returned to the caller
+        RGSS_Font_TrimCache(RGSS_MAX(RGSS_LAYOUT_CACHE.capacity, 1));
+    }
+    if (buffer)
+        ALLOCV_END(buffer);
+
+    if (pixel_width)
+        *pixel_width = entry->width;
+    if (pixel_height)
+        *pixel_height = entry->height;
+    return entry->layout;
 }
-#endif
-
 
-static VALUE RGSS_Font_ToString(VALUE self)
+static RGSS_NewFont *RGSS_Font_Get(VALUE self)
 {
     RGSS_NewFont *font = DATA_PTR(self);
-    char *str = pango_font_description_to_string(font->desc);
-    if (str == NULL)
-        return Qnil;
-
-    VALUE value = rb_str_new_cstr(str);
-    g_free(str);
-    return value;
+    if (font->desc == NULL)
+        rb_raise(rb_eRGSSError, "font has not been initialized");
+    return font;
 }
 
 static VALUE RGSS_Font_Measure(int argc, VALUE *argv, VALUE self)
@@ -115,33 +249,238 @@ static VALUE RGSS_Font_Measure(int argc, VALUE *argv, VALUE self)
     RGSS_ParseOpt(opts, "plain", false, &plain);
     RGSS_ParseOpt(opts, "align", PANGO_ALIGN_LEFT, &align);
 
-    RGSS_NewFont *font = DATA_PTR(self);
-    pango_layout_set_width(font->layout, w * PANGO_SCALE);
-    pango_layout_set_height(font->layout, h * PANGO_SCALE);
-    pango_layout_set_alignment(font->layout, align);
-    
+    RGSS_NewFont *font = RGSS_Font_Get(self);
     text = StringValue(text);
-    char *str = StringValuePtr(text);
-    int length = RSTRING_LEN(text);
-
-    if (plain)
-        pango_layout_set_text(font->layout, str, length);
-    else
-        pango_layout_set_markup(font->layout, str, length);
 
     RGSS_Size *size = ALLOC(RGSS_Size);
-    pango_layout_get_pixel_size(font->layout, &size->width, &size->height);
+    RGSS_Font_GetLayout(font, RSTRING_PTR(text), RSTRING_LEN(text), w, h, align, plain, &size->width, &size->height);
     return Data_Wrap_Struct(rb_cSize, NULL, RUBY_DEFAULT_FREE, size);
 }
 
+static VALUE RGSS_Font_MeasureMany(int argc, VALUE *argv, VALUE self)
+{
+    VALUE texts, width, height, opts;
+    rb_scan_args(argc, argv, "12:", &texts, &width, &height, &opts);
+    Check_Type(texts, T_ARRAY);
+
+    int w = RTEST(width) ? NUM2INT(width) : -1;
+    int h = RTEST(height) ? NUM2INT(height) : -1;
+
+    int plain, align;
+    RGSS_ParseOpt(opts, "plain", false, &plain);
+    RGSS_ParseOpt(opts, "align", PANGO_ALIGN_LEFT, &align);
+
+    // Sizes are returned as packed pairs of 32-bit integers, avoiding an object for every string
+    RGSS_NewFont *font = RGSS_Font_Get(self);
+    long count = RARRAY_LEN(texts);
+    VALUE result = rb_str_new(NULL, count * 2 * sizeof(int32_t));
+    for (long i = 0; i < count; i++)
+    {
+        int size[2] = {0, 0};
+        VALUE text = rb_ary_entry(texts, i);
+        if (!NIL_P(text))
+        {
+            text = StringValue(text);
+            RGSS_Font_GetLayout(font, RSTRING_PTR(text), RSTRING_LEN(text), w, h, align, plain, &size[0], &size[1]);
+        }
+
+        int32_t *sizes = (int32_t *)RSTRING_PTR(result);
+        sizes[i * 2] = size[0];
+        sizes[i * 2 + 1] = size[1];
+    }
+    return result;
+}
+
+static VALUE RGSS_Font_GetCacheCapacity(VALUE klass)
+{
+    return INT2NUM(RGSS_LAYOUT_CACHE.capacity);
+}
+
+static VALUE RGSS_Font_SetCacheCapacity(VALUE klass, VALUE value)
+{
+    int capacity = NUM2INT(value);
+    if (capacity < 0)
+        rb_raise(rb_eArgError, "cache capacity cannot be negative");
+    RGSS_LAYOUT_CACHE.capacity = capacity;
+    RGSS_Font_TrimCache(capacity);
+    return value;
+}
+
+static VALUE RGSS_Font_GetCacheStats(VALUE klass)
+{
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, STR2SYM("hits"), ULONG2NUM(RGSS_LAYOUT_CACHE.hits));
+    rb_hash_aset(hash, STR2SYM("misses"), ULONG2NUM(RGSS_LAYOUT_CACHE.misses));
+    rb_hash_aset(hash, STR2SYM("size"), UINT2NUM(HASH_COUNT(RGSS_LAYOUT_CACHE.entries)));
+    return hash;
+}
+
+static VALUE RGSS_Font_ClearCache(VALUE klass)
+{
+    RGSS_Font_TrimCache(0);
+    return Qnil;
+}
+
+static vec_str_t RGSS_FONT_EXTRACTED; /** Temporary files of fonts that were loaded from an archive. */
+
+static void RGSS_Font_RemoveExtracted(void)
+{
+    int i;
+    char *file;
+    vec_foreach(&RGSS_FONT_EXTRACTED, file, i)
+    {
+        remove(file);
+        free(file);
+    }
+    vec_deinit(&RGSS_FONT_EXTRACTED);
+}
+
+static char *RGSS_Font_Extract(const RGSS_Resource *resource)
+{
+    // Pango shapes text with the font file given to fontconfig, so fonts in archives are written out once and
+    // removed when the process exits
+    char file[1024];
+#ifdef _WIN32
+    char dir[MAX_PATH];
+    if (GetTempPathA(MAX_PATH, dir) == 0 || GetTempFileNameA(dir, "rgs", 0, file) == 0)
+        return NULL;
+    FILE *stream = fopen(file, "wb");
+#else
+    const char *dir = getenv("TMPDIR");
+    snprintf(file, sizeof(file), "%s/rgss-font-XXXXXX", dir && *dir ? dir : "/tmp");
+    int fd = mkstemp(file);
+    FILE *stream = fd < 0 ? NULL : fdopen(fd, "wb");
+#endif
+    if (stream == NULL)
+        return NULL;
+
+    int ok = fwrite(resource->data, 1, resource->size, stream) == resource->size;
+    ok = (fclose(stream) == 0) && ok;
+    if (!ok)
+    {
+        remove(file);
+        return NULL;
+    }
+
+    if (RGSS_FONT_EXTRACTED.length == 0)
+        atexit(RGSS_Font_RemoveExtracted);
+    char *copy = strdup(file);
+    vec_push(&RGSS_FONT_EXTRACTED, copy);
+    return copy;
+}
 
 static VALUE RGSS_Font_Add(VALUE klass, VALUE path)
 {
     char *file = StringValueCStr(path);
-    FcBool status = FcConfigAppFontAddFile(FcConfigGetCurrent(), file);
+
+    RGSS_Resource resource;
+    if (RGSS_Archive_Find(file, &resource))
+    {
+        char *extracted = RGSS_Font_Extract(&resource);
+        RGSS_Resource_Free(&resource);
+        if (extracted == NULL)
+            rb_raise(rb_eRGSSError, "failed to extract font from archive: %s", file);
+        file = extracted;
+    }
+
+    RGSS_Font_WaitPreload();
+    FcBool status = FcConfigAppFontAddFile(FcConfigGetCurrent(), (const FcChar8 *)file);
+    if (status)
+    {
+        // Cached layouts may have fallen back to another font for glyphs the new one provides
+        RGSS_Font_TrimCache(0);
+    }
     return RB_BOOL(status);
 }
 
+static void *RGSS_Font_Preload(void *unused)
+{
+    // Fontconfig scans the installed fonts the first time it is used, which is most of the cost of the first layout.
+    // The default font map is per-thread, so the fonts are resolved with a temporary one, sharing only the caches
+    // of fontconfig and the files read by the system.
+    FcInit();
+    PangoFontMap *map = pango_cairo_font_map_new();
+    PangoContext *context = pango_font_map_create_context(map);
+    PangoLanguage *language = pango_language_get_default();
+    for (int i = 0; i < RGSS_FONT_PRELOAD.count; i++)
+    {
+        PangoFontDescription *desc = pango_font_description_from_string(RGSS_FONT_PRELOAD.names[i]);
+        PangoFontset *fontset = pango_font_map_load_fontset(map, context, desc, language);
+        if (fontset)
+        {
+            // Resolving a font of the set opens its face
+            PangoFont *font = pango_fontset_get_font(fontset, ' ');
+            if (font)
+                g_object_unref(font);
+            g_object_unref(fontset);
+        }
+        pango_font_description_free(desc);
+        free(RGSS_FONT_PRELOAD.names[i]);
+    }
+    free(RGSS_FONT_PRELOAD.names);
+    RGSS_FONT_PRELOAD.names = NULL;
+    g_object_unref(context);
+    g_object_unref(map);
+
+    __atomic_store_n(&RGSS_FONT_PRELOAD.done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static VALUE RGSS_Font_PreloadRB(VALUE klass, VALUE descriptions)
+{
+    descriptions = rb_Array(descriptions);
+    long count = RARRAY_LEN(descriptions);
+
+    // Converted before waiting on a previous preload, as it may call into Ruby, and copied only after waiting, so nothing
+    // is leaked if a description is not a string or the wait is interrupted
+    VALUE strings = rb_ary_new_capa(count);
+    for (long i = 0; i < count; i++)
+    {
+        VALUE name = rb_ary_entry(descriptions, i);
+        StringValueCStr(name);
+        rb_ary_push(strings, name);
+    }
+
+    RGSS_Font_WaitPreload();
+    char **names = malloc(sizeof(char *) * RGSS_MAX(count, 1));
+    for (long i = 0; i < count; i++)
+        names[i] = strdup(RSTRING_PTR(RARRAY_AREF(strings, i)));
+    RB_GC_GUARD(strings);
+
+    RGSS_FONT_PRELOAD.names = names;
+    RGSS_FONT_PRELOAD.count = (int)count;
+    RGSS_FONT_PRELOAD.done = false;
+
+#ifndef _WIN32
+    // The thread never runs Ruby code, so keep signals meant for the interpreter from being delivered to it
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+#endif
+    int status = pthread_create(&RGSS_FONT_PRELOAD.thread, NULL, RGSS_Font_Preload, NULL);
+#ifndef _WIN32
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+#endif
+
+    if (status != 0)
+    {
+        // Not worth failing over, fontconfig will simply be initialized by the first layout
+        RGSS_LogWarn("Failed to start thread to preload fonts");
+        for (long i = 0; i < count; i++)
+            free(names[i]);
+        free(names);
+        RGSS_FONT_PRELOAD.names = NULL;
+        return Qfalse;
+    }
+    RGSS_FONT_PRELOAD.running = true;
+    return Qtrue;
+}
+
+static VALUE RGSS_Font_IsPreloading(VALUE klass)
+{
+    return RB_BOOL(RGSS_Font_IsPreloadPending() && !__atomic_load_n(&RGSS_FONT_PRELOAD.done, __ATOMIC_ACQUIRE));
+}
+
 static VALUE RGSS_Font_GetDefaultColor(VALUE klass)
 {
     VALUE color = rb_iv_get(klass, RGSS_IV_COLOR);
@@ -213,6 +552,7 @@ static VALUE RGSS_Font_SetSize(VALUE self, VALUE size)
     if (NIL_P(size))
         size = RGSS_Font_GetDefaultSize(rb_cFont);
     pango_font_description_set_size(font->desc, NUM2INT(size) * PANGO_SCALE);
+    RGSS_Font_Changed(font);
     return size;
 }
 
@@ -234,6 +574,7 @@ static VALUE RGSS_Font_SetWeight(VALUE self, VALUE value)
 {
     RGSS_NewFont *font = DATA_PTR(self);
     pango_font_description_set_weight(font->desc, NUM2INT(value));
+    RGSS_Font_Changed(font);
     return value;
 }
 
@@ -248,6 +589,7 @@ static VALUE RGSS_Font_SetStyle(VALUE self, VALUE value)
 {
     RGSS_NewFont *font = DATA_PTR(self);
     pango_font_description_set_style(font->desc, NUM2INT(value));
+    RGSS_Font_Changed(font);
     return value;
 }
 
@@ -262,6 +604,7 @@ static VALUE RGSS_Font_SetGravity(VALUE self, VALUE value)
 {
     RGSS_NewFont *font = DATA_PTR(self);
     pango_font_description_set_gravity(font->desc, NUM2INT(value));
+    RGSS_Font_Changed(font);
     return value;
 }
 
@@ -276,16 +619,13 @@ static VALUE RGSS_Font_SetStretch(VALUE self, VALUE value)
 {
     RGSS_NewFont *font = DATA_PTR(self);
     pango_font_description_set_stretch(font->desc, NUM2INT(value));
+    RGSS_Font_Changed(font);
     return value;
 }
 
 static void RGSS_Font_Free(void *data)
 {
     RGSS_NewFont *font = data;
-    if (font->context)
-        cairo_destroy(font->context);
-    if (font->layout)
-        g_object_unref(font->layout);
     if (font->desc)
         pango_font_description_free(font->desc);
     xfree(data);
@@ -310,23 +650,17 @@ static VALUE RGSS_Font_Initialize(int argc, VALUE *argv, VALUE self)
 
     // TODO: Build font description string based on opts (do in Ruby?)
 
-
-
-    cairo_surface_t *temp = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 0, 0);
-    font->context = cairo_create(temp);
-    cairo_surface_destroy(temp);
-    if (font->context == NULL)
-        rb_raise(rb_eRGSSError, "failed to create context for font");
-
-    font->layout = pango_cairo_create_layout(font->context);
-    if (font->layout == NULL)
-        rb_raise(rb_eRGSSError, "failed to create layout for font");
-
-    font->desc = pango_font_description_from_string(StringValueCStr(description));
-    if (font->desc == NULL)
+    // Fonts are only a description, all of them share the context and layouts of the layout cache
+    PangoFontDescription *desc = pango_font_description_from_string(StringValueCStr(description));
+    if (desc == NULL)
         rb_raise(rb_eRGSSError, "failed to create font from description");
-    pango_layout_set_font_description(font->layout, font->desc);
+    if (font->desc)
+        pango_font_description_free(font->desc);
+    font->desc = desc;
+    RGSS_Font_Changed(font);
 
+    VALUE color = RGSS_Font_GetDefaultColor(rb_cFont);
+    glm_vec4_copy(DATA_PTR(color), font->color);
 
     return self;
 }
@@ -462,12 +796,19 @@ void RGSS_Init_Font(VALUE parent)
     rb_define_singleton_method1(rb_cFont, "default_color=", RGSS_Font_SetDefaultColor, 1);
     rb_define_singleton_method0(rb_cFont, "default_size", RGSS_Font_GetDefaultSize, 0);
     rb_define_singleton_method1(rb_cFont, "default_size=", RGSS_Font_SetDefaultSize, 1);
+    rb_define_singleton_method0(rb_cFont, "cache_capacity", RGSS_Font_GetCacheCapacity, 0);
+    rb_define_singleton_method1(rb_cFont, "cache_capacity=", RGSS_Font_SetCacheCapacity, 1);
+    rb_define_singleton_method0(rb_cFont, "cache_stats", RGSS_Font_GetCacheStats, 0);
+    rb_define_singleton_method0(rb_cFont, "clear_cache", RGSS_Font_ClearCache, 0);
+    rb_define_singleton_method1(rb_cFont, "preload", RGSS_Font_PreloadRB, 1);
+    rb_define_singleton_method0(rb_cFont, "preloading?", RGSS_Font_IsPreloading, 0);
 
     rb_define_methodm1(rb_cFont, "initialize", RGSS_Font_Initialize, -1);
     rb_define_method0(rb_cFont, "to_s", RGSS_Font_ToString, 0);
     rb_define_method0(rb_cFont, "to_str", RGSS_Font_ToString, 0);
     rb_define_method0(rb_cFont, "family", RGSS_Font_GetFamily, 0);
     rb_define_methodm1(rb_cFont, "measure", RGSS_Font_Measure, -1);
+    rb_define_methodm1(rb_cFont, "measure_many", RGSS_Font_MeasureMany, -1);
     DEFINE_ACCESSOR(rb_cFont, RGSS_Font, Size, "size");
     DEFINE_ACCESSOR(rb_cFont, RGSS_Font, Color, "color");
     DEFINE_ACCESSOR(rb_cFont, RGSS_Font, Style, "style");
@@ -480,8 +821,6 @@ void RGSS_Init_Font(VALUE parent)
 
 
     // rb_define_methodm1(rb_cFont, "bake", RGSS_Font_Bake, -1);
-    
-    // rb_define_singleton_method3(rb_cFont, "test_texture", RGSS_Font_TestTexture, 3);
 
     rb_define_const(rb_cFont, "ALIGN_LEFT", INT2NUM(PANGO_ALIGN_LEFT));
     rb_define_const(rb_cFont, "ALIGN_CENTER", INT2NUM(PANGO_ALIGN_CENTER));
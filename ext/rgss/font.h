@@ -0,0 +1,155 @@
+#ifndef RGSS_FONT_H
+#define RGSS_FONT_H 1
+
+#include "game.h"
+#include <pango/pangocairo.h>
+
+#define RGSS_GLYPH_PAGE_SIZE 1024 /** The width and height of each page of the glyph atlas, in pixels. */
+#define RGSS_SDF_SIZE 48          /** The pixel size glyphs are rasterized at to generate distance fields. */
+#define RGSS_SDF_SPREAD 8         /** The distance from the outline a distance field covers, in reference pixels. */
+
+typedef struct
+{
+    PangoFontDescription *desc;
+    RGSS_Color color;
+    unsigned int serial; /** Identifies the current state of the description in the layout cache. */
+} RGSS_NewFont;
+
+/**
+ * @brief Retrieves a laid out text from the layout cache, only shaping it when the same text has not been laid out
+ * recently with the same font and settings.
+ * @param[in] font The font to lay out the text with.
+ * @param[in] text The text or markup to lay out.
+ * @param[in] length The length of the text, in bytes.
+ * @param[in] width The width lines are wrapped at in pixels, or a negative value to not wrap.
+ * @param[in] height The height the text is limited to in pixels, or a negative value for no limit.
+ * @param[in] align The alignment of lines.
+ * @param[in] plain Flag indicating if the text is laid out as-is instead of parsed as markup.
+ * @param[out] pixel_width The width of the layout in pixels, or @c NULL.
+ * @param[out] pixel_height The height of the layout in pixels, or @c NULL.
+ * @return The layout, which is owned by the cache and must not be modified or kept after another layout is retrieved.
+ */
+PangoLayout *RGSS_Font_GetLayout(RGSS_NewFont *font, const char *text, long length, int width, int height, int align,
+                                 int plain, int *pixel_width, int *pixel_height);
+
+/**
+ * @brief A glyph rasterized into the shared atlas, looked up by the font and glyph index it was shaped with.
+ */
+typedef struct
+{
+    struct
+    {
+        PangoFont *font;  /** The font the glyph belongs to, which includes its size. */
+        PangoGlyph glyph; /** The index of the glyph within the font. */
+    } key;
+    int page;          /** The index of the atlas page the glyph is stored in. */
+    vec4 uv;           /** The area of the page as left, top, right, and bottom, in normalized coordinates. */
+    int x;             /** The horizontal offset of the bitmap from the pen position, in pixels. */
+    int y;             /** The vertical offset of the bitmap from the baseline, in pixels. */
+    int width;         /** The width of the bitmap, in pixels, @c 0 for glyphs without ink. */
+    int height;        /** The height of the bitmap, in pixels. */
+    UT_hash_handle hh; /** Makes the structure hashable by font and glyph. */
+} RGSS_Glyph;
+
+/**
+ * @brief A positioned glyph, consumed directly as per-instance vertex attributes by the text shader.
+ */
+typedef struct
+{
+    vec4 dst;    /** The area to draw as x, y, width, and height, in pixels relative to the origin of the text. */
+    vec4 src;    /** The area of the atlas page as left, top, right, and bottom, in normalized coordinates. */
+    vec4 color;  /** The color of the glyph. */
+    int page;    /** The index of the atlas page the glyph is stored in. */
+    float index; /** The position of the glyph within the run, used to reveal glyphs in order. */
+} RGSS_GlyphQuad;
+
+/**
+ * @brief A consecutive range of glyphs that are stored in the same atlas page, and drawn with a single call.
+ */
+typedef struct
+{
+    int page;  /** The index of the atlas page. */
+    int start; /** The index of the first glyph. */
+    int count; /** The number of glyphs. */
+} RGSS_GlyphBatch;
+
+/**
+ * @brief The glyphs of a laid out text, in logical order.
+ */
+typedef struct
+{
+    vec_t(RGSS_GlyphQuad) quads;     /** The glyphs with ink, in the order they appear in the text. */
+    vec_t(RGSS_GlyphBatch) batches; /** The ranges of glyphs that share an atlas page. */
+    int sdf;                        /** Flag indicating if the glyphs are stored in the distance field atlas. */
+    int width;                      /** The width of the layout, in pixels. */
+    int height;                     /** The height of the layout, in pixels. */
+} RGSS_GlyphRun;
+
+/**
+ * @brief Retrieves a glyph from the atlas, rasterizing it into a page the first time it is used.
+ * @param[in] font The font the glyph was shaped with.
+ * @param[in] glyph The index of the glyph within the font.
+ * @return The cached glyph.
+ */
+RGSS_Glyph *RGSS_Glyph_Get(PangoFont *font, PangoGlyph glyph);
+
+/**
+ * @brief Retrieves a glyph from the distance field atlas, generating it from the same face at the reference size
+ * (@ref RGSS_SDF_SIZE) the first time it is used by any size of that face.
+ * @param[in] font The font the glyph was shaped with.
+ * @param[in] glyph The index of the glyph within the font.
+ * @param[out] scale Receives the size of @p font relative to the reference size, which the metrics of the glyph
+ * are multiplied by.
+ * @return The cached glyph, with metrics in reference pixels.
+ */
+RGSS_Glyph *RGSS_Glyph_GetDistance(PangoFont *font, PangoGlyph glyph, float *scale);
+
+/**
+ * @brief Retrieves the OpenGL texture of a page of the glyph atlas.
+ * @param[in] page The index of the page.
+ * @param[in] sdf Flag indicating if the page is from the distance field atlas.
+ * @return The name of the texture, a single channel of coverage or distance.
+ */
+GLuint RGSS_Glyph_GetPage(int page, int sdf);
+
+/**
+ * @brief Collects the shaped glyphs of a layout into a run of positioned quads, rasterizing any glyphs not yet in
+ * the atlas. Colors set with markup are kept per glyph.
+ * @param[in] layout The layout to collect the glyphs of.
+ * @param[in] color The color of glyphs without a color set by markup.
+ * @param[in] sdf Flag indicating if the glyphs are taken from the distance field atlas.
+ * @param[in,out] run The run to fill, any existing glyphs are replaced.
+ */
+void RGSS_GlyphRun_Build(PangoLayout *layout, const RGSS_Color color, int sdf, RGSS_GlyphRun *run);
+
+/**
+ * @brief Writes the glyphs of a run to an instance buffer, growing it only when it is too small.
+ * @param[in] run The run to upload.
+ * @param[in] buffer The name of the instance buffer.
+ * @param[in,out] capacity The size of the buffer, in bytes.
+ */
+void RGSS_GlyphRun_Upload(RGSS_GlyphRun *run, GLuint buffer, GLsizeiptr *capacity);
+
+/**
+ * @brief Draws the first glyphs of a run as instanced quads, with one draw for each atlas page used.
+ * @param[in] run The run to draw.
+ * @param[in] vao A vertex array configured with @ref RGSS_GlyphRun_Setup.
+ * @param[in] buffer The instance buffer the run was uploaded to.
+ * @param[in] count The number of glyphs to draw from the start of the run.
+ * @note The text shader must be in use.
+ */
+void RGSS_GlyphRun_Draw(RGSS_GlyphRun *run, GLuint vao, GLuint buffer, int count);
+
+/**
+ * @brief Configures the bound vertex array to draw glyph quads sourced from an instance buffer.
+ * @param[in] corners A buffer with the corners of a unit quad, drawn as a triangle strip.
+ */
+void RGSS_GlyphRun_Setup(GLuint corners);
+
+/**
+ * @brief Releases the glyphs and batches of a run.
+ * @param[in] run The run to free.
+ */
+void RGSS_GlyphRun_Free(RGSS_GlyphRun *run);
+
+#endif /* RGSS_FONT_H */
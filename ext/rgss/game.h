@@ -34,21 +34,47 @@
         return Data_Wrap_Struct(klass, NULL, free, v);                                                                 \
     }
 
-typedef enum
+/**
+ * @brief Describes the filtering and wrapping state of a sampler object, and doubles as the key used to look
+ * up shared samplers in the cache. All fields must be initialized, as the structure is hashed as raw bytes.
+ */
+typedef struct
 {
-    RGSS_FLIP_NONE = 0x00,
-    RGSS_FLIP_X = 0x01,
-    RGSS_FLIP_Y = 0x02,
-    RGSS_FLIP_BOTH = (RGSS_FLIP_X | RGSS_FLIP_Y)
-} RGSS_Flip;
+    GLenum min_filter;  /** The minification filter. */
+    GLenum mag_filter;  /** The magnification filter. */
+    GLenum wrap_s;      /** The wrapping mode on the s-axis. */
+    GLenum wrap_t;      /** The wrapping mode on the t-axis. */
+    GLfloat anisotropy; /** The maximum degree of anisotropic filtering, @c 1.0 to disable. */
+} RGSS_SamplerState;
+
+typedef struct RGSS_Texture RGSS_Texture;
 
+/**
+ * @brief A deferred blit or fill into a texture, recorded until the destination is next used. The layout of the
+ * @c dst, @c src, and @c color fields is consumed directly as per-instance vertex attributes by the blit shader.
+ */
 typedef struct
+{
+    RGSS_Texture *source; /** The texture to copy from, or @c NULL to fill the destination with a solid color. */
+    VALUE object;         /** The Ruby object of the source, marked while the command is pending, or @c Qnil. */
+    vec4 dst;             /** The destination area as x, y, width, and height, in pixels. */
+    vec4 src;             /** The source area as left, top, right, and bottom, in normalized texture coordinates. */
+    vec4 color;           /** The solid fill color, or the color the source is modulated with. */
+} RGSS_BlitCommand;
+
+struct RGSS_Texture
 {
     GLuint id;
     GLuint fbo;
     int width;
     int height;
-} RGSS_Texture;
+    RGSS_SamplerState sampler;        /** The default sampler state used when drawing the texture. */
+    int mipmaps;                      /** Flag indicating if mipmaps are used when the texture is drawn scaled down. */
+    int mipmaps_dirty;                /** Flag indicating the mipmap chain is out of date with the base level. */
+    vec_t(RGSS_BlitCommand) commands; /** Pending commands that draw into this texture. */
+    int pending_reads;                /** The number of pending commands of other textures that read from this one. */
+    void (*sync)(RGSS_Texture *);     /** Optional callback to upload CPU-side changes before the texture is used. */
+};
 
 typedef struct
 {
@@ -132,6 +158,8 @@ typedef struct
         vec2 resolution;
         vec2 ratio;
         GLuint ubo;
+        GLuint target; /** The framebuffer the scene is drawn to, or @c GL_NONE for the window. */
+        GLuint program; /** The program in use, tracked so redundant changes are skipped. */
         RGSS_Rect viewport;
         RGSS_Color color;
         RGSS_Batch batch;
@@ -155,6 +183,41 @@ typedef struct
             GLint opacity;
             GLint textured;
         } particle_shader;
+        struct
+        {
+            GLuint id;
+            GLint model;
+            GLint color;
+            GLint tone;
+            GLint flash;
+            GLint hue;
+            GLint opacity;
+            GLint reveal;
+            GLint reveal_fade;
+        } text_shader;
+        struct
+        {
+            GLuint id;
+            GLint model;
+            GLint color;
+            GLint tone;
+            GLint flash;
+            GLint hue;
+            GLint opacity;
+            GLint reveal;
+            GLint reveal_fade;
+            GLint spread;
+            GLint outline_color;
+            GLint outline_width;
+            GLint shadow_color;
+            GLint shadow_offset;
+        } sdf_shader;
+        struct
+        {
+            GLuint id;
+            GLint target_size;
+            GLint textured;
+        } blit_shader;
     } graphics;
     struct
     {
@@ -176,14 +239,162 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync);
 void RGSS_Graphics_Deinit(GLFWwindow *window);
 void RGSS_Graphics_Render(double alpha);
 
+/**
+ * @brief Flushes pending texture commands, clears the current framebuffer, and draws each item in the batch.
+ * @param[in] alpha The interpolation between the previous and the current tick.
+ */
+void RGSS_Graphics_RenderScene(double alpha);
+
+/**
+ * @brief Uploads a projection matrix to the uniform block shared by all programs.
+ * @param[in] matrix The projection matrix.
+ */
+void RGSS_Graphics_SetProjection(mat4 matrix);
+
+/**
+ * @brief Creates the resources used for screen transitions, and begins compiling the built-in cross-fade program.
+ */
+void RGSS_Transition_Init(void);
+
+/**
+ * @brief Deletes the render targets and programs used for screen transitions.
+ */
+void RGSS_Transition_Deinit(void);
+
+/**
+ * @brief Draws the frozen screen to the window in place of the scene while the graphics are frozen.
+ * @return @c true if the graphics are frozen and the snapshot was drawn, otherwise @c false.
+ */
+int RGSS_Transition_DrawFrozen(void);
+
+/**
+ * @brief Deletes the pages of the glyph atlas and releases all cached glyphs.
+ */
+void RGSS_Glyph_Deinit(void);
+
 void RGSS_Input_Init(GLFWwindow *window);
 void RGSS_Input_Deinit(GLFWwindow *window);
 void RGSS_Input_Update(void);
 
 VALUE RGSS_Graphics_Restore(VALUE graphics);
 
+/**
+ * @brief Retrieves a shared sampler object matching the given state, creating and caching it on first use.
+ * @param[in] state The filter, wrap, and anisotropy state of the sampler.
+ * @return The OpenGL name of the sampler. The sampler is owned by the cache and must not be deleted.
+ */
+GLuint RGSS_Sampler_Get(const RGSS_SamplerState *state);
+
+/**
+ * @brief Deletes all cached sampler objects.
+ */
+void RGSS_Sampler_Deinit(void);
+
+/**
+ * @brief Binds a texture and a cached sampler to the specified texture unit. When the texture has mipmaps enabled
+ * and is being drawn scaled down, the mipmap chain is rebuilt if out of date and a trilinear sampler is used.
+ * @param[in] texture The texture to bind.
+ * @param[in] unit The zero-based index of the texture unit.
+ * @param[in] state The sampler state to use, or @c NULL to use the texture's default state.
+ * @param[in] minified Flag indicating if the texture is being drawn scaled down.
+ * @note Callers should unbind the sampler from the unit with @c glBindSampler when done drawing.
+ */
+void RGSS_Texture_BindSampled(RGSS_Texture *texture, GLuint unit, const RGSS_SamplerState *state, int minified);
+
+/**
+ * @brief Executes the pending blit and fill commands of a texture as instanced draws, if any.
+ * @param[in] texture The texture to flush.
+ */
+void RGSS_Texture_Flush(RGSS_Texture *texture);
+
+/**
+ * @brief Executes the pending commands of all textures, called before each frame is rendered.
+ */
+void RGSS_Texture_FlushAll(void);
+
+/**
+ * @brief Creates the OpenGL texture for a texture structure.
+ * @param[in] width The width of the texture, in pixels.
+ * @param[in] height The height of the texture, in pixels.
+ * @param[in] data Tightly packed pixel data to initialize the texture with, or @c NULL.
+ * @param[in] opts A Ruby Hash of texture options (see Texture.default_options), or @c Qnil.
+ * @param[in,out] texture The texture to initialize.
+ */
+void RGSS_Texture_Generate(int width, int height, void *data, VALUE opts, RGSS_Texture *texture);
+
+/**
+ * @brief Marks the sources of the pending commands of a texture, so they are not collected before being drawn.
+ * @param[in] data A pointer to the texture.
+ */
+void RGSS_Texture_Mark(void *data);
+
+/**
+ * @brief Releases a texture structure when its Ruby object is garbage collected. Pending commands are dropped, as no
+ * OpenGL calls can be made during garbage collection.
+ * @param[in] data A pointer to the texture.
+ */
+void RGSS_Texture_Free(void *data);
+
+/**
+ * @brief Parses the arguments given to Texture#blit.
+ * @param[in] argc The number of arguments.
+ * @param[in] argv The arguments.
+ * @param[out] dst_rect The destination area.
+ * @param[out] src_rect The source area.
+ * @param[out] opacity The normalized opacity.
+ * @return The source texture.
+ */
+VALUE RGSS_Texture_ParseBlit(int argc, VALUE *argv, RGSS_Rect *dst_rect, RGSS_Rect *src_rect, float *opacity);
+
+/**
+ * @brief Parses the arguments given to Texture#fill_rect.
+ * @param[in] argc The number of arguments.
+ * @param[in] argv The arguments.
+ * @param[out] rect The area to fill.
+ * @return A pointer to the color to fill with.
+ */
+float *RGSS_Texture_ParseFill(int argc, VALUE *argv, RGSS_Rect *rect);
+
+/**
+ * @brief Parses the arguments given to Texture#draw_text, and renders the text into a shared scratch surface.
+ * @param[in] argc The number of arguments.
+ * @param[in] argv The arguments.
+ * @param[in] target_width The width of the texture the text is drawn to, which the area is clipped to.
+ * @param[in] target_height The height of the texture the text is drawn to, which the area is clipped to.
+ * @param[out] area The area of the texture to replace.
+ * @param[out] pixels The rendered area, as native-endian ARGB words with straight alpha. Only valid until text is
+ * rendered again.
+ * @param[out] row_length The number of pixels between the start of each row of @p pixels.
+ * @return @c true if any of the area is within the texture, otherwise @c false and there is nothing to draw.
+ */
+int RGSS_Texture_RenderText(int argc, VALUE *argv, int target_width, int target_height, RGSS_Rect *area,
+                            uint32_t **pixels, int *row_length);
+
 extern RGSS_Game RGSS_GAME;
 
+/**
+ * @brief Makes a program current, unless it already is. All changes of the current program must go through this.
+ * @param[in] program The name of the program, or @c GL_NONE.
+ */
+static inline void RGSS_Graphics_UseProgram(GLuint program)
+{
+    if (RGSS_GAME.graphics.program == program)
+        return;
+    RGSS_GAME.graphics.program = program;
+    glUseProgram(program);
+}
+
+/**
+ * @brief Deletes a program, forgetting it as the current one so a new program reusing its name is still made current.
+ * @param[in] program The name of the program.
+ */
+static inline void RGSS_Graphics_DeleteProgram(GLuint program)
+{
+    if (RGSS_GAME.graphics.program == program)
+        RGSS_GAME.graphics.program = GL_NONE;
+    glDeleteProgram(program);
+}
+
 static inline void RGSS_ParseOpt(VALUE opts, const char *name, int ifnone, int *result)
 {
     if (result == NULL)
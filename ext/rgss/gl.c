@@ -1,5 +1,5 @@
 #include "glad.h"
-#include "rgss.h"
+#include "game.h"
 
 #define NUM2BYTE(v) ((GLubyte) NUM2CHR(v))
 
@@ -739,7 +739,7 @@ static VALUE rb_glCreateShader(VALUE gl, VALUE type) {
 }
 
 static VALUE rb_glDeleteProgram(VALUE gl, VALUE program) {
-    glDeleteProgram(NUM2UINT(program));
+    RGSS_Graphics_DeleteProgram(NUM2UINT(program));
     return Qnil;
 }
 
@@ -862,7 +862,7 @@ static VALUE rb_glShaderSource(VALUE gl, VALUE shader, VALUE string) {
 }
 
 static VALUE rb_glUseProgram(VALUE gl, VALUE program) {
-    glUseProgram(NUM2UINT(program));
+    RGSS_Graphics_UseProgram(NUM2UINT(program));
     return Qnil;
 }
 
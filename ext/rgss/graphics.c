@@ -8,6 +8,7 @@ VALUE rb_cShader;
 GLuint RGSS_BLIT_VAO;
 GLuint RGSS_BLIT_VBO;
 GLuint RGSS_BLIT_EBO;
+GLuint RGSS_BLIT_INSTANCES;
 
 void RGSS_Graphics_GLCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *msg,
                               const void *data)
@@ -88,6 +89,8 @@ GLuint RGSS_CreateProgram(GLuint vertex, GLuint fragment, GLuint geometry)
     if (geometry != GL_NONE)
         glAttachShader(program, geometry);
 
+    if (RGSS_Program_CacheEnabled())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(program);
     glDetachShader(program, vertex);
     glDetachShader(program, fragment);
@@ -103,53 +106,100 @@ GLuint RGSS_CreateProgram(GLuint vertex, GLuint fragment, GLuint geometry)
         char buffer[length];
 
         glGetProgramInfoLog(program, length, NULL, buffer);
-        glDeleteProgram(program);
+        RGSS_Graphics_DeleteProgram(program);
         rb_raise(rb_eRGSSError, "failed to link shader program: %s", buffer);
     }
 
-    GLint index = glGetUniformBlockIndex(program, "RGSS");
-    if (index != GL_INVALID_INDEX)
-    {
-        glUniformBlockBinding(program, index, 0);
-        RGSS_LogDebug("Shader (ID:%u) bound to projection UBO at index %d", program, index);
-    }
+    RGSS_Program_BindBlocks(program);
     RGSS_LogDebug("Shader (ID:%u) compilation and linkage completed successfully", program);
     return program;
 }
 
 GLuint RGSS_CreateProgramFromSource(const char *vert_src, const char *frag_src, const char *geom_src)
 {
-    GLuint vert = RGSS_CreateShader(vert_src, GL_VERTEX_SHADER);
-    GLuint frag = RGSS_CreateShader(frag_src, GL_FRAGMENT_SHADER);
-    GLuint geom = geom_src ? RGSS_CreateShader(geom_src, GL_GEOMETRY_SHADER) : GL_NONE;
-    GLuint program = RGSS_CreateProgram(vert, frag, geom);
+    RGSS_Shader shader;
+    RGSS_Program_Begin(&shader, vert_src, frag_src, geom_src);
+    RGSS_Program_Finish(&shader);
+    return shader.id;
+}
+
+typedef struct
+{
+    const char *paths[3]; /** The paths of the vertex, fragment, and optional geometry stages. */
+    char *sources[3];     /** The sources read from each path, or @c NULL. */
+    RGSS_Shader *shader;  /** The shader to begin compiling, or @c NULL to create a complete program. */
+    GLuint program;       /** The program created when there is no shader. */
+} RGSS_ProgramFiles;
 
-    glDeleteShader(vert);
-    glDeleteShader(frag);
-    glDeleteShader(geom);
-    return program;
+static VALUE RGSS_ProgramFiles_Compile(VALUE value)
+{
+    RGSS_ProgramFiles *files = (RGSS_ProgramFiles *)value;
+    for (int i = 0; i < 3; i++)
+    {
+        if (files->paths[i])
+            files->sources[i] = RGSS_ReadFileText(files->paths[i]);
+    }
+
+    if (files->shader)
+        RGSS_Program_Begin(files->shader, files->sources[0], files->sources[1], files->sources[2]);
+    else
+        files->program = RGSS_CreateProgramFromSource(files->sources[0], files->sources[1], files->sources[2]);
+    return Qnil;
+}
+
+static VALUE RGSS_ProgramFiles_Free(VALUE value)
+{
+    RGSS_ProgramFiles *files = (RGSS_ProgramFiles *)value;
+    for (int i = 0; i < 3; i++)
+    {
+        if (files->sources[i])
+            xfree(files->sources[i]);
+    }
+    return Qnil;
+}
+
+/**
+ * @brief Reads the source of each stage, and compiles them. Reading any file or compiling may raise, so the sources
+ * already read are freed when it does.
+ */
+static void RGSS_ProgramFiles_Run(RGSS_ProgramFiles *files)
+{
+    rb_ensure(RGSS_ProgramFiles_Compile, (VALUE)files, RGSS_ProgramFiles_Free, (VALUE)files);
 }
 
 GLuint RGSS_CreateProgramFromFile(const char *vert_path, const char *frag_path, const char *geom_path)
 {
-    char *vert = RGSS_ReadFileText(vert_path);
-    char *frag = RGSS_ReadFileText(frag_path);
-    char *geom = geom_path ? RGSS_ReadFileText(geom_path) : NULL;
-    GLuint program = RGSS_CreateProgramFromSource(vert, frag, geom);
+    RGSS_ProgramFiles files = {{vert_path, frag_path, geom_path}};
+    RGSS_ProgramFiles_Run(&files);
+    return files.program;
+}
+
+static void RGSS_Program_BeginFromFile(RGSS_Shader *shader, const char *vert_path, const char *frag_path,
+                                       const char *geom_path)
+{
+    RGSS_ProgramFiles files = {{vert_path, frag_path, geom_path}, {NULL}, shader};
+    RGSS_ProgramFiles_Run(&files);
+}
 
-    xfree(vert);
-    xfree(geom);
-    if (geom)
-        xfree(geom);
+static RGSS_Shader *RGSS_Shader_Get(VALUE self)
+{
+    RGSS_Shader *shader = DATA_PTR(self);
+    RGSS_ASSERT_SHADER(shader->id);
+    RGSS_Program_Finish(shader);
+    return shader;
+}
 
-    return program;
+static void RGSS_Shader_Free(void *data)
+{
+    RGSS_Program_FreeUniforms(data);
+    xfree(data);
 }
 
 static VALUE RGSS_Shader_Alloc(VALUE klass)
 {
     RGSS_Shader *shader = ALLOC(RGSS_Shader);
     memset(shader, 0, sizeof(RGSS_Shader));
-    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, shader);
+    return Data_Wrap_Struct(klass, NULL, RGSS_Shader_Free, shader);
 }
 
 static VALUE RGSS_Shader_Load(int argc, VALUE *argv, VALUE klass)
@@ -161,14 +211,9 @@ static VALUE RGSS_Shader_Load(int argc, VALUE *argv, VALUE klass)
     char *frag_path = StringValueCStr(f);
     char *geom_path = RTEST(g) ? StringValueCStr(g) : NULL;
 
-    GLuint program = RGSS_CreateProgramFromFile(vert_path, frag_path, geom_path);
-    if (program == GL_NONE)
-        rb_raise(rb_eRGSSError, "failed to create shader program");
-
-    RGSS_Shader *shader = ALLOC(RGSS_Shader);
-    shader->id = program;
-
-    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, shader);
+    VALUE self = RGSS_Shader_Alloc(klass);
+    RGSS_Program_BeginFromFile(DATA_PTR(self), vert_path, frag_path, geom_path);
+    return self;
 }
 
 static VALUE RGSS_Shader_Initialize(int argc, VALUE *argv, VALUE self)
@@ -180,47 +225,76 @@ static VALUE RGSS_Shader_Initialize(int argc, VALUE *argv, VALUE self)
     char *frag = StringValueCStr(f);
     char *geom = RTEST(g) ? StringValueCStr(g) : NULL;
 
-    GLuint id = RGSS_CreateProgramFromSource(vert, frag, geom);
-    if (id == GL_NONE)
-        rb_raise(rb_eRGSSError, "failed to create shader program");
-
+    // Status is checked on first use, so drivers with threaded compilers can overlap compiling many programs
     RGSS_Shader *shader = DATA_PTR(self);
-    shader->id = id;
-
+    RGSS_Program_Delete(shader);
+    RGSS_Program_Begin(shader, vert, frag, geom);
     return self;
 }
 
 static VALUE RGSS_Shader_Use(VALUE self)
 {
-    RGSS_Shader *shader = DATA_PTR(self);
-    RGSS_ASSERT_SHADER(shader->id);
-    glUseProgram(shader->id);
+    RGSS_Program_Use(RGSS_Shader_Get(self));
     return self;
 }
 
 static VALUE RGSS_Shader_GetID(VALUE self)
 {
     RGSS_Shader *shader = DATA_PTR(self);
+    if (shader->id != GL_NONE)
+        RGSS_Program_Finish(shader);
     return UINT2NUM(shader->id);
 }
 
+static VALUE RGSS_Shader_IsReady(VALUE self)
+{
+    RGSS_Shader *shader = DATA_PTR(self);
+    RGSS_ASSERT_SHADER(shader->id);
+    return RB_BOOL(RGSS_Program_IsReady(shader));
+}
+
 static VALUE RGSS_Shader_Locate(VALUE self, VALUE uniform)
 {
     if (uniform == Qnil)
         return INT2NUM(-1);
-    RGSS_Shader *shader = DATA_PTR(self);
-    RGSS_ASSERT_SHADER(shader->id);
-    return INT2NUM(glGetUniformLocation(shader->id, StringValueCStr(uniform)));
+    RGSS_Shader *shader = RGSS_Shader_Get(self);
+    return INT2NUM(RGSS_Program_Locate(shader, StringValueCStr(uniform)));
+}
+
+static VALUE RGSS_Shader_GetUniforms(VALUE self)
+{
+    return RGSS_Program_Uniforms(RGSS_Shader_Get(self));
+}
+
+static inline const char *RGSS_Shader_UniformName(VALUE name)
+{
+    return SYMBOL_P(name) ? rb_id2name(SYM2ID(name)) : StringValueCStr(name);
+}
+
+static VALUE RGSS_Shader_Store(VALUE self, VALUE name, VALUE value)
+{
+    RGSS_Program_Set(RGSS_Shader_Get(self), RGSS_Shader_UniformName(name), value);
+    return value;
+}
+
+static int RGSS_Shader_StoreEach(VALUE name, VALUE value, VALUE self)
+{
+    RGSS_Program_Set(DATA_PTR(self), RGSS_Shader_UniformName(name), value);
+    return ST_CONTINUE;
+}
+
+static VALUE RGSS_Shader_Set(VALUE self, VALUE values)
+{
+    // Values are applied together when the program is next used, instead of binding it for each one
+    Check_Type(values, T_HASH);
+    RGSS_Shader_Get(self);
+    rb_hash_foreach(values, RGSS_Shader_StoreEach, self);
+    return self;
 }
 
 static VALUE RGSS_Shader_Dispose(VALUE self)
 {
-    RGSS_Shader *shader = DATA_PTR(self);
-    if (shader->id != GL_NONE)
-    {
-        glDeleteProgram(shader->id);
-        shader->id = GL_NONE;
-    }
+    RGSS_Program_Delete(DATA_PTR(self));
     return Qnil;
 }
 
@@ -236,9 +310,9 @@ static VALUE RGSS_Shader_SetUniform(VALUE self, VALUE location, VALUE value)
     if (loc < 0)
         rb_raise(rb_eArgError, "uniform location must be 0 or greater (given %d)", loc);
 
-    RGSS_Shader *shader = DATA_PTR(self);
+    RGSS_Shader *shader = RGSS_Shader_Get(self);
     int type = TYPE(value);
-    glUseProgram(shader->id);
+    RGSS_Graphics_UseProgram(shader->id);
 
     switch (type)
     {
@@ -289,10 +363,10 @@ static VALUE RGSS_Shader_SetUniform(VALUE self, VALUE location, VALUE value)
 
 // TODO: Uniform setters
 
-static inline void RGSS_Graphics_SetProjection(mat4 ortho)
+void RGSS_Graphics_SetProjection(mat4 matrix)
 {
     glBindBuffer(GL_UNIFORM_BUFFER, RGSS_GRAPHICS.ubo);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, RGSS_MAT4_SIZE, ortho);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, RGSS_MAT4_SIZE, matrix);
     glBindBuffer(GL_UNIFORM_BUFFER, GL_NONE);
 }
 
@@ -435,8 +509,17 @@ VALUE RGSS_Graphics_Restore(VALUE graphics)
     if (RGSS_GAME.window == NULL)
         return Qnil;
     // TODO: Restore projection?
-    glBindFramebuffer(GL_FRAMEBUFFER, GL_NONE);
-    RGSS_VIEWPORT(RGSS_GRAPHICS.viewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, RGSS_GRAPHICS.target);
+    if (RGSS_GRAPHICS.target == GL_NONE)
+    {
+        RGSS_VIEWPORT(RGSS_GRAPHICS.viewport);
+    }
+    else
+    {
+        // Off-screen targets are always sized to the internal resolution
+        RGSS_Rect rect = {0, 0, (int)RGSS_GRAPHICS.resolution[0], (int)RGSS_GRAPHICS.resolution[1]};
+        RGSS_VIEWPORT(rect);
+    }
     RGSS_CLEAR_COLOR(RGSS_GRAPHICS.color);
     return Qnil;
 }
@@ -446,6 +529,7 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync)
     glfwSwapInterval(vsync);
     RGSS_LogInfo(vsync ? "Enabled vertical synchronization" : "Frame limiting disabled, let 'er rip");
     RGSS_GRAPHICS.projection = RGSS_MAT4_NEW;
+    RGSS_GRAPHICS.program = GL_NONE;
     RGSS_GRAPHICS.resolution[0] = (float)width;
     RGSS_GRAPHICS.resolution[1] = (float)height;
     RGSS_LogInfo("Internal resolution initialized to %dx%d", width, height);
@@ -475,8 +559,22 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync)
     }
 
     vec_init(&RGSS_GRAPHICS.batch.items);
+    RGSS_Program_Init();
 
-    GLuint id = RGSS_CreateProgramFromSource(SPRITE_VERT_SRC, SPRITE_FRAG_SRC, NULL);
+    // Start all built-in programs before waiting on any of them, to overlap their compilation where possible
+    RGSS_Shader sprite, particle, blit, text, sdf;
+    RGSS_Program_Begin(&sprite, SPRITE_VERT_SRC, SPRITE_FRAG_SRC, NULL);
+    // TODO:
+    const char *v = "/home/eric/open_rpg/lib/rgss/shaders/particles-vert.glsl";
+    const char *f = "/home/eric/open_rpg/lib/rgss/shaders/particles-frag.glsl";
+    RGSS_Program_BeginFromFile(&particle, v, f, NULL);
+    RGSS_Program_Begin(&blit, BLIT_VERT_SRC, BLIT_FRAG_SRC, NULL);
+    RGSS_Program_Begin(&text, TEXT_VERT_SRC, TEXT_FRAG_SRC, NULL);
+    RGSS_Program_Begin(&sdf, TEXT_VERT_SRC, TEXT_SDF_FRAG_SRC, NULL);
+    RGSS_Transition_Init();
+
+    RGSS_Program_Finish(&sprite);
+    GLuint id = sprite.id;
     RGSS_GRAPHICS.shader.id = id;
     RGSS_GRAPHICS.shader.model = glGetUniformLocation(id, "model");
     RGSS_GRAPHICS.shader.color = glGetUniformLocation(id, "color");
@@ -486,11 +584,8 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync)
     RGSS_GRAPHICS.shader.opacity = glGetUniformLocation(id, "opacity");
     RGSS_LogDebug("Successfully compiled and linked sprite shader");
 
-
-    // TODO:
-    const char *v = "/home/eric/open_rpg/lib/rgss/shaders/particles-vert.glsl";
-    const char *f = "/home/eric/open_rpg/lib/rgss/shaders/particles-frag.glsl";
-    id = RGSS_CreateProgramFromFile(v, f, NULL);
+    RGSS_Program_Finish(&particle);
+    id = particle.id;
     RGSS_GRAPHICS.particle_shader.id = id;
     RGSS_GRAPHICS.particle_shader.color = glGetUniformLocation(id, "color");
     RGSS_GRAPHICS.particle_shader.tone = glGetUniformLocation(id, "tone");
@@ -500,12 +595,50 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync)
     RGSS_GRAPHICS.particle_shader.textured = glGetUniformLocation(id, "textured");
     RGSS_LogDebug("Successfully compiled and linked particle shader");
 
-    glGenVertexArrays(1, RGSS_BLIT_VAO);
+    RGSS_Program_Finish(&blit);
+    id = blit.id;
+    RGSS_GRAPHICS.blit_shader.id = id;
+    RGSS_GRAPHICS.blit_shader.target_size = glGetUniformLocation(id, "target_size");
+    RGSS_GRAPHICS.blit_shader.textured = glGetUniformLocation(id, "textured");
+    RGSS_LogDebug("Successfully compiled and linked blit shader");
+
+    RGSS_Program_Finish(&text);
+    id = text.id;
+    RGSS_GRAPHICS.text_shader.id = id;
+    RGSS_GRAPHICS.text_shader.model = glGetUniformLocation(id, "model");
+    RGSS_GRAPHICS.text_shader.color = glGetUniformLocation(id, "color");
+    RGSS_GRAPHICS.text_shader.tone = glGetUniformLocation(id, "tone");
+    RGSS_GRAPHICS.text_shader.flash = glGetUniformLocation(id, "flash");
+    RGSS_GRAPHICS.text_shader.hue = glGetUniformLocation(id, "hue");
+    RGSS_GRAPHICS.text_shader.opacity = glGetUniformLocation(id, "opacity");
+    RGSS_GRAPHICS.text_shader.reveal = glGetUniformLocation(id, "reveal");
+    RGSS_GRAPHICS.text_shader.reveal_fade = glGetUniformLocation(id, "reveal_fade");
+    RGSS_LogDebug("Successfully compiled and linked text shader");
+
+    RGSS_Program_Finish(&sdf);
+    id = sdf.id;
+    RGSS_GRAPHICS.sdf_shader.id = id;
+    RGSS_GRAPHICS.sdf_shader.model = glGetUniformLocation(id, "model");
+    RGSS_GRAPHICS.sdf_shader.color = glGetUniformLocation(id, "color");
+    RGSS_GRAPHICS.sdf_shader.tone = glGetUniformLocation(id, "tone");
+    RGSS_GRAPHICS.sdf_shader.flash = glGetUniformLocation(id, "flash");
+    RGSS_GRAPHICS.sdf_shader.hue = glGetUniformLocation(id, "hue");
+    RGSS_GRAPHICS.sdf_shader.opacity = glGetUniformLocation(id, "opacity");
+    RGSS_GRAPHICS.sdf_shader.reveal = glGetUniformLocation(id, "reveal");
+    RGSS_GRAPHICS.sdf_shader.reveal_fade = glGetUniformLocation(id, "reveal_fade");
+    RGSS_GRAPHICS.sdf_shader.spread = glGetUniformLocation(id, "spread");
+    RGSS_GRAPHICS.sdf_shader.outline_color = glGetUniformLocation(id, "outline_color");
+    RGSS_GRAPHICS.sdf_shader.outline_width = glGetUniformLocation(id, "outline_width");
+    RGSS_GRAPHICS.sdf_shader.shadow_color = glGetUniformLocation(id, "shadow_color");
+    RGSS_GRAPHICS.sdf_shader.shadow_offset = glGetUniformLocation(id, "shadow_offset");
+    RGSS_LogDebug("Successfully compiled and linked distance field text shader");
+
+    glGenVertexArrays(1, &RGSS_BLIT_VAO);
     glBindVertexArray(RGSS_BLIT_VAO);
 
     glGenBuffers(1, &RGSS_BLIT_VBO);
     glBindBuffer(GL_ARRAY_BUFFER, RGSS_BLIT_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(RGSS_QUAD_VERTICES), NULL, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(RGSS_QUAD_VERTICES), RGSS_QUAD_VERTICES, GL_STATIC_DRAW);
 
     glGenBuffers(1, &RGSS_BLIT_EBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, RGSS_BLIT_EBO);
@@ -513,6 +646,15 @@ void RGSS_Graphics_Init(GLFWwindow *window, int width, int height, int vsync)
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, SIZEOF_FLOAT * 4, NULL);
+
+    // Per-instance attributes are sourced from the pending commands, the offsets are set when flushing
+    glGenBuffers(1, &RGSS_BLIT_INSTANCES);
+    glBindBuffer(GL_ARRAY_BUFFER, RGSS_BLIT_INSTANCES);
+    for (GLuint i = 1; i <= 3; i++)
+    {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
     glBindVertexArray(GL_NONE);
     glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -525,13 +667,19 @@ void RGSS_Graphics_Deinit(GLFWwindow *window)
     if (RGSS_GRAPHICS.projection)
         free(RGSS_GRAPHICS.projection);
     glDeleteBuffers(1, &RGSS_GRAPHICS.ubo);
+    glDeleteBuffers(1, &RGSS_BLIT_INSTANCES);
+    RGSS_Transition_Deinit();
+    RGSS_Glyph_Deinit();
+    RGSS_Sampler_Deinit();
+    RGSS_Program_Deinit();
 
     // TODO: Iterate and destroy children
     vec_deinit(&RGSS_GRAPHICS.batch.items);
 }
 
-void RGSS_Graphics_Render(double alpha)
+void RGSS_Graphics_RenderScene(double alpha)
 {
+    RGSS_Texture_FlushAll();
     glClear(GL_COLOR_BUFFER_BIT);
 
     if (RGSS_GRAPHICS.batch.invalid)
@@ -547,6 +695,12 @@ void RGSS_Graphics_Render(double alpha)
     {
         rb_funcall2(obj, RGSS_ID_RENDER, 1, &n);
     }
+}
+
+void RGSS_Graphics_Render(double alpha)
+{
+    if (!RGSS_Transition_DrawFrozen())
+        RGSS_Graphics_RenderScene(alpha);
 
     RGSS_GAME.time.fps_count++;
     RGSS_GAME.time.total_frames++;
@@ -646,7 +800,11 @@ void RGSS_Init_Graphics(VALUE parent)
     rb_define_method2(rb_cShader, "uniform", RGSS_Shader_SetUniform, 2);
     rb_define_method0(rb_cShader, "disposed", RGSS_Shader_Dispose, 0);
     rb_define_method0(rb_cShader, "disposed?", RGSS_Shader_IsDisposed, 0);
+    rb_define_method0(rb_cShader, "ready?", RGSS_Shader_IsReady, 0);
     rb_define_method1(rb_cShader, "locate", RGSS_Shader_Locate, 1);
+    rb_define_method0(rb_cShader, "uniforms", RGSS_Shader_GetUniforms, 0);
+    rb_define_method1(rb_cShader, "set", RGSS_Shader_Set, 1);
+    rb_define_method2(rb_cShader, "[]=", RGSS_Shader_Store, 2);
     rb_include_module(rb_cShader, rb_mGL);
 
     rb_define_singleton_methodm1(rb_cShader, "load", RGSS_Shader_Load, -1);
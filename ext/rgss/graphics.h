@@ -10,11 +10,20 @@ typedef struct RGSS_Renderable RGSS_Renderable;
 extern GLuint RGSS_BLIT_VAO;
 extern GLuint RGSS_BLIT_VBO;
 extern GLuint RGSS_BLIT_EBO;
+extern GLuint RGSS_BLIT_INSTANCES;
 
 #define RGSS_GRAPHICS RGSS_GAME.graphics
 
+typedef struct RGSS_Uniform RGSS_Uniform;
+
 typedef struct {
-    GLuint id;
+    GLuint id;              /** The name of the OpenGL program. */
+    GLuint stages[3];       /** The shader units attached to the program while it is linking. */
+    uint64_t key;           /** The key the program is cached with once linked. */
+    int pending;            /** Flag indicating if the program has been linked, but its status not yet checked. */
+    RGSS_Uniform *uniforms; /** The active uniforms of the program, filled in when first looked up. */
+    int reflected;          /** Flag indicating if the active uniforms have been queried. */
+    int dirty;              /** The number of uniform values waiting to be applied when the program is next used. */
 } RGSS_Shader;
 
 /**
@@ -103,6 +112,123 @@ GLuint RGSS_CreateProgramFromSource(const char *vert_src, const char *frag_src,
  */
 GLuint RGSS_CreateProgramFromFile(const char *vert_path, const char *frag_path, const char *geom_path);
 
+/**
+ * @brief Initializes program creation once a context is current, detecting driver support for parallel compilation
+ * and program binaries, and identifying the driver cached binaries are valid for.
+ */
+void RGSS_Program_Init(void);
+
+/**
+ * @brief Logs the number of programs that were loaded from and missed the cache.
+ */
+void RGSS_Program_Deinit(void);
+
+/**
+ * @brief Starts creating a program from source, either from a cached binary or by compiling and linking it, without
+ * waiting for the driver to finish. Errors are reported by @ref RGSS_Program_Finish.
+ * @param[out] shader The shader to initialize.
+ * @param[in] vert_src The GLSL source code for the vertex shader.
+ * @param[in] frag_src The GLSL source code for the fragment shader.
+ * @param[in] geom_src The GLSL source code for the geometry shader, or @c NULL to not use this unit.
+ */
+void RGSS_Program_Begin(RGSS_Shader *shader, const char *vert_src, const char *frag_src, const char *geom_src);
+
+/**
+ * @brief Waits for a program started with @ref RGSS_Program_Begin to finish linking, raising a Ruby exception with
+ * the compile and link logs on failure. Does nothing if the program is already complete.
+ * @param[in] shader The shader to complete.
+ */
+void RGSS_Program_Finish(RGSS_Shader *shader);
+
+/**
+ * @brief Retrieves a value indicating if a program can be completed without waiting on the driver.
+ * @param[in] shader The shader to query.
+ * @return @c true if the program is complete or the driver has finished with it, otherwise @c false. Always @c true
+ * when the driver does not support @c GL_KHR_parallel_shader_compile.
+ */
+int RGSS_Program_IsReady(RGSS_Shader *shader);
+
+/**
+ * @brief Deletes a program and any shader units still attached to it.
+ * @param[in] shader The shader to delete.
+ */
+void RGSS_Program_Delete(RGSS_Shader *shader);
+
+/**
+ * @brief Retrieves the location of a uniform, from a table of the program's active uniforms built when first needed.
+ * @param[in] shader A complete shader.
+ * @param[in] name The name of the uniform.
+ * @return The location of the uniform, or @c -1 if the program has no active uniform with the name.
+ */
+GLint RGSS_Program_Locate(RGSS_Shader *shader, const char *name);
+
+/**
+ * @brief Stores a value to be applied to a uniform the next time the program is used, converting it according to
+ * the type the uniform is declared with. Values for uniforms that are not active are ignored.
+ *
+ * Scalars, samplers, float and integer vectors, and float matrices up to 4x4 are supported. Types without a matching
+ * class, such as @c mat3 or @c uvec4, are given as an Array of their components in column-major order.
+ * @param[in] shader A complete shader.
+ * @param[in] name The name of the uniform.
+ * @param[in] value A Ruby value compatible with the uniform type.
+ */
+void RGSS_Program_Set(RGSS_Shader *shader, const char *name, VALUE value);
+
+/**
+ * @brief Creates a Ruby Hash of the active uniforms of a program, mapping their names to their OpenGL types.
+ * @param[in] shader A complete shader.
+ * @return The Hash of uniforms.
+ */
+VALUE RGSS_Program_Uniforms(RGSS_Shader *shader);
+
+/**
+ * @brief Frees the table of active uniforms and any values waiting to be applied.
+ * @param[in] shader The shader to free the uniforms of.
+ */
+void RGSS_Program_FreeUniforms(RGSS_Shader *shader);
+
+/**
+ * @brief Completes a program if required, makes it current, and applies any uniform values stored since it was last
+ * used.
+ * @param[in] shader The shader to use.
+ */
+void RGSS_Program_Use(RGSS_Shader *shader);
+
+/**
+ * @brief Binds the uniform blocks shared by all programs to their binding points.
+ * @param[in] program The name of a linked OpenGL program.
+ */
+void RGSS_Program_BindBlocks(GLuint program);
+
+/**
+ * @brief Retrieves a value indicating if linked programs are stored to and loaded from the cache directory.
+ * @return @c true if the cache is enabled and supported by the driver, otherwise @c false.
+ */
+int RGSS_Program_CacheEnabled(void);
+
+/**
+ * @brief Computes the key a program is cached with, from its sources and the current driver.
+ * @param[in] vert_src The GLSL source code for the vertex shader.
+ * @param[in] frag_src The GLSL source code for the fragment shader.
+ * @param[in] geom_src The GLSL source code for the geometry shader, or @c NULL if not used.
+ * @return The cache key.
+ */
+uint64_t RGSS_Program_CacheKey(const char *vert_src, const char *frag_src, const char *geom_src);
+
+/**
+ * @brief Creates a program from a cached binary. Binaries rejected by the driver are removed from the cache.
+ * @param[in] key The key the program was stored with.
+ * @return The OpenGL program name, or @c GL_NONE if not cached and the program must be compiled from source.
+ */
+GLuint RGSS_Program_CacheLoad(uint64_t key);
+
+/**
+ * @brief Stores the binary of a successfully linked program in the cache.
+ * @param[in] key The key to store the program with.
+ * @param[in] program The name of an OpenGL program, linked with @c GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+ */
+void RGSS_Program_CacheStore(uint64_t key, GLuint program);
+
 /**
  * @brief Initiializes the base enitity object for structures that utilize it.
  * 
@@ -1,4 +1,9 @@
 #include "graphics.h"
+#include "parallel.h"
+#include "pixels.h"
+#include "png.h"
+#include <ruby/thread.h>
+#include <ruby/util.h>
 
 VALUE rb_cImage;
 
@@ -27,6 +32,22 @@ VALUE rb_cImage;
 #define BYTES_PER_PIXEL 4
 #define COMPONENT_COUNT 4
 
+// The number of rows processed at a time by a worker, roughly 16K pixels
+#define RGSS_IMAGE_GRAIN(width) RGSS_MAX(1, 16384 / (width))
+
+#define RGSS_ASSERT_IMAGE(image)                                                                                       \
+    if ((image)->pixels == NULL)                                                                                       \
+    rb_raise(rb_eRuntimeError, "disposed image")
+
+// Images written to without the GVL cannot be used by other threads, and those read from cannot be written to
+#define RGSS_ASSERT_IDLE(image)                                                                                        \
+    if ((image)->busy != 0)                                                                                            \
+    rb_raise(rb_eRuntimeError, "image is in use by another thread")
+
+#define RGSS_ASSERT_READABLE(image)                                                                                    \
+    if ((image)->busy < 0)                                                                                             \
+    rb_raise(rb_eRuntimeError, "image is in use by another thread")
+
 static void RGSS_Image_Free(void *img)
 {
     if (img)
@@ -42,7 +63,7 @@ int RGSS_Image_SavePNG(const char *filename, int width, int height, unsigned cha
 {
     RUBY_ASSERT_MESG(filename != NULL, "invalid filename specified");
     RGSS_SizeNotEmpty(width, height);
-    return stbi_write_png(filename, width, height, COMPONENT_COUNT, pixels, width * COMPONENT_COUNT);
+    return RGSS_PNG_Write(filename, pixels, width, height, RGSS_PNG_LEVEL_DEFAULT);
 }
 
 int RGSS_Image_SaveJPG(const char *filename, int width, int height, unsigned char *pixels, int quality)
@@ -63,22 +84,32 @@ VALUE RGSS_Image_New(int width, int height, unsigned char *pixels)
     img->width = width;
     img->height = height;
     img->pixels = pixels;
+    img->busy = 0;
     return Data_Wrap_Struct(rb_cImage, NULL, RGSS_Image_Free, img);
 }
 
 VALUE RGSS_Image_NewFromFile(const char *path)
 {
     RGSS_Image *img = ALLOC(RGSS_Image);
+    img->busy = 0;
     RGSS_Image_Load(path, &img->width, &img->height, &img->pixels);
     return Data_Wrap_Struct(rb_cImage, NULL, RGSS_Image_Free, img);
 }
 
 void RGSS_Image_Load(const char *path, int *width, int *height, unsigned char **pixels)
 {
-    // TODO: Confirm path
-
-    *pixels = stbi_load(path, width, height, NULL, COMPONENT_COUNT);
-    if (pixels == NULL)
+    // Images stored uncompressed in an archive are decoded straight from the mapped file
+    RGSS_Resource resource;
+    if (RGSS_Archive_Find(path, &resource))
+    {
+        *pixels = stbi_load_from_memory(resource.data, (int)resource.size, width, height, NULL, COMPONENT_COUNT);
+        RGSS_Resource_Free(&resource);
+    }
+    else
+    {
+        *pixels = stbi_load(path, width, height, NULL, COMPONENT_COUNT);
+    }
+    if (*pixels == NULL)
         rb_raise(rb_eRGSSError, "failed to load image");
 }
 
@@ -115,6 +146,7 @@ static VALUE RGSS_Image_GetPixels(VALUE self)
 static VALUE RGSS_Image_Dispose(VALUE self)
 {
     RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IDLE(image);
     if (image->pixels)
     {
         xfree(image->pixels);
@@ -135,6 +167,7 @@ static VALUE RGSS_Image_Initialize(int argc, VALUE *argv, VALUE self)
     rb_scan_args(argc, argv, "12", &x, &y, &blob);
 
     RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IDLE(image);
 
     switch (argc)
     {
@@ -183,59 +216,615 @@ static VALUE RGSS_Image_GetAddress(VALUE self)
 
 
 
-static VALUE RGSS_Image_Save(int argc, VALUE *argv, VALUE self)
+/**
+ * @brief A kernel run over the rows of images without the GVL, while other Ruby threads may use them.
+ */
+typedef struct
+{
+    RGSS_Image *target;     /** The image modified in place, or @c NULL. */
+    RGSS_Image *source;     /** The image read from, or @c NULL. */
+    int count;              /** The number of rows. */
+    int grain;              /** The fewest rows processed at a time by a worker. */
+    RGSS_ParallelFunc func; /** The kernel. */
+    void *data;             /** The user data passed to the kernel. */
+} RGSS_ImageTask;
+
+static VALUE RGSS_Image_TaskRun(VALUE value)
+{
+    RGSS_ImageTask *task = (RGSS_ImageTask *)value;
+    RGSS_Parallel_ForNoGVL(task->count, task->grain, task->func, task->data);
+    return Qnil;
+}
+
+static VALUE RGSS_Image_TaskDone(VALUE value)
+{
+    RGSS_ImageTask *task = (RGSS_ImageTask *)value;
+    if (task->target)
+        task->target->busy = 0;
+    if (task->source)
+        task->source->busy--;
+    return Qnil;
+}
+
+/**
+ * @brief Runs a kernel over the rows of images without the GVL. The images are marked busy until it returns, which
+ * prevents other threads from disposing them or writing to them meanwhile.
+ * @param[in] target The image modified in place, or @c NULL.
+ * @param[in] source The image read from, or @c NULL. Must not be the same as @p target.
+ * @param[in] count The number of rows.
+ * @param[in] grain The fewest rows processed at a time by a worker.
+ * @param[in] func The kernel.
+ * @param[in] data The user data passed to the kernel.
+ */
+static void RGSS_Image_Run(RGSS_Image *target, RGSS_Image *source, int count, int grain, RGSS_ParallelFunc func,
+                           void *data)
+{
+    if (target)
+        RGSS_ASSERT_IDLE(target);
+    if (source)
+        RGSS_ASSERT_READABLE(source);
+
+    RGSS_ImageTask task = {target, source, count, grain, func, data};
+    if (target)
+        target->busy = -1;
+    if (source)
+        source->busy++;
+    rb_ensure(RGSS_Image_TaskRun, (VALUE)&task, RGSS_Image_TaskDone, (VALUE)&task);
+}
+
+typedef enum
+{
+    RGSS_IMAGE_FORMAT_PNG,
+    RGSS_IMAGE_FORMAT_JPG,
+    RGSS_IMAGE_FORMAT_BMP
+} RGSS_ImageFormat;
+
+typedef struct
+{
+    char *path;              /** The path of the file to write. */
+    unsigned char *pixels;   /** The pixels to encode. */
+    unsigned char *buffer;   /** A copy of the pixels owned by the request, or @c NULL. */
+    int width;               /** The width of the image, in pixels. */
+    int height;              /** The height of the image, in pixels. */
+    RGSS_ImageFormat format; /** The format to encode as. */
+    int level;               /** The PNG compression level, or the JPG quality. */
+    int result;              /** Flag indicating if the image was written successfully. */
+} RGSS_ImageSave;
+
+static void RGSS_Image_ParseSave(int argc, VALUE *argv, VALUE self, int copy, RGSS_ImageSave *save)
 {
     VALUE path, format, opts;
     rb_scan_args(argc, argv, "11:", &path, &format, &opts);
 
     RGSS_Image *image = DATA_PTR(self);
-    if (image->pixels == NULL)
-        rb_raise(rb_eRuntimeError, "disposed image");
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_ASSERT_READABLE(image);
 
     VALUE type = RTEST(format) ? format : STR2SYM("png");
-
-    int result;
-    int flip = RTEST(opts) && RTEST(rb_hash_aref(opts, STR2SYM("flip")));
-    stbi_flip_vertically_on_write(flip);
     const char *file = StringValueCStr(path);
 
     if (type == STR2SYM("png"))
     {
-        stbi_write_png_compression_level = 8;
+        save->format = RGSS_IMAGE_FORMAT_PNG;
+        save->level = RGSS_PNG_LEVEL_DEFAULT;
         if (RTEST(opts))
         {
             VALUE cmp = rb_hash_aref(opts, STR2SYM("compression"));
             if (RTEST(cmp))
-                stbi_write_png_compression_level = RGSS_MAX(0, RGSS_MIN(9, NUM2INT(cmp)));
+                save->level = RGSS_MAX(0, RGSS_MIN(9, NUM2INT(cmp)));
+            if (RTEST(rb_hash_aref(opts, STR2SYM("fast"))))
+                save->level = RGSS_PNG_LEVEL_FAST;
         }
-
-        int stride = image->width * BYTES_PER_PIXEL;
-        result = stbi_write_png(file, image->width, image->height, COMPONENT_COUNT, image->pixels, stride);
     }
     else if (type == STR2SYM("jpg") || type == STR2SYM("jpeg"))
     {
-        int quality = JPEG_QUALITY;
+        save->format = RGSS_IMAGE_FORMAT_JPG;
+        save->level = JPEG_QUALITY;
         if (RTEST(opts))
         {
             VALUE q = rb_hash_aref(opts, STR2SYM("quality"));
             if (RTEST(q))
-                quality = RGSS_MAX(0, RGSS_MIN(100, NUM2INT(q)));
+                save->level = RGSS_MAX(0, RGSS_MIN(100, NUM2INT(q)));
         }
-
-        result = stbi_write_jpg(file, image->width, image->height, COMPONENT_COUNT, image->pixels, quality);
     }
     else if (type == STR2SYM("bmp"))
     {
-        result = stbi_write_bmp(file, image->width, image->height, COMPONENT_COUNT, image->pixels);
+        save->format = RGSS_IMAGE_FORMAT_BMP;
     }
     else
     {
         rb_raise(rb_eArgError, "invalid image format specified");
     }
 
-    if (!result)
+    save->width = image->width;
+    save->height = image->height;
+    save->pixels = image->pixels;
+
+    // Flipping is done on a copy rather than with the global flag of stb, which is not safe to use across threads
+    int flip = RTEST(opts) && RTEST(rb_hash_aref(opts, STR2SYM("flip")));
+    if (flip || copy)
+    {
+        size_t stride = (size_t)image->width * BYTES_PER_PIXEL;
+        save->buffer = xmalloc(stride * image->height);
+        for (int y = 0; y < image->height; y++)
+            memcpy(save->buffer + stride * y, image->pixels + stride * (flip ? image->height - 1 - y : y), stride);
+        save->pixels = save->buffer;
+    }
+    save->path = ruby_strdup(file);
+}
+
+static void *RGSS_Image_Write(void *data)
+{
+    RGSS_ImageSave *save = data;
+    switch (save->format)
+    {
+        case RGSS_IMAGE_FORMAT_PNG:
+            save->result = RGSS_PNG_Write(save->path, save->pixels, save->width, save->height, save->level);
+            break;
+        case RGSS_IMAGE_FORMAT_JPG:
+            save->result =
+                stbi_write_jpg(save->path, save->width, save->height, COMPONENT_COUNT, save->pixels, save->level);
+            break;
+        default:
+            save->result = stbi_write_bmp(save->path, save->width, save->height, COMPONENT_COUNT, save->pixels);
+            break;
+    }
+    return NULL;
+}
+
+static void RGSS_Image_WriteRows(void *data, int start, int end)
+{
+    RGSS_Image_Write(data);
+}
+
+static void RGSS_Image_SaveFree(void *data)
+{
+    RGSS_ImageSave *save = data;
+    if (save->path)
+        xfree(save->path);
+    if (save->buffer)
+        xfree(save->buffer);
+    xfree(save);
+}
+
+static VALUE RGSS_Image_Save(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_ImageSave save = {0};
+    RGSS_Image_ParseSave(argc, argv, self, false, &save);
+
+    // The pixels may not have been copied, so the image is written as a task of a single row
+    RGSS_Image_Run(NULL, DATA_PTR(self), 1, 1, RGSS_Image_WriteRows, &save);
+    if (save.path)
+        xfree(save.path);
+    if (save.buffer)
+        xfree(save.buffer);
+
+    if (!save.result)
         rb_raise(rb_eRuntimeError, "failed to save image");
+    return self;
+}
+
+static VALUE RGSS_Image_SaveThread(RB_BLOCK_CALL_FUNC_ARGLIST(yielded, data))
+{
+    // The request and callback are given as the arguments of Thread.new, which keeps them referenced
+    RGSS_ImageSave *save = DATA_PTR(argv[0]);
+    VALUE callback = argv[1];
+
+    rb_thread_call_without_gvl(RGSS_Image_Write, save, NULL, NULL);
+    VALUE result = RB_BOOL(save->result);
+
+    if (save->buffer)
+    {
+        xfree(save->buffer);
+        save->buffer = NULL;
+    }
+    if (!NIL_P(callback))
+        rb_proc_call(callback, rb_ary_new_from_values(1, &result));
+    return result;
+}
+
+static VALUE RGSS_Image_SaveAsync(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_ImageSave *save = ALLOC(RGSS_ImageSave);
+    memset(save, 0, sizeof(RGSS_ImageSave));
+    VALUE job = Data_Wrap_Struct(rb_cObject, NULL, RGSS_Image_SaveFree, save);
+
+    // The pixels are copied, so the image may be modified or disposed while it is being saved
+    RGSS_Image_ParseSave(argc, argv, self, true, save);
+
+    VALUE args[2] = {job, rb_block_given_p() ? rb_block_proc() : Qnil};
+    return rb_block_call(rb_cThread, rb_intern("new"), 2, args, RGSS_Image_SaveThread, Qnil);
+}
+
+static RGSS_Image *RGSS_Image_Get(VALUE value)
+{
+    if (rb_obj_is_kind_of(value, rb_cImage) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not an Image", CLASS_NAME(value));
+    RGSS_Image *image = DATA_PTR(value);
+    RGSS_ASSERT_IMAGE(image);
+    return image;
+}
+
+static RGSS_Filter RGSS_Image_ParseFilter(VALUE filter)
+{
+    if (NIL_P(filter) || filter == STR2SYM("bilinear"))
+        return RGSS_FILTER_BILINEAR;
+    if (filter == STR2SYM("box"))
+        return RGSS_FILTER_BOX;
+    if (filter == STR2SYM("lanczos"))
+        return RGSS_FILTER_LANCZOS;
+    rb_raise(rb_eArgError, "invalid filter specified (expected :box, :bilinear, or :lanczos)");
+}
+
+typedef struct
+{
+    const uint32_t *src;
+    uint32_t *dst;
+    int src_width;
+    int dst_width;
+    RGSS_Resampler horizontal;
+    RGSS_Resampler vertical;
+    int failed;
+} RGSS_ImageResize;
+
+static void RGSS_Image_ResizeRows(void *data, int start, int end)
+{
+    // Each chunk of output rows resizes only the input rows it needs, so no full-size intermediate is required
+    RGSS_ImageResize *job = data;
+    RGSS_Resampler *v = &job->vertical;
+    int lo = v->first[start], hi = lo;
+    for (int y = start; y < end; y++)
+        hi = RGSS_MAX(hi, v->first[y] + v->count[y]);
+
+    size_t stride = (size_t)job->dst_width * 4;
+    float *rows = malloc((hi - lo) * stride * sizeof(float) + 1);
+    float *scratch = malloc(job->src_width * 4 * sizeof(float));
+    if (rows && scratch)
+    {
+        for (int y = lo; y < hi; y++)
+            RGSS_Pixels_ResampleRow(&job->horizontal, job->src + (size_t)y * job->src_width, job->src_width,
+                                    job->dst_width, scratch, rows + (y - lo) * stride);
+        for (int y = start; y < end; y++)
+            RGSS_Pixels_ResampleColumns(v, y, rows + (v->first[y] - lo) * stride, job->dst_width,
+                                        job->dst + (size_t)y * job->dst_width);
+    }
+    else
+    {
+        __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+    }
+    free(rows);
+    free(scratch);
+}
+
+static VALUE RGSS_Image_Resize(int argc, VALUE *argv, VALUE self)
+{
+    VALUE width, height, filter;
+    rb_scan_args(argc, argv, "21", &width, &height, &filter);
+
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_ASSERT_READABLE(image);
+
+    int w = NUM2INT(width), h = NUM2INT(height);
+    RGSS_SizeNotEmpty(w, h);
+    RGSS_Filter mode = RGSS_Image_ParseFilter(filter);
+
+    RGSS_ImageResize job = {(uint32_t *)image->pixels, NULL, image->width, w};
+    if (!RGSS_Resampler_Init(&job.horizontal, image->width, w, mode) ||
+        !RGSS_Resampler_Init(&job.vertical, image->height, h, mode))
+    {
+        RGSS_Resampler_Free(&job.horizontal);
+        rb_raise(rb_eNoMemError, "out of memory");
+    }
+
+    job.dst = xmalloc((size_t)w * h * BYTES_PER_PIXEL);
+    RGSS_Image_Run(NULL, image, h, RGSS_MAX(RGSS_IMAGE_GRAIN(w), job.vertical.taps), RGSS_Image_ResizeRows, &job);
+    RGSS_Resampler_Free(&job.horizontal);
+    RGSS_Resampler_Free(&job.vertical);
+
+    if (job.failed)
+    {
+        xfree(job.dst);
+        rb_raise(rb_eNoMemError, "out of memory");
+    }
+    return RGSS_Image_New(w, h, (unsigned char *)job.dst);
+}
+
+typedef struct
+{
+    uint32_t *dst;
+    const uint32_t *src;
+    int dst_stride;
+    int src_stride;
+    int width;
+    int opacity;
+} RGSS_ImageCopy;
+
+static void RGSS_Image_CopyRows(void *data, int start, int end)
+{
+    RGSS_ImageCopy *job = data;
+    for (int y = start; y < end; y++)
+        memcpy(job->dst + (size_t)y * job->dst_stride, job->src + (size_t)y * job->src_stride,
+               job->width * sizeof(uint32_t));
+}
 
+static void RGSS_Image_BlendRows(void *data, int start, int end)
+{
+    RGSS_ImageCopy *job = data;
+    for (int y = start; y < end; y++)
+        RGSS_Pixels_BlendRow(job->dst + (size_t)y * job->dst_stride, job->src + (size_t)y * job->src_stride,
+                             job->width, job->opacity);
+}
+
+static void RGSS_Image_ParseRect(int argc, VALUE *argv, RGSS_Rect *rect)
+{
+    if (argc == 1 && rb_obj_is_kind_of(argv[0], rb_cRect) == Qtrue)
+        memcpy(rect, DATA_PTR(argv[0]), sizeof(RGSS_Rect));
+    else if (argc == 4)
+        *rect = (RGSS_Rect){NUM2INT(argv[0]), NUM2INT(argv[1]), NUM2INT(argv[2]), NUM2INT(argv[3])};
+    else
+        rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 1 or 4)", argc);
+}
+
+static int RGSS_Image_Clip(RGSS_Image *image, RGSS_Rect *rect)
+{
+    int x1 = RGSS_MIN(rect->x + rect->width, image->width);
+    int y1 = RGSS_MIN(rect->y + rect->height, image->height);
+    rect->x = RGSS_MAX(rect->x, 0);
+    rect->y = RGSS_MAX(rect->y, 0);
+    rect->width = x1 - rect->x;
+    rect->height = y1 - rect->y;
+    return rect->width > 0 && rect->height > 0;
+}
+
+static VALUE RGSS_Image_Crop(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_ASSERT_READABLE(image);
+
+    RGSS_Rect rect;
+    RGSS_Image_ParseRect(argc, argv, &rect);
+    if (!RGSS_Image_Clip(image, &rect))
+        rb_raise(rb_eArgError, "crop area does not intersect the image");
+
+    uint32_t *pixels = xmalloc((size_t)rect.width * rect.height * BYTES_PER_PIXEL);
+    RGSS_ImageCopy job = {pixels, (uint32_t *)image->pixels + (size_t)rect.y * image->width + rect.x, rect.width,
+                          image->width, rect.width, 255};
+    RGSS_Image_Run(NULL, image, rect.height, RGSS_IMAGE_GRAIN(rect.width), RGSS_Image_CopyRows, &job);
+    return RGSS_Image_New(rect.width, rect.height, (unsigned char *)pixels);
+}
+
+static VALUE RGSS_Image_Blit(int argc, VALUE *argv, VALUE self)
+{
+    VALUE x, y, source, src_rect, opacity;
+    rb_scan_args(argc, argv, "32", &x, &y, &source, &src_rect, &opacity);
+
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_ASSERT_IDLE(image);
+    RGSS_Image *src = RGSS_Image_Get(source);
+    RGSS_ASSERT_READABLE(src);
+
+    RGSS_Rect area = {0, 0, src->width, src->height};
+    if (!NIL_P(src_rect))
+        RGSS_Image_ParseRect(1, &src_rect, &area);
+    // Opacity is a float from 0.0 to 1.0, the same as Texture#blit
+    int alpha = NIL_P(opacity) ? 255 : (int)roundf(glm_clamp(NUM2FLT(opacity), 0.0f, 1.0f) * 255.0f);
+
+    // Clip the source to its bounds, then the destination to its bounds, adjusting the other to match
+    RGSS_Rect dst = {NUM2INT(x) + RGSS_MAX(0, -area.x), NUM2INT(y) + RGSS_MAX(0, -area.y)};
+    if (!RGSS_Image_Clip(src, &area))
+        return self;
+    dst.size = area.size;
+    int dx = dst.x, dy = dst.y;
+    if (!RGSS_Image_Clip(image, &dst))
+        return self;
+    area.x += dst.x - dx;
+    area.y += dst.y - dy;
+
+    // Rows are blended in parallel, so blitting an image onto itself requires a copy of the source
+    const uint32_t *pixels = (uint32_t *)src->pixels + (size_t)area.y * src->width + area.x;
+    int stride = src->width;
+    uint32_t *copy = NULL;
+    if (src == image)
+    {
+        copy = xmalloc((size_t)dst.width * dst.height * BYTES_PER_PIXEL);
+        RGSS_ImageCopy job = {copy, pixels, dst.width, stride, dst.width, 255};
+        RGSS_Image_CopyRows(&job, 0, dst.height);
+        pixels = copy;
+        stride = dst.width;
+    }
+
+    uint32_t *target = (uint32_t *)image->pixels + (size_t)dst.y * image->width + dst.x;
+    RGSS_ImageCopy job = {target, pixels, image->width, stride, dst.width, alpha};
+    RGSS_Image_Run(image, copy ? NULL : src, dst.height, RGSS_IMAGE_GRAIN(dst.width), RGSS_Image_BlendRows, &job);
+
+    if (copy)
+        xfree(copy);
+    return self;
+}
+
+typedef struct
+{
+    RGSS_Image *image;
+    int flip;
+} RGSS_ImageFlip;
+
+static void RGSS_Image_FlipRows(void *data, int start, int end)
+{
+    RGSS_ImageFlip *job = data;
+    int w = job->image->width, h = job->image->height;
+    uint32_t *pixels = (uint32_t *)job->image->pixels;
+
+    for (int y = start; y < end; y++)
+    {
+        uint32_t *row = pixels + (size_t)y * w;
+        if (!RGSS_HAS_FLAG(job->flip, RGSS_FLIP_Y))
+        {
+            RGSS_Pixels_Reverse(row, w);
+            continue;
+        }
+
+        // Only the top half of rows are iterated, each swapped with its mirror in the bottom half, then both are
+        // reversed. The middle row of an odd height is its own mirror, and is only reversed once.
+        uint32_t *mirror = pixels + (size_t)(h - 1 - y) * w;
+        if (row != mirror)
+        {
+            for (int x = 0; x < w; x++)
+            {
+                uint32_t swap = row[x];
+                row[x] = mirror[x];
+                mirror[x] = swap;
+            }
+        }
+        if (RGSS_HAS_FLAG(job->flip, RGSS_FLIP_X))
+        {
+            RGSS_Pixels_Reverse(row, w);
+            if (row != mirror)
+                RGSS_Pixels_Reverse(mirror, w);
+        }
+    }
+}
+
+static VALUE RGSS_Image_Flip(VALUE self, VALUE flip)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+
+    RGSS_ImageFlip job = {image, NUM2INT(flip) & RGSS_FLIP_BOTH};
+    if (job.flip == RGSS_FLIP_NONE)
+        return self;
+
+    int rows = RGSS_HAS_FLAG(job.flip, RGSS_FLIP_Y) ? (image->height + 1) / 2 : image->height;
+    RGSS_Image_Run(image, NULL, rows, RGSS_IMAGE_GRAIN(image->width), RGSS_Image_FlipRows, &job);
+    return self;
+}
+
+typedef struct
+{
+    const uint32_t *src;
+    uint32_t *dst;
+    int width;  /** The width of the source. */
+    int height; /** The height of the source. */
+    int turns;  /** The number of clockwise quarter turns. */
+} RGSS_ImageRotate;
+
+static void RGSS_Image_RotateRows(void *data, int start, int end)
+{
+    RGSS_ImageRotate *job = data;
+    const int w = job->width, h = job->height, dw = (job->turns == 2) ? w : h;
+    const int tile = 32;
+
+    // Columns are processed in tiles, so the source rows being read from stay in cache
+    for (int x0 = 0; x0 < dw; x0 += tile)
+    {
+        int x1 = RGSS_MIN(x0 + tile, dw);
+        for (int y = start; y < end; y++)
+        {
+            uint32_t *row = job->dst + (size_t)y * dw;
+            for (int x = x0; x < x1; x++)
+            {
+                switch (job->turns)
+                {
+                    case 1: row[x] = job->src[(size_t)(h - 1 - x) * w + y]; break;
+                    case 2: row[x] = job->src[(size_t)(h - 1 - y) * w + (w - 1 - x)]; break;
+                    default: row[x] = job->src[(size_t)x * w + (w - 1 - y)]; break;
+                }
+            }
+        }
+    }
+}
+
+static VALUE RGSS_Image_Rotate(VALUE self, VALUE degrees)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_ASSERT_READABLE(image);
+
+    int angle = NUM2INT(degrees);
+    if (angle % 90 != 0)
+        rb_raise(rb_eArgError, "angle must be a multiple of 90 degrees");
+
+    int turns = ((angle / 90) % 4 + 4) % 4;
+    size_t size = (size_t)image->width * image->height * BYTES_PER_PIXEL;
+    uint32_t *pixels = xmalloc(size);
+    if (turns == 0)
+    {
+        memcpy(pixels, image->pixels, size);
+        return RGSS_Image_New(image->width, image->height, (unsigned char *)pixels);
+    }
+
+    int w = (turns == 2) ? image->width : image->height;
+    int h = (turns == 2) ? image->height : image->width;
+    RGSS_ImageRotate job = {(uint32_t *)image->pixels, pixels, image->width, image->height, turns};
+    RGSS_Image_Run(NULL, image, h, RGSS_IMAGE_GRAIN(w), RGSS_Image_RotateRows, &job);
+    return RGSS_Image_New(w, h, (unsigned char *)pixels);
+}
+
+static void RGSS_Image_PremultiplyRows(void *data, int start, int end)
+{
+    RGSS_Image *image = data;
+    RGSS_Pixels_Premultiply((uint32_t *)image->pixels + (size_t)start * image->width, (end - start) * image->width);
+}
+
+static void RGSS_Image_UnpremultiplyRows(void *data, int start, int end)
+{
+    RGSS_Image *image = data;
+    RGSS_Pixels_Unpremultiply((uint32_t *)image->pixels + (size_t)start * image->width, (end - start) * image->width);
+}
+
+static VALUE RGSS_Image_Premultiply(VALUE self)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_Image_Run(image, NULL, image->height, RGSS_IMAGE_GRAIN(image->width), RGSS_Image_PremultiplyRows, image);
+    return self;
+}
+
+static VALUE RGSS_Image_Unpremultiply(VALUE self)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+    RGSS_Image_Run(image, NULL, image->height, RGSS_IMAGE_GRAIN(image->width), RGSS_Image_UnpremultiplyRows, image);
+    return self;
+}
+
+typedef struct
+{
+    RGSS_Image *image;
+    float matrix[12];
+} RGSS_ImageTransform;
+
+static void RGSS_Image_TransformRows(void *data, int start, int end)
+{
+    RGSS_ImageTransform *job = data;
+    int w = job->image->width;
+    RGSS_Pixels_ColorMatrix((uint32_t *)job->image->pixels + (size_t)start * w, w, w, end - start, job->matrix);
+}
+
+static VALUE RGSS_Image_HueChange(VALUE self, VALUE hue)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+
+    RGSS_ImageTransform job = {image};
+    RGSS_Pixels_HueToneMatrix(NUM2FLT(hue), NULL, job.matrix);
+    RGSS_Image_Run(image, NULL, image->height, RGSS_IMAGE_GRAIN(image->width), RGSS_Image_TransformRows, &job);
+    return self;
+}
+
+static VALUE RGSS_Image_ToneChange(VALUE self, VALUE tone)
+{
+    RGSS_Image *image = DATA_PTR(self);
+    RGSS_ASSERT_IMAGE(image);
+
+    if (rb_obj_is_kind_of(tone, rb_cTone) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not a Tone", CLASS_NAME(tone));
+
+    RGSS_ImageTransform job = {image};
+    RGSS_Pixels_HueToneMatrix(0.0f, DATA_PTR(tone), job.matrix);
+    RGSS_Image_Run(image, NULL, image->height, RGSS_IMAGE_GRAIN(image->width), RGSS_Image_TransformRows, &job);
     return self;
 }
 
@@ -253,8 +842,24 @@ void RGSS_Init_Image(VALUE parent)
     rb_define_method0(rb_cImage, "pixels", RGSS_Image_GetPixels, 0);
     rb_define_method0(rb_cImage, "address", RGSS_Image_GetAddress, 0);
     rb_define_methodm1(rb_cImage, "save", RGSS_Image_Save, -1);
+    rb_define_methodm1(rb_cImage, "save_async", RGSS_Image_SaveAsync, -1);
+    rb_define_methodm1(rb_cImage, "resize", RGSS_Image_Resize, -1);
+    rb_define_methodm1(rb_cImage, "crop", RGSS_Image_Crop, -1);
+    rb_define_methodm1(rb_cImage, "blit", RGSS_Image_Blit, -1);
+    rb_define_method1(rb_cImage, "flip", RGSS_Image_Flip, 1);
+    rb_define_method1(rb_cImage, "rotate", RGSS_Image_Rotate, 1);
+    rb_define_method0(rb_cImage, "premultiply", RGSS_Image_Premultiply, 0);
+    rb_define_method0(rb_cImage, "unpremultiply", RGSS_Image_Unpremultiply, 0);
+    rb_define_method1(rb_cImage, "hue_change", RGSS_Image_HueChange, 1);
+    rb_define_method1(rb_cImage, "tone_change", RGSS_Image_ToneChange, 1);
 
     rb_define_alias(rb_cImage, "columns", "width");
     rb_define_alias(rb_cImage, "rows", "height");
     rb_define_alias(rb_cImage, "blob", "pixels");
+    rb_define_alias(rb_cImage, "blt", "blit");
+
+    rb_define_const(rb_cImage, "FLIP_NONE", INT2NUM(RGSS_FLIP_NONE));
+    rb_define_const(rb_cImage, "FLIP_X", INT2NUM(RGSS_FLIP_X));
+    rb_define_const(rb_cImage, "FLIP_Y", INT2NUM(RGSS_FLIP_Y));
+    rb_define_const(rb_cImage, "FLIP_BOTH", INT2NUM(RGSS_FLIP_BOTH));
 }
\ No newline at end of file
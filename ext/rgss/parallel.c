@@ -0,0 +1,173 @@
+#include "parallel.h"
+#include <pthread.h>
+#include <ruby/thread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#define RGSS_PARALLEL_MAX_THREADS 16
+
+static struct
+{
+    pthread_once_t once;      /** Guards the one-time creation of the worker threads. */
+    pthread_mutex_t busy;     /** Held by the thread currently submitting work to the pool. */
+    pthread_mutex_t mutex;    /** Protects the job state and counters. */
+    pthread_cond_t wake;      /** Signaled when a new job is submitted. */
+    pthread_cond_t done;      /** Signaled when the last worker finishes a job. */
+    int threads;              /** The number of worker threads, not including the submitting thread. */
+    int active;               /** The number of workers that have yet to finish the current job. */
+    unsigned long generation; /** Incremented for each job, used by workers to detect new work. */
+    RGSS_ParallelFunc func;   /** The function of the current job. */
+    void *data;               /** The user data of the current job. */
+    int count;                /** The number of items in the current job. */
+    int chunk;                /** The number of items claimed at a time. */
+    int next;                 /** The index of the next unclaimed item, accessed atomically. */
+} RGSS_POOL = {
+    .once = PTHREAD_ONCE_INIT,
+    .busy = PTHREAD_MUTEX_INITIALIZER,
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static _Thread_local int RGSS_IN_POOL;
+
+static void RGSS_Parallel_Drain(void)
+{
+    for (;;)
+    {
+        int start = __atomic_fetch_add(&RGSS_POOL.next, RGSS_POOL.chunk, __ATOMIC_RELAXED);
+        if (start >= RGSS_POOL.count)
+            break;
+        RGSS_POOL.func(RGSS_POOL.data, start, RGSS_MIN(start + RGSS_POOL.chunk, RGSS_POOL.count));
+    }
+}
+
+static void *RGSS_Parallel_Worker(void *arg)
+{
+    unsigned long seen = 0;
+    RGSS_IN_POOL = true;
+
+    pthread_mutex_lock(&RGSS_POOL.mutex);
+    for (;;)
+    {
+        while (RGSS_POOL.generation == seen)
+            pthread_cond_wait(&RGSS_POOL.wake, &RGSS_POOL.mutex);
+        seen = RGSS_POOL.generation;
+        pthread_mutex_unlock(&RGSS_POOL.mutex);
+
+        RGSS_Parallel_Drain();
+
+        pthread_mutex_lock(&RGSS_POOL.mutex);
+        if (--RGSS_POOL.active == 0)
+            pthread_cond_signal(&RGSS_POOL.done);
+    }
+    return NULL;
+}
+
+static int RGSS_Parallel_ProcessorCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+static void RGSS_Parallel_Init(void)
+{
+    int count = RGSS_MIN(RGSS_Parallel_ProcessorCount(), RGSS_PARALLEL_MAX_THREADS) - 1;
+
+#ifndef _WIN32
+    // Workers never run Ruby code, so keep signals meant for the interpreter from being delivered to them
+    sigset_t all, previous;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &previous);
+#endif
+
+    // This may run without the GVL, so a failure to create a thread simply results in a smaller pool
+    for (int i = 0; i < count; i++)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, RGSS_Parallel_Worker, NULL) != 0)
+            break;
+        pthread_detach(thread);
+        RGSS_POOL.threads++;
+    }
+
+#ifndef _WIN32
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+#endif
+}
+
+int RGSS_Parallel_Concurrency(void)
+{
+    pthread_once(&RGSS_POOL.once, RGSS_Parallel_Init);
+    return RGSS_POOL.threads + 1;
+}
+
+void RGSS_Parallel_For(int count, int grain, RGSS_ParallelFunc func, void *data)
+{
+    if (count <= 0)
+        return;
+
+    grain = RGSS_MAX(grain, 1);
+    pthread_once(&RGSS_POOL.once, RGSS_Parallel_Init);
+
+    // Small jobs, nested calls, and calls while the pool is in use by another thread are not worth waiting on
+    if (RGSS_POOL.threads == 0 || count <= grain || RGSS_IN_POOL || pthread_mutex_trylock(&RGSS_POOL.busy) != 0)
+    {
+        func(data, 0, count);
+        return;
+    }
+
+    // A few chunks per thread balances out uneven work, such as rows that are mostly transparent
+    pthread_mutex_lock(&RGSS_POOL.mutex);
+    RGSS_POOL.func = func;
+    RGSS_POOL.data = data;
+    RGSS_POOL.count = count;
+    RGSS_POOL.chunk = RGSS_MAX(grain, count / ((RGSS_POOL.threads + 1) * 4));
+    RGSS_POOL.next = 0;
+    RGSS_POOL.active = RGSS_POOL.threads;
+    RGSS_POOL.generation++;
+    pthread_cond_broadcast(&RGSS_POOL.wake);
+    pthread_mutex_unlock(&RGSS_POOL.mutex);
+
+    RGSS_IN_POOL = true;
+    RGSS_Parallel_Drain();
+    RGSS_IN_POOL = false;
+
+    pthread_mutex_lock(&RGSS_POOL.mutex);
+    while (RGSS_POOL.active > 0)
+        pthread_cond_wait(&RGSS_POOL.done, &RGSS_POOL.mutex);
+    pthread_mutex_unlock(&RGSS_POOL.mutex);
+    pthread_mutex_unlock(&RGSS_POOL.busy);
+}
+
+typedef struct
+{
+    int count;
+    int grain;
+    RGSS_ParallelFunc func;
+    void *data;
+} RGSS_ParallelArgs;
+
+static void *RGSS_Parallel_Invoke(void *data)
+{
+    RGSS_ParallelArgs *args = data;
+    RGSS_Parallel_For(args->count, args->grain, args->func, args->data);
+    return NULL;
+}
+
+void RGSS_Parallel_ForNoGVL(int count, int grain, RGSS_ParallelFunc func, void *data)
+{
+    RGSS_ParallelArgs args = {count, grain, func, data};
+    rb_thread_call_without_gvl(RGSS_Parallel_Invoke, &args, NULL, NULL);
+}
@@ -0,0 +1,41 @@
+#ifndef RGSS_PARALLEL_H
+#define RGSS_PARALLEL_H 1
+
+#include "rgss.h"
+
+/**
+ * @brief A function that processes a range of work items.
+ * @param[in] data The user data given to @ref RGSS_Parallel_For.
+ * @param[in] start The index of the first item in the range.
+ * @param[in] end The index one past the last item in the range.
+ */
+typedef void (*RGSS_ParallelFunc)(void *data, int start, int end);
+
+/**
+ * @brief Splits a range of work items into chunks which are processed by a shared pool of worker threads, and
+ * waits for them to complete. The calling thread processes chunks as well.
+ * @param[in] count The number of items to process.
+ * @param[in] grain The minimum number of items in each chunk.
+ * @param[in] func The function invoked for each chunk, which must not call into Ruby.
+ * @param[in] data User data passed to each invocation of @a func.
+ * @note Calls made from within a worker, or while another thread is using the pool, run on the calling thread.
+ */
+void RGSS_Parallel_For(int count, int grain, RGSS_ParallelFunc func, void *data);
+
+/**
+ * @brief Same as @ref RGSS_Parallel_For, but releases the GVL while the work is performed so other Ruby threads may
+ * continue to run. Must be called from a Ruby thread.
+ * @param[in] count The number of items to process.
+ * @param[in] grain The minimum number of items in each chunk.
+ * @param[in] func The function invoked for each chunk, which must not call into Ruby.
+ * @param[in] data User data passed to each invocation of @a func.
+ */
+void RGSS_Parallel_ForNoGVL(int count, int grain, RGSS_ParallelFunc func, void *data);
+
+/**
+ * @brief Retrieves the number of threads work is divided between, including the calling thread.
+ * @return The number of threads.
+ */
+int RGSS_Parallel_Concurrency(void);
+
+#endif /* RGSS_PARALLEL_H */
@@ -1,12 +1,54 @@
 #include "game.h"
 #include "graphics.h"
+#include "parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RGSS_PARTICLES_SSE2 1
+#include <emmintrin.h>
+#endif
 
 VALUE rb_cEmitter;
 
+/**
+ * @brief Flag indicating that updates leave emitting and simulating particles to @ref RGSS_Emitter_UpdateAll.
+ */
+static int RGSS_EMITTER_DEFERRED;
+
+/**
+ * @brief The particle budget shared by all emitters, which scales down emission when it is exceeded.
+ */
+static struct
+{
+    GLuint limit;      /** The number of live particles across all emitters to stay within, or @c 0 for no limit. */
+    double time_limit; /** The time spent simulating particles each tick to stay within, in seconds, or @c 0.0. */
+    double falloff;    /** The distance from the view at which emitters are throttled as if half their priority. */
+    GLuint live;       /** The number of particles alive across all emitters. */
+    double time;       /** The time spent simulating particles during the previous tick, in seconds. */
+    double elapsed;    /** The time spent simulating particles so far during the current tick, in seconds. */
+    uint64_t tick;     /** The game tick the elapsed time is being measured for. */
+    double usage;      /** The fraction of the budget used during the previous tick. */
+    float scale;       /** The factor emission is scaled by before priority, from 0.0 to 1.0. */
+} RGSS_PARTICLE_BUDGET = {.scale = 1.0f};
+
 GLuint RGSS_PARTICLE_SHADER;
 
-#define PARTICLE_QUAD_SIZE  (SIZEOF_FLOAT * 4)
-#define PARTICLE_COLOR_SIZE (sizeof(GLubyte) * 4)
+#define PARTICLE_LANES      8  /** The number of particles the storage is padded to a multiple of. */
+#define PARTICLE_ALIGNMENT  32 /** The alignment of each array of particle properties, in bytes. */
+#define PARTICLE_COLUMNS    16 /** The number of arrays in @ref RGSS_Particles. */
+#define PARTICLE_VICTIMS    64 /** The most particles selected for replacement in a single pass. */
+#define PARTICLE_GRADIENT   256 /** The number of colors a range of colors is resolved into. */
+#define PARTICLE_RADIX_BITS 8  /** The number of bits of depth sorted in each pass of the radix sort. */
+#define PARTICLE_BATCH      64 /** The most particles emitted with a single bulk generation of random numbers. */
+#define PARTICLE_RANDOMS    10 /** The number of random floats used to emit each particle. */
+#define PARTICLE_RECOVERY   0.02f /** The amount the budget scale recovers by each tick it is not exceeded. */
+#define PARTICLE_HEADROOM   0.9   /** The fraction of the budget usage must fall below before the scale recovers. */
+#define PARTICLE_MAX_DROP   0.1f  /** The most the budget scale drops by in a single tick, as a fraction of itself. */
+#define PARTICLE_MIN_SCALE  0.05f /** The lowest the budget scale drops to, so emitters are never silenced entirely. */
+
+// Emitters simulated without the GVL by update_all cannot be changed or disposed by other threads meanwhile
+#define RGSS_ASSERT_EMITTER_IDLE(e)                                                                                    \
+    if ((e)->busy)                                                                                                     \
+    rb_raise(rb_eRuntimeError, "emitter is in use by another thread")
 
 #define EMITTER_GET_RANGE(name, field)                                                                                 \
     static VALUE RGSS_Emitter_Get##name(VALUE self)                                                                    \
@@ -19,10 +61,30 @@ GLuint RGSS_PARTICLE_SHADER;
     static VALUE RGSS_Emitter_Set##name(VALUE self, VALUE value)                                                       \
     {                                                                                                                  \
         RGSS_Emitter *e = DATA_PTR(self);                                                                              \
+        RGSS_ASSERT_EMITTER_IDLE(e);                                                                                   \
         RGSS_Range_Parse(value, &e->field);                                                                            \
         return value;                                                                                                  \
     }
 
+/**
+ * @brief Describes what happens to new particles when an emitter has no free particles left.
+ */
+typedef enum
+{
+    RGSS_OVERFLOW_DROP,   /** New particles are not emitted. */
+    RGSS_OVERFLOW_REPLACE /** New particles replace the oldest particles that are alive. */
+} RGSS_OverflowPolicy;
+
+/**
+ * @brief The per-instance vertex data of a particle, interleaved so that all of it is uploaded with a single copy.
+ */
+typedef struct
+{
+    GLfloat quad[4]; /** The position and size of the particle, in pixels. */
+    GLuint color;    /** The packed RGBA color, including the current opacity. */
+    GLfloat angle;   /** The angle of rotation, in radians. */
+} RGSS_ParticleInstance;
+
 /**
  * @brief Base structure defining a range of values by a minimum and maximum.
  */
@@ -33,23 +95,42 @@ typedef struct
 } RGSS_Range;
 
 /**
- * @brief Container for particle data.
+ * @brief Container for particle data, stored as an array for each property so that the update can process several
+ * particles at once. Each array is aligned and padded to a multiple of @ref PARTICLE_LANES. Particles that are alive
+ * are kept packed at the front of the arrays, in no particular order.
+ */
+typedef struct
+{
+    float *x;        /** The current horizontal position of each particle. */
+    float *y;        /** The current vertical position of each particle. */
+    float *vx;       /** The current horizontal velocity of each particle. */
+    float *vy;       /** The current vertical velocity of each particle. */
+    float *size;     /** The base size of each particle. */
+    float *sx;       /** The current horizontal scale of each particle. */
+    float *sy;       /** The current vertical scale of each particle. */
+    float *growth;   /** Scaling factor applied to the base particle size each tick. */
+    float *angle;    /** The current angle of rotation, in degrees. */
+    float *rotation; /** The rotation to be applied each tick. */
+    float *opacity;  /** The current opacity, from 0.0 to 255.0. */
+    float *fade;     /** The amount of opacity change to apply each tick. */
+    int *life;       /** Number of ticks left to live, a particle is free when this is less than 1. */
+    int *depth;      /** The depth of each particle, used for determining render order. */
+    GLuint *color;   /** The packed RGBA color of each particle. */
+    GLuint *born;    /** The tick of the emitter each particle was emitted on. */
+    void *block;     /** The single allocation all of the arrays are stored in. */
+    int stride;      /** The number of elements in each array. */
+} RGSS_Particles;
+
+/**
+ * @brief Values shared by all particles during a single update.
  */
 typedef struct
 {
-    vec3 position;    /** The current position of the particle. */
-    vec3 scale;       /** The current scale of the particle. */
-    vec3 velocity;    /** The current velcoity of the particle. */
-    GLubyte color[4]; /** An RGBA color for the vertex color. */
-    vec2 size;        /** The size of the particle. */
-    int life;         /** Number of ticks left to live. */
-    float growth;     /** Scaling factor applied to the base particle size. */
-    float rotation;   /** The rotation to be applied each tick. */
-    float angle;      /** The current angle of rotation, in degrees. */
-    float fade;       /** The amount of opacity change to apply each tick. */
-    float opacity;    /** The current opacity as a float. */
-    int depth;        /** The depth of particle, used for determining render order; */
-} RGSS_Particle;
+    float delta;    /** The amount of time that has passed, in ticks. */
+    float drag[2];  /** The factors velocity is multiplied by for friction, normalized to the tick rate. */
+    float force[2]; /** The amount added to the velocity by wind and gravity. */
+    int order;      /** The amount depth changes by. */
+} RGSS_ParticleStep;
 
 /**
  * @brief Structure holding all the configuration on how particles will be emitted.
@@ -60,21 +141,22 @@ typedef struct
     VALUE viewport;       /** The Viewport object associated with this instance. */
     VALUE spectrum;       /** A Ruby value for possible colors for particles. */
     struct
+    {
+        GLuint *colors; /** The packed colors particles are randomly given, resolved from the spectrum. */
+        int count;      /** The number of colors, or @c 0 to give particles a random opaque color. */
+    } palette;
+    struct
     {
         VALUE value; /** The Ruby value of the texture. */
         GLuint id;   /** The OpenGL name of the texture. */
         vec2 size;
     } texture;
-    GLuint count;             /** The number of particles that are "alive" and in use. */
+    GLuint count;             /** The number of particles that are "alive" and in use, packed at the front. */
     GLushort capacity;        /** The maximum number of particles the emitter uses. */
-    GLuint last_used;         /** The index of the last used particle, used for search optimizations. */
-    RGSS_Particle *particles; /** An array of particles structures. */
-    GLfloat *quads;           /** A CPU buffer containing the offset/size for particles. */
-    GLubyte *colors;          /** A CPU buffer containing particle colors. */
-    float *angles;            /** A CPU buffer containing the particle angles. */
-    GLuint quad_vbo;          /** The VBO containing the offsets and sizes of the particles. */
-    GLuint color_vbo;         /** The VBO containing the colors of the particles. */
-    GLuint angle_vbo;         /** The VBO containing the angles of the particles. */
+    GLuint *sort;             /** Scratch space for ordering particles by depth. */
+    RGSS_Particles particles; /** The state of all particles, including those not in use. */
+    RGSS_ParticleInstance *instances; /** A CPU buffer containing the vertex data of the live particles. */
+    GLuint instance_vbo;              /** The VBO the instances are streamed to. */
     RGSS_Range lifespan;      /** A range determining the number of ticks particles will exist for. */
     RGSS_Range direction;     /** A range determining the initial direction (in degrees) of particles. */
     RGSS_Range size;          /** A range indicating the initial size of particles. */
@@ -91,6 +173,19 @@ typedef struct
     int paused;           /** Flag indicating if emitter has been suspended from creating new particles. */
     int order;            /** The amount to change on the z-axis each tick to determine render ordering. */
     int interval;         /** The number of ticks to wait until the next emission. */
+    GLuint tick;          /** The number of times the emitter has been updated. */
+    RGSS_OverflowPolicy overflow; /** Determines what happens to new particles when all of them are in use. */
+    unsigned long overflows;      /** The number of particles dropped or replaced because all were in use. */
+    RGSS_RandState rng;           /** The stream of random numbers used by this emitter. */
+    RGSS_RandLanes lanes;         /** The streams of random numbers particles are emitted with in bulk. */
+    RGSS_ParticleStep step;       /** The values shared by all particles in the current update. */
+    int pending;                  /** Flag indicating the emitter was updated, but its particles not yet simulated. */
+    float priority;               /** The importance of the emitter when emission is scaled down to fit the budget. */
+    float scale;                  /** The factor emission is currently scaled by to fit the budget. */
+    GLuint counted;               /** The number of particles of this emitter included in the budget. */
+    vec4 bounds;                  /** The left, top, right, and bottom of the live particle positions. */
+    int culled;                   /** Flag indicating the particles cannot reach the view, and are not simulated. */
+    int busy;                     /** Flag indicating the particles are being simulated without the GVL. */
 } RGSS_Emitter;
 
 static inline void RGSS_Range_Parse(VALUE value, RGSS_Range *range)
@@ -129,21 +224,59 @@ static inline void RGSS_Range_Parse(VALUE value, RGSS_Range *range)
     }
 }
 
-static inline float RGSS_Range_Rand(RGSS_Range *range)
+static inline float RGSS_Range_Lerp(const RGSS_Range *range, float t)
 {
     if (isfinite(range->min) && isfinite(range->max))
     {
-        return (RGSS_Rand() * (range->max - range->min)) + range->min;
+        return (t * (range->max - range->min)) + range->min;
         // float deviation = (range->max - range->min) * 0.5f;
         // return range->min + deviation + RGSS_Rand() * deviation - RGSS_Rand() * deviation;
     }
     return range->max;
 }
 
-static int RGSS_SortParticle(const void *p1, const void *p2)
+static inline float RGSS_Range_Rand(RGSS_RandState *rng, RGSS_Range *range)
+{
+    return RGSS_Range_Lerp(range, RGSS_Rand_Next(rng));
+}
+
+static void RGSS_Particles_Alloc(RGSS_Particles *p, int capacity)
+{
+    void **columns[] = {(void **)&p->x,       (void **)&p->y,        (void **)&p->vx,      (void **)&p->vy,
+                        (void **)&p->size,    (void **)&p->sx,       (void **)&p->sy,      (void **)&p->growth,
+                        (void **)&p->angle,   (void **)&p->rotation, (void **)&p->opacity, (void **)&p->fade,
+                        (void **)&p->life,    (void **)&p->depth,    (void **)&p->color,   (void **)&p->born};
+    const size_t count = PARTICLE_COLUMNS;
+
+    // Every property is 4 bytes, so a padded stride keeps all of the arrays aligned within one allocation
+    p->stride = (RGSS_MAX(capacity, 1) + PARTICLE_LANES - 1) & ~(PARTICLE_LANES - 1);
+    size_t size = p->stride * sizeof(float);
+    p->block = RGSS_MALLOC_ALIGNED(size * count, PARTICLE_ALIGNMENT);
+    memset(p->block, 0, size * count);
+
+    for (size_t i = 0; i < count; i++)
+        *columns[i] = (char *)p->block + (size * i);
+}
+
+/**
+ * @brief Copies every property of a particle to another index.
+ * @param[in] p The particle storage.
+ * @param[in] from The index of the particle to copy.
+ * @param[in] to The index to copy the particle to.
+ */
+static inline void RGSS_Particles_Move(RGSS_Particles *p, int from, int to)
+{
+    // All properties are 4 bytes, and each array follows the previous one in the same allocation
+    uint32_t *column = p->block;
+    for (int i = 0; i < PARTICLE_COLUMNS; i++, column += p->stride)
+        column[to] = column[from];
+}
+
+static void RGSS_Particles_Free(RGSS_Particles *p)
 {
-    RGSS_Particle *a = (RGSS_Particle *)p1, *b = (RGSS_Particle *)p2;
-    return a->depth > b->depth;
+    if (p->block)
+        free(p->block);
+    memset(p, 0, sizeof(RGSS_Particles));
 }
 
 static VALUE RGSS_Emitter_GetTexture(VALUE self)
@@ -155,6 +288,7 @@ static VALUE RGSS_Emitter_GetTexture(VALUE self)
 static VALUE RGSS_Emitter_SetTexture(VALUE self, VALUE value)
 {
     RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
     e->texture.value = value;
 
     if (RTEST(value))
@@ -179,14 +313,14 @@ static void RGSS_Emitter_Free(void *data)
     if (data == NULL)
         return;
     RGSS_Emitter *e = data;
-    if (e->particles)
-        xfree(e->particles);
-    if (e->quads)
-        xfree(e->quads);
-    if (e->colors)
-        xfree(e->colors);
-    if (e->angles)
-        xfree(e->angles);
+    RGSS_PARTICLE_BUDGET.live -= e->counted;
+    RGSS_Particles_Free(&e->particles);
+    if (e->instances)
+        xfree(e->instances);
+    if (e->sort)
+        xfree(e->sort);
+    if (e->palette.colors)
+        xfree(e->palette.colors);
     xfree(data);
 }
 
@@ -206,55 +340,46 @@ static VALUE RGSS_Emitter_Alloc(VALUE klass)
     e->viewport = Qnil;
     e->texture.value = Qnil;
     e->spectrum = Qnil;
+    RGSS_Rand_Stream(&e->rng);
+    RGSS_Rand_SplitLanes(&e->rng, &e->lanes);
+    e->priority = 1.0f;
+    e->scale = 1.0f;
+    glm_vec4_copy((vec4){FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX}, e->bounds);
     return Data_Wrap_Struct(klass, RGSS_Emitter_Mark, RGSS_Emitter_Free, e);
 }
 
 static VALUE RGSS_Emitter_Dispose(VALUE self)
 {
-    rb_call_super(0, NULL);
     RGSS_Emitter *e = DATA_PTR(self);
-    if (e->quad_vbo)
-    {
-        glDeleteBuffers(1, &e->quad_vbo);
-        e->quad_vbo = GL_NONE;
-    }
-    if (e->color_vbo)
-    {
-        glDeleteBuffers(1, &e->color_vbo);
-        e->color_vbo = GL_NONE;
-    }
-    if (e->angle_vbo)
+    RGSS_ASSERT_EMITTER_IDLE(e);
+    rb_call_super(0, NULL);
+    if (e->instance_vbo)
     {
-        glDeleteBuffers(1, &e->angle_vbo);
-        e->angle_vbo = GL_NONE;
+        glDeleteBuffers(1, &e->instance_vbo);
+        e->instance_vbo = GL_NONE;
     }
 
-    if (e->particles)
+    RGSS_Particles_Free(&e->particles);
+    if (e->instances)
     {
-        xfree(e->particles);
-        e->particles = NULL;
+        xfree(e->instances);
+        e->instances = NULL;
     }
-    if (e->quads)
+    if (e->sort)
     {
-        xfree(e->quads);
-        e->quads = NULL;
-    }
-    if (e->colors)
-    {
-        xfree(e->colors);
-        e->colors = NULL;
-    }
-    if (e->angles)
-    {
-        xfree(e->angles);
-        e->angles = NULL;
+        xfree(e->sort);
+        e->sort = NULL;
     }
+    RGSS_PARTICLE_BUDGET.live -= e->counted;
+    e->counted = 0;
+    e->count = 0;
     return Qnil;
 }
 
 static void *RGSS_Emitter_CreateStorage(RGSS_Emitter *e, size_t item_size)
 {
-    size_t size = item_size * e->capacity;
+    // Sized to the padded particle storage, so the update can write whole blocks of particles
+    size_t size = item_size * e->particles.stride;
     void *ptr = xmalloc(size);
     if (ptr == NULL)
         rb_raise(rb_eNoMemError, "out of memory");
@@ -272,34 +397,29 @@ static void RGSS_Emitter_VertexSetup(RGSS_Emitter *e, int max)
     e->base.vbo = RGSS_CreateBuffer(GL_ARRAY_BUFFER, sizeof(RGSS_QUAD_VERTICES), RGSS_QUAD_VERTICES, GL_STATIC_DRAW);
     e->base.ebo =
         RGSS_CreateBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(RGSS_QUAD_INDICES), RGSS_QUAD_INDICES, GL_STATIC_DRAW);
-    e->quad_vbo = RGSS_CreateBuffer(GL_ARRAY_BUFFER, PARTICLE_QUAD_SIZE * e->capacity, NULL, GL_STREAM_DRAW);
-    e->color_vbo = RGSS_CreateBuffer(GL_ARRAY_BUFFER, PARTICLE_COLOR_SIZE * e->capacity, NULL, GL_STREAM_DRAW);
-    e->angle_vbo = RGSS_CreateBuffer(GL_ARRAY_BUFFER, SIZEOF_FLOAT * e->capacity, NULL, GL_STREAM_DRAW);
+    e->instance_vbo =
+        RGSS_CreateBuffer(GL_ARRAY_BUFFER, sizeof(RGSS_ParticleInstance) * e->capacity, NULL, GL_STREAM_DRAW);
 
     // Configure static vertex data layout
     glEnableVertexAttribArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, e->base.vbo);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
 
-    // Configure the streaming VBO used for particle quads/sizes
+    // Configure the streaming VBO used for the interleaved quads/sizes, colors, and angles of particles
+    const GLsizei stride = sizeof(RGSS_ParticleInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, e->instance_vbo);
     glEnableVertexAttribArray(1);
-    glBindBuffer(GL_ARRAY_BUFFER, e->quad_vbo);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, NULL);
-
-    // Configure the streaming VBO used for particle colors
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(RGSS_ParticleInstance, quad));
     glEnableVertexAttribArray(2);
-    glBindBuffer(GL_ARRAY_BUFFER, e->color_vbo);
-    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, NULL);
-
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *)offsetof(RGSS_ParticleInstance, color));
     glEnableVertexAttribArray(3);
-    glBindBuffer(GL_ARRAY_BUFFER, e->angle_vbo);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 0, NULL);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(RGSS_ParticleInstance, angle));
 
     // Configure all the data is advanced in vertex shader
     glVertexAttribDivisor(0, 0); // Always reuse
-    glVertexAttribDivisor(1, 1); // One per quad
-    glVertexAttribDivisor(2, 1); // One per color
-    glVertexAttribDivisor(3, 1); // One per color
+    glVertexAttribDivisor(1, 1); // One per particle
+    glVertexAttribDivisor(2, 1); // One per particle
+    glVertexAttribDivisor(3, 1); // One per particle
 
     // Unbind the VAO
     glBindVertexArray(GL_NONE);
@@ -308,7 +428,7 @@ static void RGSS_Emitter_VertexSetup(RGSS_Emitter *e, int max)
 static VALUE RGSS_Emitter_Render(VALUE self, VALUE alpha)
 {
     RGSS_Emitter *e = DATA_PTR(self);
-    if (!e->base.visible || e->base.opacity < FLT_EPSILON)
+    if (!e->base.visible || e->base.opacity < FLT_EPSILON || e->culled)
         return Qnil;
 
     // Configure blending state
@@ -316,21 +436,21 @@ static VALUE RGSS_Emitter_Render(VALUE self, VALUE alpha)
     glBlendFunc(e->base.blend.src, e->base.blend.dst);
 
     // Setup shader
-    glUseProgram(RGSS_GRAPHICS.particle_shader.id);
+    RGSS_Graphics_UseProgram(RGSS_GRAPHICS.particle_shader.id);
     glUniform4fv(RGSS_GRAPHICS.particle_shader.color, 1, e->base.color);
     glUniform4fv(RGSS_GRAPHICS.particle_shader.tone, 1, e->base.tone);
     glUniform4fv(RGSS_GRAPHICS.particle_shader.flash, 1, e->base.flash_color);
     glUniform1f(RGSS_GRAPHICS.particle_shader.hue, e->base.hue);
     glUniform1f(RGSS_GRAPHICS.particle_shader.opacity, e->base.opacity);
 
-    glActiveTexture(GL_TEXTURE0);
     if (e->texture.id)
     {
-        glBindTexture(GL_TEXTURE_2D, e->texture.id);
+        RGSS_Texture_BindSampled(DATA_PTR(e->texture.value), 0, NULL, false);
         glUniform1i(RGSS_GRAPHICS.particle_shader.textured, GL_TRUE);
     }
     else
     {
+        glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, GL_NONE);
         glUniform1i(RGSS_GRAPHICS.particle_shader.textured, GL_FALSE);
     }
@@ -339,243 +459,856 @@ static VALUE RGSS_Emitter_Render(VALUE self, VALUE alpha)
     glBindVertexArray(e->base.vao);
     glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL, e->count);
     glBindVertexArray(GL_NONE);
+    glBindSampler(0, GL_NONE);
 
     return Qnil;
 }
 
-static inline GLuint RGSS_Emitter_GetIndex(RGSS_Emitter *e)
+static inline void RGSS_Emitter_SetParticleColor(RGSS_Emitter *e, GLuint *color)
 {
-    // Start search from index of previous location
-    for (GLuint i = e->last_used; i < e->capacity; i++)
+    uint64_t r = xoshiro256ss(&e->rng);
+    if (e->palette.count == 0)
+        *color = (GLuint)r | 0xFF000000;
+    else
+        *color = e->palette.colors[r % (uint64_t)e->palette.count];
+}
+
+/**
+ * @brief Initializes a particle as newly emitted.
+ * @param[in] e The emitter.
+ * @param[in] i The index of the particle.
+ * @param[in] random The @ref PARTICLE_RANDOMS random floats between @c 0.0 and @c 1.0 to initialize it with.
+ */
+static inline void RGSS_Emitter_RenewParticle(RGSS_Emitter *e, GLuint i, const float *random)
+{
+    RGSS_Particles *p = &e->particles;
+
+    // Select initial starting point of particle, using uniform (radial) distribution.
+    // https://programming.guide/random-point-within-circle.html
+    float a = random[0] * 2.0f * GLM_PI;
+    float r = e->radius * sqrtf(random[1]);
+    p->x[i] = e->base.entity.position[0] + (r * cosf(a));
+    p->y[i] = e->base.entity.position[1] + (r * sinf(a));
+    p->depth[i] = 0;
+
+    // Configure initial speed and direction
+    float direction = glm_rad(RGSS_Range_Lerp(&e->direction, random[2]));
+    float speed = RGSS_Range_Lerp(&e->force, random[3]);
+    p->vx[i] = sinf(direction) * speed;
+    p->vy[i] = cosf(direction) * speed;
+
+    float sz = RGSS_Range_Lerp(&e->size, random[4]);
+    p->size[i] = sz;
+
+    if (e->texture.id != 0)
     {
-        if (e->particles[i].life < 0)
-        {
-            e->last_used = i;
-            return i;
-        }
+        p->sx[i] = sz / e->texture.size[0];
+        p->sy[i] = sz / e->texture.size[1];
     }
-
-    // If none were found, then search from beginning
-    for (GLuint i = 0; i < e->last_used; i++)
+    else
     {
-        if (e->particles[i].life < 0)
-        {
-            e->last_used = i;
-            return i;
-        }
+        p->sx[i] = 1.0f;
+        p->sy[i] = 1.0f;
     }
-    // No available particles, override the first one
-    // RGSS_LogDebug("Maximum particle limit reached, consider increasing maximum particles or decreasing emission
-    // rate");
-    return 0;
+    p->sx[i] *= e->base.entity.scale[0];
+    p->sy[i] *= e->base.entity.scale[1];
+
+    p->angle[i] = random[5] * 360.0f; // TODO
+    p->rotation[i] = RGSS_Range_Lerp(&e->rotation, random[6]);
+    p->fade[i] = RGSS_Range_Lerp(&e->fade, random[7]);
+    p->growth[i] = RGSS_Range_Lerp(&e->growth, random[8]);
+    p->life[i] = (int)roundf(RGSS_Range_Lerp(&e->lifespan, random[9]));
+    p->born[i] = e->tick;
+    RGSS_Emitter_SetParticleColor(e, &p->color[i]);
+    p->opacity[i] = (float)(p->color[i] >> 24);
 }
 
-static inline void RGSS_Emitter_SetParticleColor(RGSS_Emitter *e, RGSS_Particle *p)
+/**
+ * @brief Emits particles in place of existing ones, with the random numbers for up to @ref PARTICLE_BATCH of them
+ * generated at once.
+ * @param[in] e The emitter.
+ * @param[in] indices The indices of the particles.
+ * @param[in] count The number of particles.
+ */
+static void RGSS_Emitter_RenewParticles(RGSS_Emitter *e, const GLuint *indices, int count)
 {
-    VALUE c;
-    if (NIL_P(e->spectrum))
+    float random[PARTICLE_BATCH * PARTICLE_RANDOMS];
+    for (int i = 0; i < count; i += PARTICLE_BATCH)
     {
-        int r = rand();
-        memcpy(p->color, &r, 4);
-        p->color[3] = 255;
-        return;
+        int n = RGSS_MIN(count - i, PARTICLE_BATCH);
+        RGSS_Rand_FillFloats(&e->lanes, random, n * PARTICLE_RANDOMS, 0.0f, 1.0f);
+        for (int j = 0; j < n; j++)
+            RGSS_Emitter_RenewParticle(e, indices[i + j], &random[j * PARTICLE_RANDOMS]);
     }
+}
+
+static VALUE RGSS_Emitter_GetSpectrum(VALUE self)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    return e->spectrum;
+}
 
-    if (rb_obj_is_kind_of(e->spectrum, rb_cColor))
+static VALUE RGSS_Emitter_SetSpectrum(VALUE self, VALUE value)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
+
+    // Resolve the spectrum into packed colors once, so emitting particles never needs to call into Ruby
+    long count;
+    if (NIL_P(value))
+        count = 0;
+    else if (rb_obj_is_kind_of(value, rb_cColor))
+        count = 1;
+    else if (RB_TYPE_P(value, T_ARRAY))
+        count = RGSS_MAX(rb_array_len(value), 1);
+    else if (rb_obj_is_kind_of(value, rb_cRange))
+        count = PARTICLE_GRADIENT;
+    else
+        rb_raise(rb_eTypeError, "%s is not a Color, Array, Range, or NilClass", CLASS_NAME(value));
+
+    GLuint *colors = count > 0 ? ALLOC_N(GLuint, count) : NULL;
+    if (rb_obj_is_kind_of(value, rb_cColor))
     {
-        c = e->spectrum;
-        goto RESULT;
+        RGSS_PackColor(DATA_PTR(value), colors);
     }
-
-    if (RB_TYPE_P(e->spectrum, T_ARRAY))
+    else if (RB_TYPE_P(value, T_ARRAY))
     {
-        long len = rb_array_len(e->spectrum);
-        if (len == 0)
+        // An empty array is treated as white, and invalid elements are reported before anything is changed
+        colors[0] = 0xFFFFFFFF;
+        for (long i = 0; i < rb_array_len(value); i++)
         {
-            memset(p->color, 255, 4);
-            return;
+            VALUE c = rb_ary_entry(value, i);
+            if (!rb_obj_is_kind_of(c, rb_cColor))
+            {
+                xfree(colors);
+                rb_raise(rb_eTypeError, "%s is not a Color", CLASS_NAME(c));
+            }
+            RGSS_PackColor(DATA_PTR(c), &colors[i]);
         }
-        c = rb_ary_entry(e->spectrum, rand() % len);
-        goto RESULT;
     }
-
-    if (rb_obj_is_kind_of(e->spectrum, rb_cRange))
+    else if (rb_obj_is_kind_of(value, rb_cRange))
     {
         VALUE a, b;
         int inclusive;
-        rb_range_values(e->spectrum, &a, &b, &inclusive);
+        rb_range_values(value, &a, &b, &inclusive);
+        if (!rb_obj_is_kind_of(a, rb_cColor) || !rb_obj_is_kind_of(b, rb_cColor))
+        {
+            xfree(colors);
+            rb_raise(rb_eTypeError, "range of %s is not a range of Color", CLASS_NAME(a));
+        }
 
+        // Enough steps for every 8-bit value between the two colors
         vec4 vec;
-        glm_vec4_lerp(DATA_PTR(a), DATA_PTR(b), RGSS_Rand(), vec);
-        RGSS_PackColor(vec, (unsigned int *)&p->color);
-        return;
+        for (int i = 0; i < PARTICLE_GRADIENT; i++)
+        {
+            glm_vec4_lerp(DATA_PTR(a), DATA_PTR(b), (float)i / (PARTICLE_GRADIENT - 1), vec);
+            RGSS_PackColor(vec, &colors[i]);
+        }
     }
 
-    rb_raise(rb_eTypeError, "%s is not a Color, Array, Range, or NilClass", CLASS_NAME(e->spectrum));
+    if (e->palette.colors)
+        xfree(e->palette.colors);
+    e->palette.colors = colors;
+    e->palette.count = (int)count;
+    e->spectrum = value;
+    return value;
+}
+
+/**
+ * @brief Emits particles in place of the oldest ones that are alive. The oldest are found in a single pass over the
+ * live particles for up to @ref PARTICLE_VICTIMS at a time, which is only needed when the emitter is full.
+ * @param[in] e The emitter.
+ * @param[in] count The number of particles to replace.
+ */
+static void RGSS_Emitter_ReplaceOldest(RGSS_Emitter *e, int count)
+{
+    GLuint victims[PARTICLE_VICTIMS];
+    const GLuint *born = e->particles.born, now = e->tick;
+    count = RGSS_MIN(count, (int)e->count);
+
+    while (count > 0)
+    {
+        // Keep the oldest particles sorted by age, from oldest to youngest
+        int size = 0, limit = RGSS_MIN(count, PARTICLE_VICTIMS);
+        for (GLuint i = 0; i < e->count; i++)
+        {
+            GLuint age = now - born[i];
+            if (size == limit && age <= now - born[victims[size - 1]])
+                continue;
+
+            int j = RGSS_MIN(size, limit - 1);
+            while (j > 0 && age > now - born[victims[j - 1]])
+            {
+                victims[j] = victims[j - 1];
+                j--;
+            }
+            victims[j] = i;
+            size = RGSS_MIN(size + 1, limit);
+        }
 
-RESULT:
-    RGSS_PackColor(DATA_PTR(c), (unsigned int *)&p->color);
+        // Replaced particles are born on this tick, so they are not selected again
+        RGSS_Emitter_RenewParticles(e, victims, size);
+        count -= size;
+    }
 }
 
-static inline void RGSS_Emitter_RenewParticle(RGSS_Emitter *e, RGSS_Particle *p)
+static inline void RGSS_Emitter_Emit(RGSS_Emitter *e)
 {
-    // Select initial starting point of particle, using uniform (radial) distribution.
-    // https://programming.guide/random-point-within-circle.html
-    float a = RGSS_Rand() * 2.0f * GLM_PI;
-    float r = e->radius * sqrtf(RGSS_Rand());
-    p->position[0] = e->base.entity.position[0] + (r * cosf(a));
-    p->position[1] = e->base.entity.position[1] + (r * sinf(a));
-    p->depth = 0;
+    if (e->paused)
+        return;
 
-    // Configure initial speed and direction
-    float direction = glm_rad(RGSS_Range_Rand(&e->direction));
-    float speed = RGSS_Range_Rand(&e->force);
-    p->velocity[0] = sinf(direction) * speed;
-    p->velocity[1] = cosf(direction) * speed;
+    if (e->interval > 0)
+    {
+        e->interval--;
+        return;
+    }
 
-    float sz = RGSS_Range_Rand(&e->size);
-    p->size[0] = sz;
-    p->size[1] = sz;
+    if (e->interval == 0)
+        e->interval = (int)RGSS_Range_Rand(&e->rng, &e->frequency);
 
-    if (e->texture.id != 0)
+    // Live particles are packed at the front, so free particles are always taken from the end of them
+    int count;
+    if (e->scale < 1.0f)
     {
-        p->scale[0] = sz / e->texture.size[0];
-        p->scale[1] = sz / e->texture.size[1];
+        // Rounded randomly, so low rates are still emitted at the scaled rate on average
+        float rate = RGSS_Range_Rand(&e->rng, &e->rate) * e->scale;
+        count = (int)(rate + RGSS_Rand_Next(&e->rng));
     }
     else
     {
-        glm_vec2_one(p->scale);
+        count = (int)RGSS_Range_Rand(&e->rng, &e->rate);
+    }
+    GLuint indices[PARTICLE_BATCH];
+    int available = RGSS_MIN(count, (int)e->capacity - (int)e->count);
+    for (int i = 0; i < available; i += PARTICLE_BATCH)
+    {
+        int n = RGSS_MIN(available - i, PARTICLE_BATCH);
+        for (int j = 0; j < n; j++)
+            indices[j] = e->count++;
+        RGSS_Emitter_RenewParticles(e, indices, n);
     }
-    glm_vec2_mul(p->scale, e->base.entity.scale, p->scale);
 
-    p->angle = RGSS_Rand() * 360.0f; // TODO
-    p->rotation = RGSS_Range_Rand(&e->rotation);
-    p->fade = RGSS_Range_Rand(&e->fade);
-    p->growth = RGSS_Range_Rand(&e->growth);
-    p->life = (int)roundf(RGSS_Range_Rand(&e->lifespan));
-    RGSS_Emitter_SetParticleColor(e, p);
-    p->opacity = p->color[3];
+    if (count > available)
+    {
+        e->overflows += count - available;
+        if (e->overflow == RGSS_OVERFLOW_REPLACE)
+            RGSS_Emitter_ReplaceOldest(e, count - available);
+    }
 }
 
-static VALUE RGSS_Emitter_GetSpectrum(VALUE self)
+/**
+ * @brief Advances a single particle, and writes it to the instance buffers at the same index.
+ * @param[in] e The emitter.
+ * @param[in] s The values shared by all particles this update.
+ * @param[in] i The index of the particle.
+ * @return @c true if the particle is still alive, otherwise @c false.
+ */
+static inline int RGSS_Emitter_StepParticle(RGSS_Emitter *e, const RGSS_ParticleStep *s, int i)
 {
-    RGSS_Emitter *e = DATA_PTR(self);
-    return e->spectrum;
+    RGSS_Particles *p = &e->particles;
+    if (--p->life[i] < 1)
+        return false;
+
+    // Resize and fade out.
+    p->sx[i] += p->growth[i] * s->delta;
+    p->sy[i] += p->growth[i] * s->delta;
+    p->opacity[i] -= p->fade[i] * s->delta;
+
+    // Free the particle if it has 0 opacity or scales to nothing
+    if (p->opacity[i] < FLT_EPSILON || p->sx[i] < FLT_EPSILON || p->sy[i] < FLT_EPSILON)
+    {
+        p->life[i] = 0;
+        return false;
+    }
+
+    // Rotate, apply friction, wind, and gravity, then translate.
+    p->angle[i] += p->rotation[i] * s->delta;
+    p->vx[i] = (p->vx[i] * s->drag[0]) + s->force[0];
+    p->vy[i] = (p->vy[i] * s->drag[1]) + s->force[1];
+    p->x[i] += p->vx[i] * s->delta;
+    p->y[i] += p->vy[i] * s->delta;
+
+    // Move on Z-axis to determine draw order.
+    p->depth[i] += s->order;
+
+    GLuint alpha = (GLuint)ceilf(RGSS_MIN(p->opacity[i], 255.0f));
+    RGSS_ParticleInstance *instance = &e->instances[i];
+    instance->quad[0] = p->x[i];
+    instance->quad[1] = p->y[i];
+    instance->quad[2] = p->size[i] * p->sx[i];
+    instance->quad[3] = p->size[i] * p->sy[i];
+    instance->color = (p->color[i] & 0x00FFFFFF) | (alpha << 24);
+    instance->angle = glm_rad(p->angle[i]);
+    return true;
 }
 
-static VALUE RGSS_Emitter_SetSpectrum(VALUE self, VALUE value)
+#ifdef RGSS_PARTICLES_SSE2
+
+static inline __m128 RGSS_Select_SSE2(__m128 mask, __m128 a, __m128 b)
 {
-    RGSS_Emitter *e = DATA_PTR(self);
-    e->spectrum = value;
-    return value;
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
 }
 
-static inline void RGSS_Emitter_Emit(RGSS_Emitter *e)
+/**
+ * @brief Advances the live particles four at a time, and writes them to the instance buffers in the same pass. Free
+ * lanes in the last block are left unchanged, so they never accumulate denormal or infinite values.
+ * @param[out] bounds Receives the left, top, right, and bottom of the positions of the particles still alive.
+ * @return @c true if any particles died, otherwise @c false.
+ */
+static int RGSS_Emitter_StepSSE2(RGSS_Emitter *e, const RGSS_ParticleStep *s, vec4 bounds)
 {
-    if (e->paused)
-        return;
+    RGSS_Particles *p = &e->particles;
+    const __m128 delta = _mm_set1_ps(s->delta), epsilon = _mm_set1_ps(FLT_EPSILON);
+    const __m128 drag_x = _mm_set1_ps(s->drag[0]), drag_y = _mm_set1_ps(s->drag[1]);
+    const __m128 force_x = _mm_set1_ps(s->force[0]), force_y = _mm_set1_ps(s->force[1]);
+    const __m128 radians = _mm_set1_ps(GLM_PI / 180.0f), opaque = _mm_set1_ps(255.0f);
+    const __m128i zero = _mm_setzero_si128(), one = _mm_set1_epi32(1), order = _mm_set1_epi32(s->order);
+    const __m128i rgb = _mm_set1_epi32(0x00FFFFFF), lanes = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i count = _mm_set1_epi32((int)e->count);
+    const __m128 lowest = _mm_set1_ps(-FLT_MAX), highest = _mm_set1_ps(FLT_MAX);
+    __m128 left = highest, top = highest, right = lowest, bottom = lowest;
+
+    int died = 0;
+    for (int i = 0; i < (int)e->count; i += 4)
+    {
+        // Lanes that were already free become negative, and are cleared along with those that die. Every lane before
+        // the count is a particle in use, even one emitted without any life, so it dies the same as in the scalar path.
+        __m128i life = _mm_load_si128((__m128i *)&p->life[i]);
+        __m128 used = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(i), lanes), count));
+        life = _mm_sub_epi32(life, one);
+        __m128 alive = _mm_castsi128_ps(_mm_cmpgt_epi32(life, zero));
+
+        // Resize and fade out.
+        __m128 size = _mm_load_ps(&p->size[i]);
+        __m128 growth = _mm_mul_ps(_mm_load_ps(&p->growth[i]), delta);
+        __m128 sx = _mm_add_ps(_mm_load_ps(&p->sx[i]), growth);
+        __m128 sy = _mm_add_ps(_mm_load_ps(&p->sy[i]), growth);
+        __m128 opacity = _mm_sub_ps(_mm_load_ps(&p->opacity[i]), _mm_mul_ps(_mm_load_ps(&p->fade[i]), delta));
+        alive = _mm_and_ps(alive, _mm_cmpge_ps(opacity, epsilon));
+        alive = _mm_and_ps(alive, _mm_and_ps(_mm_cmpge_ps(sx, epsilon), _mm_cmpge_ps(sy, epsilon)));
+        _mm_store_si128((__m128i *)&p->life[i], _mm_and_si128(life, _mm_castps_si128(alive)));
+        died |= _mm_movemask_ps(_mm_andnot_ps(alive, used));
+
+        // Rotate, apply friction, wind, and gravity, then translate.
+        __m128 angle = _mm_add_ps(_mm_load_ps(&p->angle[i]), _mm_mul_ps(_mm_load_ps(&p->rotation[i]), delta));
+        __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_load_ps(&p->vx[i]), drag_x), force_x);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_load_ps(&p->vy[i]), drag_y), force_y);
+        __m128 x = _mm_add_ps(_mm_load_ps(&p->x[i]), _mm_mul_ps(vx, delta));
+        __m128 y = _mm_add_ps(_mm_load_ps(&p->y[i]), _mm_mul_ps(vy, delta));
+        __m128i depth = _mm_load_si128((__m128i *)&p->depth[i]);
+        depth = _mm_add_epi32(depth, _mm_and_si128(order, _mm_castps_si128(alive)));
+
+        _mm_store_ps(&p->sx[i], RGSS_Select_SSE2(alive, sx, _mm_load_ps(&p->sx[i])));
+        _mm_store_ps(&p->sy[i], RGSS_Select_SSE2(alive, sy, _mm_load_ps(&p->sy[i])));
+        _mm_store_ps(&p->opacity[i], RGSS_Select_SSE2(alive, opacity, _mm_load_ps(&p->opacity[i])));
+        _mm_store_ps(&p->angle[i], RGSS_Select_SSE2(alive, angle, _mm_load_ps(&p->angle[i])));
+        _mm_store_ps(&p->vx[i], RGSS_Select_SSE2(alive, vx, _mm_load_ps(&p->vx[i])));
+        _mm_store_ps(&p->vy[i], RGSS_Select_SSE2(alive, vy, _mm_load_ps(&p->vy[i])));
+        _mm_store_ps(&p->x[i], RGSS_Select_SSE2(alive, x, _mm_load_ps(&p->x[i])));
+        _mm_store_ps(&p->y[i], RGSS_Select_SSE2(alive, y, _mm_load_ps(&p->y[i])));
+        _mm_store_si128((__m128i *)&p->depth[i], depth);
+
+        // Dead and free lanes are excluded from the bounds
+        left = _mm_min_ps(left, RGSS_Select_SSE2(alive, x, highest));
+        top = _mm_min_ps(top, RGSS_Select_SSE2(alive, y, highest));
+        right = _mm_max_ps(right, RGSS_Select_SSE2(alive, x, lowest));
+        bottom = _mm_max_ps(bottom, RGSS_Select_SSE2(alive, y, lowest));
+
+        // Write the instances at the same index, those of dead particles are replaced when they are removed. The
+        // alpha is rounded up, without SSE4.1 by adding one when truncation lost a fraction.
+        opacity = _mm_min_ps(opacity, opaque);
+        __m128i alpha = _mm_cvttps_epi32(opacity);
+        alpha = _mm_sub_epi32(alpha, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(alpha), opacity)));
+        __m128i color = _mm_and_si128(_mm_load_si128((__m128i *)&p->color[i]), rgb);
+        color = _mm_or_si128(color, _mm_slli_epi32(alpha, 24));
+        __m128i radian = _mm_castps_si128(_mm_mul_ps(angle, radians));
+
+        // Transpose into one quad per particle, and pair each color with its angle for the rest of the instance
+        __m128 w = _mm_mul_ps(size, sx), h = _mm_mul_ps(size, sy);
+        _MM_TRANSPOSE4_PS(x, y, w, h);
+        __m128i tail_lo = _mm_unpacklo_epi32(color, radian), tail_hi = _mm_unpackhi_epi32(color, radian);
+
+        RGSS_ParticleInstance *instance = &e->instances[i];
+        _mm_storeu_ps(instance[0].quad, x);
+        _mm_storel_epi64((__m128i *)&instance[0].color, tail_lo);
+        _mm_storeu_ps(instance[1].quad, y);
+        _mm_storel_epi64((__m128i *)&instance[1].color, _mm_srli_si128(tail_lo, 8));
+        _mm_storeu_ps(instance[2].quad, w);
+        _mm_storel_epi64((__m128i *)&instance[2].color, tail_hi);
+        _mm_storeu_ps(instance[3].quad, h);
+        _mm_storel_epi64((__m128i *)&instance[3].color, _mm_srli_si128(tail_hi, 8));
+    }
 
-    if (e->interval > 0)
+    // Reduce the lanes of each edge to a single value
+    float edges[4][4];
+    _mm_storeu_ps(edges[0], left);
+    _mm_storeu_ps(edges[1], top);
+    _mm_storeu_ps(edges[2], right);
+    _mm_storeu_ps(edges[3], bottom);
+    for (int j = 0; j < 4; j++)
     {
-        e->interval--;
-        return;
+        bounds[0] = RGSS_MIN(bounds[0], edges[0][j]);
+        bounds[1] = RGSS_MIN(bounds[1], edges[1][j]);
+        bounds[2] = RGSS_MAX(bounds[2], edges[2][j]);
+        bounds[3] = RGSS_MAX(bounds[3], edges[3][j]);
     }
+    return died != 0;
+}
 
-    if (e->interval == 0)
-        e->interval = (int)RGSS_Range_Rand(&e->frequency);
+#endif /* RGSS_PARTICLES_SSE2 */
 
-    int count = (int)RGSS_Range_Rand(&e->rate);
-    for (int i = 0; i < count; i++)
+/**
+ * @brief Removes dead particles by moving the last live particle and its instance into their place.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Compact(RGSS_Emitter *e)
+{
+    RGSS_Particles *p = &e->particles;
+
+    // Walking backwards guarantees the last particle has already been checked, and is alive
+    for (int i = (int)e->count - 1; i >= 0; i--)
     {
-        GLuint index = RGSS_Emitter_GetIndex(e);
-        RGSS_Emitter_RenewParticle(e, &e->particles[index]);
+        if (p->life[i] > 0)
+            continue;
+
+        int last = (int)--e->count;
+        if (i == last)
+            continue;
+
+        RGSS_Particles_Move(p, last, i);
+        p->life[last] = 0;
+        e->instances[i] = e->instances[last];
     }
 }
 
-static VALUE RGSS_Emitter_Update(VALUE self, VALUE delta)
+/**
+ * @brief Reorders the instances of the live particles by ascending depth, with a stable LSD radix sort. Passes over
+ * digits that are the same for every particle are skipped, which is most of them, as depth only spans the lifespan.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Sort(RGSS_Emitter *e)
 {
-    rb_call_super(1, &delta);
+    const GLuint n = e->count, stride = e->particles.stride;
+    GLuint *keys = e->sort, *keys_out = keys + stride;
+    GLuint *index = keys_out + stride, *index_out = index + stride;
+    GLuint first = (GLuint)e->particles.depth[0], differ = 0;
+    for (GLuint i = 0; i < n; i++)
+    {
+        // Flipping the sign bit orders signed depth as unsigned keys
+        keys[i] = (GLuint)e->particles.depth[i] ^ 0x80000000u;
+        index[i] = i;
+        differ |= (GLuint)e->particles.depth[i] ^ first;
+    }
 
-    RGSS_Emitter *e = DATA_PTR(self);
-    float d = NUM2FLT(delta);
+    const GLuint buckets = 1 << PARTICLE_RADIX_BITS, mask = buckets - 1;
+    int sorted = true;
+    for (int shift = 0; shift < 32; shift += PARTICLE_RADIX_BITS)
+    {
+        if (((differ >> shift) & mask) == 0)
+            continue;
+
+        GLuint offsets[1 << PARTICLE_RADIX_BITS] = {0};
+        for (GLuint i = 0; i < n; i++)
+            offsets[(keys[i] >> shift) & mask]++;
+
+        GLuint total = 0;
+        for (GLuint b = 0; b < buckets; b++)
+        {
+            GLuint count = offsets[b];
+            offsets[b] = total;
+            total += count;
+        }
+        for (GLuint i = 0; i < n; i++)
+        {
+            GLuint dst = offsets[(keys[i] >> shift) & mask]++;
+            keys_out[dst] = keys[i];
+            index_out[dst] = index[i];
+        }
+
+        GLuint *swap = keys;
+        keys = keys_out;
+        keys_out = swap;
+        swap = index;
+        index = index_out;
+        index_out = swap;
+        sorted = false;
+    }
+    if (sorted)
+        return;
+
+    // Gather the instances into the remaining scratch space, and copy them back in order
+    RGSS_ParticleInstance *scratch = (RGSS_ParticleInstance *)(e->sort + (stride * 4));
+    for (GLuint i = 0; i < n; i++)
+        scratch[i] = e->instances[index[i]];
+    memcpy(e->instances, scratch, n * sizeof(RGSS_ParticleInstance));
+}
+
+/**
+ * @brief Emits new particles and advances all of them, using the values computed for this update. This does not call
+ * into Ruby or OpenGL, and may run on any thread.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Simulate(RGSS_Emitter *e)
+{
+    e->tick++;
     RGSS_Emitter_Emit(e);
 
-    RGSS_Particle *p;
-    int count = 0;
-    for (int i = 0; i < e->capacity; i++)
+    vec4 bounds = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+#ifdef RGSS_PARTICLES_SSE2
+    int died = RGSS_Emitter_StepSSE2(e, &e->step, bounds);
+#else
+    int died = false;
+    for (int i = 0; i < (int)e->count; i++)
     {
-        p = &e->particles[i];
-        if (--p->life > 0)
+        if (!RGSS_Emitter_StepParticle(e, &e->step, i))
         {
-            // Resize.
-            glm_vec2_adds(p->scale, p->growth * d, p->scale);
+            died = true;
+            continue;
+        }
+        bounds[0] = RGSS_MIN(bounds[0], e->particles.x[i]);
+        bounds[1] = RGSS_MIN(bounds[1], e->particles.y[i]);
+        bounds[2] = RGSS_MAX(bounds[2], e->particles.x[i]);
+        bounds[3] = RGSS_MAX(bounds[3], e->particles.y[i]);
+    }
+#endif
+    glm_vec4_copy(bounds, e->bounds);
+
+    // Pack the live particles together, then sort them for proper render order.
+    if (died)
+        RGSS_Emitter_Compact(e);
+    if (e->order != 0 && e->count > 1)
+        RGSS_Emitter_Sort(e);
+}
 
-            // Fade out.
-            p->opacity -= p->fade * d;
-            p->color[3] = (unsigned char)ceilf(p->opacity);
+static void RGSS_Emitter_SimulateRange(void *data, int start, int end)
+{
+    RGSS_Emitter **emitters = data;
+    for (int i = start; i < end; i++)
+        RGSS_Emitter_Simulate(emitters[i]);
+}
 
-            // Early out of this iteration has 0 opacity or scales to nothing
-            if (p->opacity < FLT_EPSILON || p->scale[0] < FLT_EPSILON || p->scale[1] < FLT_EPSILON)
-            {
-                p->life = -1;
-                continue;
-            }
+/**
+ * @brief Uploads the instances of the live particles to the GPU, with a single copy into the mapped buffer.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Upload(RGSS_Emitter *e)
+{
+    GLsizeiptr size = e->count * sizeof(RGSS_ParticleInstance);
+    if (size == 0)
+        return;
 
-            // Rotate.
-            p->angle += p->rotation * d;
+    // Invalidating the buffer orphans it, so writing to it never waits on the previous frame still being drawn.
+    // https://www.khronos.org/opengl/wiki/Buffer_Object_Streaming#Buffer_re-specification
+    glBindBuffer(GL_ARRAY_BUFFER, e->instance_vbo);
+    void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped)
+    {
+        memcpy(mapped, e->instances, size);
+        if (glUnmapBuffer(GL_ARRAY_BUFFER))
+            return;
+    }
 
-            // Normalize friction to game delta
-            p->velocity[0] *= 1.0f - ((e->friction[0] * d) / RGSS_GAME.time.tps);
-            p->velocity[1] *= 1.0f - ((e->friction[1] * d) / RGSS_GAME.time.tps);
+    // Mapping failed, or the contents were lost while mapped
+    glBufferData(GL_ARRAY_BUFFER, e->capacity * sizeof(RGSS_ParticleInstance), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, e->instances);
+}
 
-            p->velocity[0] += e->wind * d;
-            p->velocity[1] += e->gravity * d;
+/**
+ * @brief Updates the budget scale once at the start of each game tick, from the usage of the previous tick. The
+ * scale drops in proportion to how far the budget is exceeded, and recovers gradually once usage is well within it.
+ *
+ * Particles emitted before a drop stay alive for a while, so usage lags behind the scale. The scale only drops again
+ * while usage is not already falling, and by a bounded amount, otherwise it would compound towards zero each tick
+ * until the existing particles expire.
+ */
+static void RGSS_Particles_Govern(void)
+{
+    if (RGSS_PARTICLE_BUDGET.tick == RGSS_GAME.time.total_ticks)
+        return;
+    RGSS_PARTICLE_BUDGET.tick = RGSS_GAME.time.total_ticks;
+    RGSS_PARTICLE_BUDGET.time = RGSS_PARTICLE_BUDGET.elapsed;
+    RGSS_PARTICLE_BUDGET.elapsed = 0.0;
 
-            // Move on Z-axis to determine draw order.
-            p->depth += e->order;
+    double usage = 0.0;
+    if (RGSS_PARTICLE_BUDGET.limit > 0)
+        usage = (double)RGSS_PARTICLE_BUDGET.live / RGSS_PARTICLE_BUDGET.limit;
+    if (RGSS_PARTICLE_BUDGET.time_limit > 0.0)
+        usage = RGSS_MAX(usage, RGSS_PARTICLE_BUDGET.time / RGSS_PARTICLE_BUDGET.time_limit);
 
-            // Translate
-            glm_vec3_muladds(p->velocity, d, p->position);
+    double previous = RGSS_PARTICLE_BUDGET.usage;
+    RGSS_PARTICLE_BUDGET.usage = usage;
 
-            // Fill the GPU buffers
-            e->quads[4 * count + 0] = p->position[0];
-            e->quads[4 * count + 1] = p->position[1];
-            e->quads[4 * count + 2] = p->size[0] * p->scale[0];
-            e->quads[4 * count + 3] = p->size[1] * p->scale[1];
+    if (usage > 1.0)
+    {
+        if (usage >= previous)
+        {
+            float drop = RGSS_MIN(1.0f - (float)(1.0 / usage), PARTICLE_MAX_DROP);
+            RGSS_PARTICLE_BUDGET.scale = RGSS_MAX(RGSS_PARTICLE_BUDGET.scale * (1.0f - drop), PARTICLE_MIN_SCALE);
+        }
+    }
+    else if (usage < PARTICLE_HEADROOM)
+        RGSS_PARTICLE_BUDGET.scale = RGSS_MIN(RGSS_PARTICLE_BUDGET.scale + PARTICLE_RECOVERY, 1.0f);
+}
 
-            e->colors[4 * count + 0] = p->color[0];
-            e->colors[4 * count + 1] = p->color[1];
-            e->colors[4 * count + 2] = p->color[2];
-            e->colors[4 * count + 3] = p->color[3];
+/**
+ * @brief Retrieves the area particles of an emitter are visible in, which is the viewport it is drawn in, or the
+ * screen.
+ * @param[in] e The emitter.
+ * @param[out] view Receives the left, top, right, and bottom edges, in the coordinates particles are positioned in.
+ */
+static void RGSS_Emitter_GetView(RGSS_Emitter *e, vec4 view)
+{
+    view[0] = 0.0f;
+    view[1] = 0.0f;
+    if (RTEST(e->viewport))
+    {
+        RGSS_Entity *viewport = DATA_PTR(e->viewport);
+        view[2] = viewport->size[0];
+        view[3] = viewport->size[1];
+    }
+    else
+    {
+        view[2] = RGSS_GRAPHICS.resolution[0];
+        view[3] = RGSS_GRAPHICS.resolution[1];
+    }
+}
 
-            e->angles[count] = glm_rad(p->angle);
+/**
+ * @brief Determines how much the emission of an emitter is scaled down to fit the budget. Emitters with a lower
+ * priority, or further from the center of the view, are scaled down more.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Throttle(RGSS_Emitter *e)
+{
+    float scale = RGSS_PARTICLE_BUDGET.scale;
+    if (scale >= 1.0f)
+    {
+        e->scale = 1.0f;
+        return;
+    }
 
-            count++;
-        }
+    vec4 view;
+    RGSS_Emitter_GetView(e, view);
+    vec2 center = {(view[0] + view[2]) * 0.5f, (view[1] + view[3]) * 0.5f};
+    float distance = glm_vec2_distance(e->base.entity.position, center);
+    float falloff = (float)RGSS_PARTICLE_BUDGET.falloff;
+    if (falloff <= 0.0f)
+        falloff = glm_vec2_norm((vec2){view[2] - view[0], view[3] - view[1]}) * 0.5f;
+
+    // The weight is an exponent, so an emitter with twice the weight keeps the square root of the scale
+    float weight = e->priority / (1.0f + distance / RGSS_MAX(falloff, 1.0f));
+    e->scale = weight > FLT_EPSILON ? powf(scale, 1.0f / weight) : 0.0f;
+}
+
+/**
+ * @brief Includes the current particles of an emitter in the budget, and uploads them. Must be called from the thread
+ * that owns the OpenGL context.
+ * @param[in] e The emitter.
+ */
+static void RGSS_Emitter_Finish(RGSS_Emitter *e)
+{
+    RGSS_PARTICLE_BUDGET.live += e->count - e->counted;
+    e->counted = e->count;
+    RGSS_Emitter_Upload(e);
+}
+
+/**
+ * @brief Computes the values shared by all particles for an update.
+ * @param[in] e The emitter.
+ * @param[in] delta The amount of time that has passed, in ticks.
+ */
+static void RGSS_Emitter_Prepare(RGSS_Emitter *e, float delta)
+{
+    // Normalize friction to game delta
+    e->step.delta = delta;
+    e->step.drag[0] = 1.0f - ((e->friction[0] * delta) / RGSS_GAME.time.tps);
+    e->step.drag[1] = 1.0f - ((e->friction[1] * delta) / RGSS_GAME.time.tps);
+    e->step.force[0] = e->wind * delta;
+    e->step.force[1] = e->gravity * delta;
+    e->step.order = e->order;
+}
+
+/**
+ * @brief Computes the furthest distance a particle may move from where it is, plus the distance its corners may
+ * extend from its center, within the longest lifespan. Friction is assumed to only slow particles down.
+ * @param[in] e The emitter, with the values of the current update already prepared.
+ * @return The distance, in pixels.
+ */
+static float RGSS_Emitter_GetReach(RGSS_Emitter *e)
+{
+    const float d = e->step.delta;
+    float life = RGSS_MAX(e->lifespan.max, 0.0f);
+    float speed = RGSS_MAX(fabsf(e->force.min), fabsf(e->force.max));
+    float accel = glm_vec2_norm((vec2){e->wind, e->gravity});
+    float travel = (speed * d * life) + (accel * d * d * life * (life + 1.0f) * 0.5f);
+
+    float scale = RGSS_MAX(fabsf(e->base.entity.scale[0]), fabsf(e->base.entity.scale[1]));
+    if (e->texture.id != 0)
+        scale *= e->size.max / RGSS_MIN(e->texture.size[0], e->texture.size[1]);
+    scale += RGSS_MAX(e->growth.max, 0.0f) * d * life;
+    return travel + (e->size.max * scale * (float)M_SQRT2);
+}
+
+/**
+ * @brief Determines if any particles of an emitter, existing or yet to be emitted, can reach the view. The area is
+ * the spawn area and the positions of the live particles, extended by the distance they can still travel.
+ * @param[in] e The emitter, with the values of the current update already prepared.
+ * @return @c true if none of the particles can be seen, otherwise @c false.
+ */
+static int RGSS_Emitter_Cull(RGSS_Emitter *e)
+{
+    const float *position = e->base.entity.position;
+    vec4 area = {position[0] - e->radius, position[1] - e->radius, position[0] + e->radius, position[1] + e->radius};
+    if (e->count > 0)
+    {
+        area[0] = RGSS_MIN(area[0], e->bounds[0]);
+        area[1] = RGSS_MIN(area[1], e->bounds[1]);
+        area[2] = RGSS_MAX(area[2], e->bounds[2]);
+        area[3] = RGSS_MAX(area[3], e->bounds[3]);
     }
 
-    // Store how many particles will be rendered, then sort the particles for proper render order.
-    e->count = count;
-    qsort(e->particles, e->capacity, sizeof(RGSS_Particle), RGSS_SortParticle);
+    vec4 view;
+    RGSS_Emitter_GetView(e, view);
+    float reach = RGSS_Emitter_GetReach(e);
+    return area[2] + reach < view[0] || area[0] - reach > view[2] || area[3] + reach < view[1] ||
+           area[1] - reach > view[3];
+}
 
-    // Orphan existing buffers before refilling with updated data.
-    // https://www.khronos.org/opengl/wiki/Buffer_Object_Streaming#Buffer_re-specification
+static VALUE RGSS_Emitter_Update(VALUE self, VALUE delta)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
+    rb_call_super(1, &delta);
+
+    if (e->particles.block == NULL)
+        return Qnil;
+    RGSS_Particles_Govern();
+    RGSS_Emitter_Throttle(e);
+    RGSS_Emitter_Prepare(e, NUM2FLT(delta));
+
+    // Particles that cannot be seen are left as they are until they can be, without emitting or uploading any
+    e->culled = RGSS_Emitter_Cull(e);
+    if (e->culled)
+    {
+        e->pending = false;
+        return Qnil;
+    }
+
+    if (RGSS_EMITTER_DEFERRED)
+    {
+        e->pending = true;
+        return Qnil;
+    }
+
+    e->pending = false;
+    double start = glfwGetTime();
+    RGSS_Emitter_Simulate(e);
+    RGSS_PARTICLE_BUDGET.elapsed += glfwGetTime() - start;
+    RGSS_Emitter_Finish(e);
+    return Qnil;
+}
+
+static VALUE RGSS_Emitter_UpdateEach(VALUE args)
+{
+    VALUE *argv = (VALUE *)args;
+    RGSS_EMITTER_DEFERRED = true;
+    for (long i = 0; i < RARRAY_LEN(argv[0]); i++)
+        rb_funcall(rb_ary_entry(argv[0], i), RGSS_ID_UPDATE, 1, argv[1]);
+    return Qnil;
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, e->quad_vbo);
-    glBufferData(GL_ARRAY_BUFFER, e->capacity * PARTICLE_QUAD_SIZE, NULL, GL_STREAM_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, count * PARTICLE_QUAD_SIZE, e->quads);
+static VALUE RGSS_Emitter_EndDeferred(VALUE unused)
+{
+    RGSS_EMITTER_DEFERRED = false;
+    return Qnil;
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, e->color_vbo);
-    glBufferData(GL_ARRAY_BUFFER, e->capacity * PARTICLE_COLOR_SIZE, NULL, GL_STREAM_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, count * PARTICLE_COLOR_SIZE, e->colors);
+typedef struct
+{
+    RGSS_Emitter **emitters; /** The emitters to simulate. */
+    int count;               /** The number of emitters. */
+} RGSS_EmitterBatch;
 
-    glBindBuffer(GL_ARRAY_BUFFER, e->angle_vbo);
-    glBufferData(GL_ARRAY_BUFFER, e->capacity * SIZEOF_FLOAT, NULL, GL_STREAM_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, count * SIZEOF_FLOAT, e->angles);
+static VALUE RGSS_Emitter_SimulateBatch(VALUE value)
+{
+    RGSS_EmitterBatch *batch = (RGSS_EmitterBatch *)value;
+    RGSS_Parallel_ForNoGVL(batch->count, 1, RGSS_Emitter_SimulateRange, batch->emitters);
+    return Qnil;
+}
 
+static VALUE RGSS_Emitter_EndBatch(VALUE value)
+{
+    RGSS_EmitterBatch *batch = (RGSS_EmitterBatch *)value;
+    for (int i = 0; i < batch->count; i++)
+        batch->emitters[i]->busy = false;
     return Qnil;
 }
 
+static VALUE RGSS_Emitter_UpdateAll(VALUE klass, VALUE emitters, VALUE delta)
+{
+    // Update each emitter as usual, which includes overrides of update, but stop short of emitting particles
+    VALUE args[2] = {rb_Array(emitters), delta};
+    rb_ensure(RGSS_Emitter_UpdateEach, (VALUE)args, RGSS_Emitter_EndDeferred, Qnil);
+
+    VALUE buffer;
+    long len = RARRAY_LEN(args[0]);
+    RGSS_Emitter **pending = ALLOCV_N(RGSS_Emitter *, buffer, RGSS_MAX(len, 1));
+    int count = 0;
+    for (long i = 0; i < len; i++)
+    {
+        VALUE emitter = rb_ary_entry(args[0], i);
+        if (!rb_obj_is_kind_of(emitter, rb_cEmitter))
+            continue;
+        RGSS_Emitter *e = DATA_PTR(emitter);
+        if (e->pending && e->particles.block != NULL)
+        {
+            e->busy = true;
+            pending[count++] = e;
+        }
+        e->pending = false;
+    }
+
+    // Each emitter only touches its own particles, palette, and random numbers, so they are emitted and simulated in
+    // parallel. They are marked busy until all of them are finished, and OpenGL is only used from this thread after.
+    RGSS_EmitterBatch batch = {pending, count};
+    double start = glfwGetTime();
+    rb_ensure(RGSS_Emitter_SimulateBatch, (VALUE)&batch, RGSS_Emitter_EndBatch, (VALUE)&batch);
+    RGSS_PARTICLE_BUDGET.elapsed += glfwGetTime() - start;
+    for (int i = 0; i < count; i++)
+        RGSS_Emitter_Finish(pending[i]);
+
+    ALLOCV_END(buffer);
+    RB_GC_GUARD(args[0]);
+    return args[0];
+}
+
+static VALUE RGSS_Emitter_Prewarm(VALUE self, VALUE ticks)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
+    int count = NUM2INT(ticks);
+    if (count < 0)
+        rb_raise(rb_eArgError, "ticks cannot be negative (given %d)", count);
+    if (e->particles.block == NULL)
+        return self;
+
+    // Advance a full tick at a time, only uploading the result of the last one. This does not count against the
+    // time budget, as it is only done once, but the particles it creates do.
+    RGSS_Emitter_Throttle(e);
+    RGSS_Emitter_Prepare(e, 1.0f);
+    for (int i = 0; i < count; i++)
+        RGSS_Emitter_Simulate(e);
+    e->culled = false;
+    RGSS_Emitter_Finish(e);
+    return self;
+}
+
+static VALUE RGSS_Emitter_IsCulled(VALUE self)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    return RB_BOOL(e->culled);
+}
+
 ATTR_ACCESSOR(RGSS_Emitter, Gravity, gravity, DBL2NUM, NUM2FLT)
 ATTR_ACCESSOR(RGSS_Emitter, Wind, wind, DBL2NUM, NUM2FLT)
 ATTR_READER(RGSS_Emitter, Radius, radius, DBL2NUM)
@@ -583,6 +1316,7 @@ ATTR_READER(RGSS_Emitter, Radius, radius, DBL2NUM)
 static VALUE RGSS_Emitter_SetRadius(VALUE self, VALUE value)
 {
     RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
     if (NIL_P(value))
     {
         // Distance from the center of screen to corner (full resolution coverage)
@@ -617,11 +1351,93 @@ EMITTER_SET_RANGE(ParticleSize, size)
 
 ATTR_READER(RGSS_Emitter, Interval, interval, INT2NUM)
 ATTR_READER(RGSS_Emitter, Capacity, capacity, INT2NUM)
+ATTR_READER(RGSS_Emitter, Count, count, UINT2NUM)
+
+static VALUE RGSS_Emitter_GetOverflow(VALUE self)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    return INT2NUM(e->overflow);
+}
+
+static VALUE RGSS_Emitter_SetOverflow(VALUE self, VALUE value)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
+    int policy = NUM2INT(value);
+    if (policy != RGSS_OVERFLOW_DROP && policy != RGSS_OVERFLOW_REPLACE)
+        rb_raise(rb_eArgError, "invalid overflow policy (given %d)", policy);
+    e->overflow = policy;
+    return value;
+}
+
+static VALUE RGSS_Emitter_GetStats(VALUE self)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, STR2SYM("count"), UINT2NUM(e->count));
+    rb_hash_aset(hash, STR2SYM("capacity"), UINT2NUM(e->capacity));
+    rb_hash_aset(hash, STR2SYM("overflows"), ULONG2NUM(e->overflows));
+    rb_hash_aset(hash, STR2SYM("scale"), DBL2NUM(e->scale));
+    return hash;
+}
+
 ATTR_ACCESSOR(RGSS_Emitter, Order, order, INT2NUM, NUM2INT)
+ATTR_READER(RGSS_Emitter, Priority, priority, DBL2NUM)
+
+static VALUE RGSS_Emitter_SetPriority(VALUE self, VALUE value)
+{
+    RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
+    e->priority = RGSS_MAX(NUM2FLT(value), 0.0f);
+    return value;
+}
+
+static VALUE RGSS_Emitter_GetBudget(VALUE klass)
+{
+    return RGSS_PARTICLE_BUDGET.limit ? UINT2NUM(RGSS_PARTICLE_BUDGET.limit) : Qnil;
+}
+
+static VALUE RGSS_Emitter_SetBudget(VALUE klass, VALUE value)
+{
+    RGSS_PARTICLE_BUDGET.limit = NIL_P(value) ? 0 : NUM2UINT(value);
+    return value;
+}
+
+static VALUE RGSS_Emitter_GetTimeBudget(VALUE klass)
+{
+    return RGSS_PARTICLE_BUDGET.time_limit > 0.0 ? DBL2NUM(RGSS_PARTICLE_BUDGET.time_limit * 1000.0) : Qnil;
+}
+
+static VALUE RGSS_Emitter_SetTimeBudget(VALUE klass, VALUE value)
+{
+    RGSS_PARTICLE_BUDGET.time_limit = NIL_P(value) ? 0.0 : RGSS_MAX(NUM2DBL(value), 0.0) / 1000.0;
+    return value;
+}
+
+static VALUE RGSS_Emitter_GetLodDistance(VALUE klass)
+{
+    return RGSS_PARTICLE_BUDGET.falloff > 0.0 ? DBL2NUM(RGSS_PARTICLE_BUDGET.falloff) : Qnil;
+}
+
+static VALUE RGSS_Emitter_SetLodDistance(VALUE klass, VALUE value)
+{
+    RGSS_PARTICLE_BUDGET.falloff = NIL_P(value) ? 0.0 : RGSS_MAX(NUM2DBL(value), 0.0);
+    return value;
+}
+
+static VALUE RGSS_Emitter_GetBudgetStats(VALUE klass)
+{
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, STR2SYM("live"), UINT2NUM(RGSS_PARTICLE_BUDGET.live));
+    rb_hash_aset(hash, STR2SYM("time"), DBL2NUM(RGSS_PARTICLE_BUDGET.time * 1000.0));
+    rb_hash_aset(hash, STR2SYM("scale"), DBL2NUM(RGSS_PARTICLE_BUDGET.scale));
+    return hash;
+}
 
 static VALUE RGSS_Emitter_SetDirection(VALUE self, VALUE value)
 {
     RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
     if (NIL_P(value))
         e->direction = (RGSS_Range){0.0f, 360.0f};
     else
@@ -638,6 +1454,7 @@ static VALUE RGSS_Emitter_GetFriction(VALUE self)
 static VALUE RGSS_Emitter_SetFriction(VALUE self, VALUE value)
 {
     RGSS_Emitter *e = DATA_PTR(self);
+    RGSS_ASSERT_EMITTER_IDLE(e);
     if (rb_obj_is_kind_of(value, rb_cVec2))
         memcpy(e->friction, DATA_PTR(value), RGSS_VEC2_SIZE);
     else
@@ -682,13 +1499,14 @@ static VALUE RGSS_Emitter_Initialize(int argc, VALUE *argv, VALUE self)
     e->direction = (RGSS_Range){0.0f, 360.0f};
     e->interval = -1;
     e->frequency = (RGSS_Range){-1.0f, -1.0f};
-    e->order = -1;
+    e->order = 0;
 
     // Initialize buffers
-    e->particles = RGSS_Emitter_CreateStorage(e, sizeof(RGSS_Particle));
-    e->quads = RGSS_Emitter_CreateStorage(e, PARTICLE_QUAD_SIZE);
-    e->colors = RGSS_Emitter_CreateStorage(e, PARTICLE_COLOR_SIZE);
-    e->angles = RGSS_Emitter_CreateStorage(e, SIZEOF_FLOAT);
+    RGSS_Particles_Alloc(&e->particles, e->capacity);
+    e->instances = RGSS_Emitter_CreateStorage(e, sizeof(RGSS_ParticleInstance));
+
+    // Allocated up front even when unordered, as the order may change and sorting may run without the GVL
+    e->sort = RGSS_Emitter_CreateStorage(e, (sizeof(GLuint) * 4) + sizeof(RGSS_ParticleInstance));
 
     RGSS_Emitter_VertexSetup(e, e->capacity);
 
@@ -753,18 +1571,34 @@ void RGSS_Init_Particles(VALUE parent)
     DEFINE_ACCESSOR(rb_cEmitter, RGSS_Emitter, Frequency, "frequency");
     DEFINE_ACCESSOR(rb_cEmitter, RGSS_Emitter, ParticleSize, "particle_size");
     DEFINE_ACCESSOR(rb_cEmitter, RGSS_Emitter, Order, "order");
+    DEFINE_ACCESSOR(rb_cEmitter, RGSS_Emitter, Overflow, "overflow");
+    DEFINE_ACCESSOR(rb_cEmitter, RGSS_Emitter, Priority, "priority");
 
     rb_define_method0(rb_cEmitter, "capacity", RGSS_Emitter_GetCapacity, 0);
     rb_define_method0(rb_cEmitter, "interval", RGSS_Emitter_GetInterval, 0);
+    rb_define_method0(rb_cEmitter, "count", RGSS_Emitter_GetCount, 0);
+    rb_define_method0(rb_cEmitter, "stats", RGSS_Emitter_GetStats, 0);
     rb_define_method0(rb_cEmitter, "pause", RGSS_Emitter_Pause, 0);
     rb_define_method0(rb_cEmitter, "paused?", RGSS_Emitter_IsPaused, 0);
     rb_define_method0(rb_cEmitter, "resume", RGSS_Emitter_Resume, 0);
     rb_define_method0(rb_cEmitter, "dispose", RGSS_Emitter_Dispose, 0);
     rb_define_method1(rb_cEmitter, "update", RGSS_Emitter_Update, 1);
     rb_define_method1(rb_cEmitter, "render", RGSS_Emitter_Render, 1);
+    rb_define_method1(rb_cEmitter, "prewarm", RGSS_Emitter_Prewarm, 1);
+    rb_define_method0(rb_cEmitter, "culled?", RGSS_Emitter_IsCulled, 0);
     rb_define_method0(rb_cEmitter, "fullscreen", RGSS_Emitter_FullScreen, 0);
+    rb_define_singleton_method2(rb_cEmitter, "update_all", RGSS_Emitter_UpdateAll, 2);
+    rb_define_singleton_method0(rb_cEmitter, "budget", RGSS_Emitter_GetBudget, 0);
+    rb_define_singleton_method1(rb_cEmitter, "budget=", RGSS_Emitter_SetBudget, 1);
+    rb_define_singleton_method0(rb_cEmitter, "time_budget", RGSS_Emitter_GetTimeBudget, 0);
+    rb_define_singleton_method1(rb_cEmitter, "time_budget=", RGSS_Emitter_SetTimeBudget, 1);
+    rb_define_singleton_method0(rb_cEmitter, "lod_distance", RGSS_Emitter_GetLodDistance, 0);
+    rb_define_singleton_method1(rb_cEmitter, "lod_distance=", RGSS_Emitter_SetLodDistance, 1);
+    rb_define_singleton_method0(rb_cEmitter, "budget_stats", RGSS_Emitter_GetBudgetStats, 0);
 
     rb_define_const(rb_cEmitter, "EARTH_GRAVITY", DBL2NUM(9.81));
     rb_define_const(rb_cEmitter, "ORDER_YOUNGEST", INT2NUM(-1));
     rb_define_const(rb_cEmitter, "ORDER_OLDEST", INT2NUM(1));
+    rb_define_const(rb_cEmitter, "OVERFLOW_DROP", INT2NUM(RGSS_OVERFLOW_DROP));
+    rb_define_const(rb_cEmitter, "OVERFLOW_REPLACE", INT2NUM(RGSS_OVERFLOW_REPLACE));
 }
\ No newline at end of file
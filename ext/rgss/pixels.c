@@ -0,0 +1,630 @@
+#include "pixels.h"
+
+// Pixels are tightly packed RGBA bytes, which are read as little-endian 32-bit integers (alpha in the high byte).
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RGSS_PIXELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is not part of the x86-64 baseline, so those kernels are compiled for it separately and selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RGSS_PIXELS_AVX2 1
+#define RGSS_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+static inline uint32_t RGSS_Div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline uint32_t RGSS_Pixels_BlendPixel(uint32_t d, uint32_t s, int opacity)
+{
+    uint32_t a = RGSS_Div255((s >> 24) * opacity);
+    if (a == 0)
+        return d;
+
+    uint32_t inv = 255 - a, result = 0;
+    for (int shift = 0; shift < 24; shift += 8)
+        result |= RGSS_Div255(((s >> shift) & 0xFF) * a + ((d >> shift) & 0xFF) * inv) << shift;
+    return result | (RGSS_Div255(255 * a + (d >> 24) * inv) << 24);
+}
+
+#ifdef RGSS_PIXELS_AVX2
+
+static inline int RGSS_Pixels_HasAVX2(void)
+{
+    static int supported = -1;
+    if (supported < 0)
+    {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") != 0;
+    }
+    return supported;
+}
+
+RGSS_TARGET_AVX2 static int RGSS_Pixels_FillAVX2(uint32_t *row, int count, uint32_t color)
+{
+    const __m256i value = _mm256_set1_epi32((int)color);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i *)(row + i), value);
+    return i;
+}
+
+RGSS_TARGET_AVX2 static inline __m256i RGSS_Div255_AVX2(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+RGSS_TARGET_AVX2 static inline __m256i RGSS_BlendWide_AVX2(__m256i s, __m256i d, __m256i opacity)
+{
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+    a = RGSS_Div255_AVX2(_mm256_mullo_epi16(a, opacity));
+    s = _mm256_or_si256(s, _mm256_set1_epi64x(0x00FF000000000000LL));
+    __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+    return RGSS_Div255_AVX2(_mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, inv)));
+}
+
+RGSS_TARGET_AVX2 static int RGSS_Pixels_BlendAVX2(uint32_t *dst, const uint32_t *src, int count, int opacity)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+    const __m256i op = _mm256_set1_epi16((short)opacity);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alpha), zero)) == -1)
+            continue;
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i lo = RGSS_BlendWide_AVX2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), op);
+        __m256i hi = RGSS_BlendWide_AVX2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), op);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+#endif /* RGSS_PIXELS_AVX2 */
+
+#ifdef RGSS_PIXELS_SSE2
+
+static inline __m128i RGSS_Div255_SSE2(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static inline __m128i RGSS_Blend_SSE2(__m128i s, __m128i d, __m128i opacity)
+{
+    // Broadcast the alpha of each pixel to its channels, then output alpha is computed as a "channel" of 255
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+    a = RGSS_Div255_SSE2(_mm_mullo_epi16(a, opacity));
+    s = _mm_or_si128(s, _mm_set1_epi64x(0x00FF000000000000LL));
+    __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    return RGSS_Div255_SSE2(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, inv)));
+}
+
+static int RGSS_Pixels_BlendSSE2(uint32_t *dst, const uint32_t *src, int count, int opacity)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    const __m128i op = _mm_set1_epi16((short)opacity);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha), zero)) == 0xFFFF)
+            continue;
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i lo = RGSS_Blend_SSE2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), op);
+        __m128i hi = RGSS_Blend_SSE2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), op);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+static inline __m128i RGSS_Expand_SSE2(uint32_t pixel)
+{
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)pixel), zero), zero);
+}
+
+static inline uint32_t RGSS_Pack_SSE2(__m128 channels)
+{
+    __m128i value = _mm_cvtps_epi32(channels);
+    value = _mm_packs_epi32(value, value);
+    return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(value, value));
+}
+
+static int RGSS_Pixels_ColorMatrixSSE2(uint32_t *row, int count, const float *m)
+{
+    const __m128 red = _mm_setr_ps(m[0], m[4], m[8], 0.0f);
+    const __m128 green = _mm_setr_ps(m[1], m[5], m[9], 0.0f);
+    const __m128 blue = _mm_setr_ps(m[2], m[6], m[10], 0.0f);
+    const __m128 alpha = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    const __m128 offset = _mm_setr_ps(m[3] * 255.0f, m[7] * 255.0f, m[11] * 255.0f, 0.0f);
+
+    for (int i = 0; i < count; i++)
+    {
+        __m128 c = _mm_cvtepi32_ps(RGSS_Expand_SSE2(row[i]));
+        __m128 result = _mm_add_ps(offset, _mm_mul_ps(red, _mm_shuffle_ps(c, c, 0x00)));
+        result = _mm_add_ps(result, _mm_mul_ps(green, _mm_shuffle_ps(c, c, 0x55)));
+        result = _mm_add_ps(result, _mm_mul_ps(blue, _mm_shuffle_ps(c, c, 0xAA)));
+        result = _mm_add_ps(result, _mm_mul_ps(alpha, _mm_shuffle_ps(c, c, 0xFF)));
+        row[i] = RGSS_Pack_SSE2(result);
+    }
+    return count;
+}
+
+#endif /* RGSS_PIXELS_SSE2 */
+
+void RGSS_Pixels_Fill(uint32_t *pixels, int stride, int width, int height, uint32_t color)
+{
+    for (int y = 0; y < height; y++)
+    {
+        uint32_t *row = pixels + (size_t)y * stride;
+        int x = 0;
+#ifdef RGSS_PIXELS_AVX2
+        if (RGSS_Pixels_HasAVX2())
+            x = RGSS_Pixels_FillAVX2(row, width, color);
+#endif
+#ifdef RGSS_PIXELS_SSE2
+        const __m128i value = _mm_set1_epi32((int)color);
+        for (; x + 4 <= width; x += 4)
+            _mm_storeu_si128((__m128i *)(row + x), value);
+#endif
+        for (; x < width; x++)
+            row[x] = color;
+    }
+}
+
+void RGSS_Pixels_BlendRow(uint32_t *dst, const uint32_t *src, int count, int opacity)
+{
+    if (opacity <= 0)
+        return;
+    opacity = RGSS_MIN(opacity, 255);
+
+    int i = 0;
+#ifdef RGSS_PIXELS_AVX2
+    if (RGSS_Pixels_HasAVX2())
+        i = RGSS_Pixels_BlendAVX2(dst, src, count, opacity);
+#endif
+#ifdef RGSS_PIXELS_SSE2
+    i += RGSS_Pixels_BlendSSE2(dst + i, src + i, count - i, opacity);
+#endif
+    for (; i < count; i++)
+        dst[i] = RGSS_Pixels_BlendPixel(dst[i], src[i], opacity);
+}
+
+void RGSS_Pixels_StretchBlend(uint32_t *dst, const RGSS_Size *dst_size, const RGSS_Rect *dst_rect, const uint32_t *src,
+                              const RGSS_Size *src_size, const RGSS_Rect *src_rect, int opacity)
+{
+    if (opacity <= 0 || dst_rect->width < 1 || dst_rect->height < 1 || src_rect->width < 1 || src_rect->height < 1)
+        return;
+
+    int x0 = RGSS_MAX(dst_rect->x, 0);
+    int y0 = RGSS_MAX(dst_rect->y, 0);
+    int x1 = RGSS_MIN(dst_rect->x + dst_rect->width, dst_size->width);
+    int y1 = RGSS_MIN(dst_rect->y + dst_rect->height, dst_size->height);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    int count = x1 - x0;
+    int scaled = src_rect->width != dst_rect->width || src_rect->height != dst_rect->height;
+    int first = src_rect->x + (x0 - dst_rect->x);
+
+    // Unscaled spans that lie within the source are blended straight from the source rows
+    if (!scaled && first >= 0 && first + count <= src_size->width)
+    {
+        for (int y = y0; y < y1; y++)
+        {
+            int sy = src_rect->y + (y - dst_rect->y);
+            if (sy < 0 || sy >= src_size->height)
+                continue;
+            RGSS_Pixels_BlendRow(dst + (size_t)y * dst_size->width + x0, src + (size_t)sy * src_size->width + first,
+                                 count, opacity);
+        }
+        return;
+    }
+
+    // Otherwise each row is gathered with nearest-neighbor sampling, where samples outside the source are transparent
+    int *columns = malloc(count * sizeof(int));
+    uint32_t *row = malloc(count * sizeof(uint32_t));
+    if (columns && row)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            int sx = src_rect->x + (int)(((int64_t)(x0 + i - dst_rect->x) * src_rect->width) / dst_rect->width);
+            columns[i] = (sx < 0 || sx >= src_size->width) ? -1 : sx;
+        }
+
+        for (int y = y0; y < y1; y++)
+        {
+            int sy = src_rect->y + (int)(((int64_t)(y - dst_rect->y) * src_rect->height) / dst_rect->height);
+            if (sy < 0 || sy >= src_size->height)
+                continue;
+
+            const uint32_t *src_row = src + (size_t)sy * src_size->width;
+            for (int i = 0; i < count; i++)
+                row[i] = columns[i] < 0 ? 0 : src_row[columns[i]];
+            RGSS_Pixels_BlendRow(dst + (size_t)y * dst_size->width + x0, row, count, opacity);
+        }
+    }
+    free(columns);
+    free(row);
+}
+
+void RGSS_Pixels_ColorMatrix(uint32_t *pixels, int stride, int width, int height, const float matrix[12])
+{
+    for (int y = 0; y < height; y++)
+    {
+        uint32_t *row = pixels + (size_t)y * stride;
+        int x = 0;
+#ifdef RGSS_PIXELS_SSE2
+        x = RGSS_Pixels_ColorMatrixSSE2(row, width, matrix);
+#endif
+        for (; x < width; x++)
+        {
+            const unsigned char *c = (const unsigned char *)&row[x];
+            unsigned char result[4];
+            for (int i = 0; i < 3; i++)
+            {
+                const float *m = &matrix[i * 4];
+                float value = m[0] * c[0] + m[1] * c[1] + m[2] * c[2] + m[3] * 255.0f;
+                result[i] = (unsigned char)glm_clamp(roundf(value), 0.0f, 255.0f);
+            }
+            result[3] = c[3];
+            memcpy(&row[x], result, sizeof(uint32_t));
+        }
+    }
+}
+
+void RGSS_Pixels_HueToneMatrix(float hue, const float *tone, float matrix[12])
+{
+    // Rotation about the gray axis as done by the sprite shader, followed by desaturation and the tone offset
+    const float k = 0.57735f;
+    float c = cosf(glm_rad(hue)), s = sinf(glm_rad(hue)) * k, t = k * k * (1.0f - c);
+    const float h[9] = {c + t, t - s, t + s, t + s, c + t, t - s, t - s, t + s, c + t};
+    float gray = tone ? tone[3] : 0.0f;
+
+    for (int row = 0; row < 3; row++)
+    {
+        for (int col = 0; col < 3; col++)
+        {
+            float avg = (h[col] + h[3 + col] + h[6 + col]) / 3.0f;
+            matrix[row * 4 + col] = h[row * 3 + col] * (1.0f - gray) + avg * gray;
+        }
+        matrix[row * 4 + 3] = tone ? tone[row] : 0.0f;
+    }
+}
+
+static void RGSS_Pixels_BlurLine(uint32_t *line, size_t step, int count, int radius, uint32_t *scratch)
+{
+    for (int i = 0; i < count; i++)
+        scratch[i] = line[i * step];
+
+    const float scale = 1.0f / (radius * 2 + 1);
+#ifdef RGSS_PIXELS_SSE2
+    __m128i sum = _mm_setzero_si128();
+    for (int i = -radius; i <= radius; i++)
+        sum = _mm_add_epi32(sum, RGSS_Expand_SSE2(scratch[RGSS_MAX(0, RGSS_MIN(i, count - 1))]));
+
+    const __m128 inv = _mm_set1_ps(scale);
+    for (int x = 0; x < count; x++)
+    {
+        line[x * step] = RGSS_Pack_SSE2(_mm_mul_ps(_mm_cvtepi32_ps(sum), inv));
+        sum = _mm_add_epi32(sum, RGSS_Expand_SSE2(scratch[RGSS_MIN(x + radius + 1, count - 1)]));
+        sum = _mm_sub_epi32(sum, RGSS_Expand_SSE2(scratch[RGSS_MAX(x - radius, 0)]));
+    }
+#else
+    int sum[4] = {0, 0, 0, 0};
+    for (int i = -radius; i <= radius; i++)
+    {
+        const unsigned char *c = (const unsigned char *)&scratch[RGSS_MAX(0, RGSS_MIN(i, count - 1))];
+        for (int j = 0; j < 4; j++)
+            sum[j] += c[j];
+    }
+
+    for (int x = 0; x < count; x++)
+    {
+        unsigned char *out = (unsigned char *)&line[x * step];
+        const unsigned char *add = (const unsigned char *)&scratch[RGSS_MIN(x + radius + 1, count - 1)];
+        const unsigned char *sub = (const unsigned char *)&scratch[RGSS_MAX(x - radius, 0)];
+        for (int j = 0; j < 4; j++)
+        {
+            out[j] = (unsigned char)roundf(sum[j] * scale);
+            sum[j] += add[j] - sub[j];
+        }
+    }
+#endif
+}
+
+void RGSS_Pixels_BoxBlur(uint32_t *pixels, int stride, int width, int height, int radius)
+{
+    if (radius < 1 || width < 1 || height < 1)
+        return;
+
+    uint32_t *scratch = malloc(RGSS_MAX(width, height) * sizeof(uint32_t));
+    if (scratch == NULL)
+        return;
+
+    for (int y = 0; y < height; y++)
+        RGSS_Pixels_BlurLine(pixels + (size_t)y * stride, 1, width, radius, scratch);
+    for (int x = 0; x < width; x++)
+        RGSS_Pixels_BlurLine(pixels + x, (size_t)stride, height, radius, scratch);
+
+    free(scratch);
+}
+
+static float RGSS_Filter_Box(float x)
+{
+    return (x > -0.5f && x <= 0.5f) ? 1.0f : 0.0f;
+}
+
+static float RGSS_Filter_Triangle(float x)
+{
+    x = fabsf(x);
+    return x < 1.0f ? 1.0f - x : 0.0f;
+}
+
+static inline float RGSS_Sinc(float x)
+{
+    if (x == 0.0f)
+        return 1.0f;
+    x *= GLM_PIf;
+    return sinf(x) / x;
+}
+
+static float RGSS_Filter_Lanczos(float x)
+{
+    return (x > -3.0f && x < 3.0f) ? RGSS_Sinc(x) * RGSS_Sinc(x / 3.0f) : 0.0f;
+}
+
+int RGSS_Resampler_Init(RGSS_Resampler *resampler, int src_size, int dst_size, RGSS_Filter filter)
+{
+    float (*func)(float);
+    float support;
+    switch (filter)
+    {
+        case RGSS_FILTER_BOX: func = RGSS_Filter_Box, support = 0.5f; break;
+        case RGSS_FILTER_LANCZOS: func = RGSS_Filter_Lanczos, support = 3.0f; break;
+        default: func = RGSS_Filter_Triangle, support = 1.0f; break;
+    }
+
+    // When reducing, the filter is stretched to cover every input sample, so none are skipped over
+    float scale = (float)src_size / dst_size;
+    float stretch = RGSS_MAX(scale, 1.0f);
+    support *= stretch;
+
+    resampler->taps = (int)ceilf(support) * 2 + 1;
+    resampler->first = malloc(dst_size * 2 * sizeof(int));
+    resampler->count = resampler->first + dst_size;
+    resampler->weights = malloc((size_t)dst_size * resampler->taps * sizeof(float));
+    if (resampler->first == NULL || resampler->weights == NULL)
+    {
+        RGSS_Resampler_Free(resampler);
+        return false;
+    }
+
+    for (int i = 0; i < dst_size; i++)
+    {
+        float center = (i + 0.5f) * scale;
+        int lo = RGSS_MAX((int)(center - support + 0.5f), 0);
+        int hi = RGSS_MIN((int)(center + support + 0.5f), src_size);
+        int count = RGSS_MAX(RGSS_MIN(hi - lo, resampler->taps), 0);
+
+        float *weights = resampler->weights + (size_t)i * resampler->taps;
+        float total = 0.0f;
+        for (int j = 0; j < count; j++)
+        {
+            weights[j] = func((lo + j - center + 0.5f) / stretch);
+            total += weights[j];
+        }
+        if (total != 0.0f)
+        {
+            for (int j = 0; j < count; j++)
+                weights[j] /= total;
+        }
+
+        resampler->first[i] = lo;
+        resampler->count[i] = count;
+    }
+    return true;
+}
+
+void RGSS_Resampler_Free(RGSS_Resampler *resampler)
+{
+    free(resampler->first);
+    free(resampler->weights);
+    resampler->first = NULL;
+    resampler->count = NULL;
+    resampler->weights = NULL;
+}
+
+void RGSS_Pixels_ResampleRow(const RGSS_Resampler *resampler, const uint32_t *src, int src_width, int dst_width,
+                             float *scratch, float *dst)
+{
+    // Colors are premultiplied while filtering, otherwise transparent pixels bleed their color into the edges
+#ifdef RGSS_PIXELS_SSE2
+    const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 rgb = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 one = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    for (int x = 0; x < src_width; x++)
+    {
+        __m128 c = _mm_cvtepi32_ps(RGSS_Expand_SSE2(src[x]));
+        __m128 a = _mm_mul_ps(_mm_shuffle_ps(c, c, 0xFF), inv255);
+        _mm_storeu_ps(scratch + x * 4, _mm_mul_ps(c, _mm_or_ps(_mm_and_ps(a, rgb), one)));
+    }
+
+    for (int x = 0; x < dst_width; x++)
+    {
+        const float *weights = resampler->weights + (size_t)x * resampler->taps;
+        const float *s = scratch + resampler->first[x] * 4;
+        __m128 sum = _mm_setzero_ps();
+        for (int t = 0; t < resampler->count[x]; t++)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(s + t * 4)));
+        _mm_storeu_ps(dst + x * 4, sum);
+    }
+#else
+    for (int x = 0; x < src_width; x++)
+    {
+        const unsigned char *c = (const unsigned char *)&src[x];
+        float a = c[3] / 255.0f;
+        scratch[x * 4 + 0] = c[0] * a;
+        scratch[x * 4 + 1] = c[1] * a;
+        scratch[x * 4 + 2] = c[2] * a;
+        scratch[x * 4 + 3] = c[3];
+    }
+
+    for (int x = 0; x < dst_width; x++)
+    {
+        const float *weights = resampler->weights + (size_t)x * resampler->taps;
+        const float *s = scratch + resampler->first[x] * 4;
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int t = 0; t < resampler->count[x]; t++)
+        {
+            for (int j = 0; j < 4; j++)
+                sum[j] += weights[t] * s[t * 4 + j];
+        }
+        memcpy(dst + x * 4, sum, sizeof(sum));
+    }
+#endif
+}
+
+void RGSS_Pixels_ResampleColumns(const RGSS_Resampler *resampler, int index, const float *rows, int width,
+                                 uint32_t *dst)
+{
+    const float *weights = resampler->weights + (size_t)index * resampler->taps;
+    const size_t stride = (size_t)width * 4;
+    const int count = resampler->count[index];
+
+#ifdef RGSS_PIXELS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    const __m128 rgb = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 one = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    for (int x = 0; x < width; x++)
+    {
+        __m128 sum = zero;
+        for (int t = 0; t < count; t++)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(rows + t * stride + x * 4)));
+
+        // Filters with negative lobes can overshoot, so alpha is clamped before it is divided out
+        sum = _mm_min_ps(_mm_max_ps(sum, zero), max);
+        __m128 a = _mm_shuffle_ps(sum, sum, 0xFF);
+        __m128 scale = _mm_and_ps(_mm_div_ps(max, a), _mm_cmpgt_ps(a, zero));
+        dst[x] = RGSS_Pack_SSE2(_mm_mul_ps(sum, _mm_or_ps(_mm_and_ps(scale, rgb), one)));
+    }
+#else
+    for (int x = 0; x < width; x++)
+    {
+        float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int t = 0; t < count; t++)
+        {
+            for (int j = 0; j < 4; j++)
+                sum[j] += weights[t] * rows[t * stride + x * 4 + j];
+        }
+
+        unsigned char *out = (unsigned char *)&dst[x];
+        float a = glm_clamp(sum[3], 0.0f, 255.0f);
+        float scale = a > 0.0f ? 255.0f / a : 0.0f;
+        for (int j = 0; j < 3; j++)
+            out[j] = (unsigned char)glm_clamp(roundf(sum[j] * scale), 0.0f, 255.0f);
+        out[3] = (unsigned char)roundf(a);
+    }
+#endif
+}
+
+void RGSS_Pixels_Premultiply(uint32_t *pixels, int count)
+{
+    int i = 0;
+#ifdef RGSS_PIXELS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi64x(0x00FF000000000000LL);
+    for (; i + 4 <= count; i += 4)
+    {
+        // Alpha is multiplied by 255, leaving it unchanged
+        __m128i p = _mm_loadu_si128((const __m128i *)(pixels + i));
+        __m128i lo = _mm_unpacklo_epi8(p, zero), hi = _mm_unpackhi_epi8(p, zero);
+        __m128i alo = _mm_or_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF), alpha);
+        __m128i ahi = _mm_or_si128(_mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF), alpha);
+        lo = RGSS_Div255_SSE2(_mm_mullo_epi16(lo, alo));
+        hi = RGSS_Div255_SSE2(_mm_mullo_epi16(hi, ahi));
+        _mm_storeu_si128((__m128i *)(pixels + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t p = pixels[i], a = p >> 24, result = p & 0xFF000000;
+        for (int shift = 0; shift < 24; shift += 8)
+            result |= RGSS_Div255(((p >> shift) & 0xFF) * a) << shift;
+        pixels[i] = result;
+    }
+}
+
+void RGSS_Pixels_Unpremultiply(uint32_t *pixels, int count)
+{
+    int i = 0;
+#ifdef RGSS_PIXELS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    const __m128 rgb = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 one = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    for (; i < count; i++)
+    {
+        __m128 c = _mm_cvtepi32_ps(RGSS_Expand_SSE2(pixels[i]));
+        __m128 a = _mm_shuffle_ps(c, c, 0xFF);
+        __m128 scale = _mm_and_ps(_mm_div_ps(max, a), _mm_cmpgt_ps(a, zero));
+        pixels[i] = RGSS_Pack_SSE2(_mm_mul_ps(c, _mm_or_ps(_mm_and_ps(scale, rgb), one)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t p = pixels[i], a = p >> 24, result = p & 0xFF000000;
+        if (a == 0)
+        {
+            pixels[i] = 0;
+            continue;
+        }
+        for (int shift = 0; shift < 24; shift += 8)
+            result |= RGSS_MIN((((p >> shift) & 0xFF) * 255 + a / 2) / a, 255) << shift;
+        pixels[i] = result;
+    }
+}
+
+void RGSS_Pixels_Reverse(uint32_t *pixels, int count)
+{
+    int lo = 0, hi = count;
+#ifdef RGSS_PIXELS_SSE2
+    for (; hi - lo >= 8; lo += 4, hi -= 4)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(pixels + lo));
+        __m128i b = _mm_loadu_si128((const __m128i *)(pixels + hi - 4));
+        _mm_storeu_si128((__m128i *)(pixels + lo), _mm_shuffle_epi32(b, 0x1B));
+        _mm_storeu_si128((__m128i *)(pixels + hi - 4), _mm_shuffle_epi32(a, 0x1B));
+    }
+#endif
+    for (hi--; lo < hi; lo++, hi--)
+    {
+        uint32_t swap = pixels[lo];
+        pixels[lo] = pixels[hi];
+        pixels[hi] = swap;
+    }
+}
+
+void RGSS_Pixels_FromARGB(uint32_t *dst, const uint32_t *src, int count)
+{
+    unsigned char *bytes = (unsigned char *)dst;
+    for (int i = 0; i < count; i++, bytes += 4)
+    {
+        uint32_t argb = src[i];
+        bytes[0] = (unsigned char)(argb >> 16);
+        bytes[1] = (unsigned char)(argb >> 8);
+        bytes[2] = (unsigned char)argb;
+        bytes[3] = (unsigned char)(argb >> 24);
+    }
+}
@@ -0,0 +1,157 @@
+#ifndef RGSS_PIXELS_H
+#define RGSS_PIXELS_H 1
+
+#include "rgss.h"
+
+/**
+ * @brief Fills an area of a pixel buffer with a single color, replacing the existing pixels.
+ * @param[in] pixels A pointer to the first pixel of the area to fill.
+ * @param[in] stride The number of pixels between the start of each row.
+ * @param[in] width The width of the area, in pixels.
+ * @param[in] height The height of the area, in pixels.
+ * @param[in] color The packed RGBA color to fill with.
+ */
+void RGSS_Pixels_Fill(uint32_t *pixels, int stride, int width, int height, uint32_t color);
+
+/**
+ * @brief Alpha-blends a row of source pixels over a row of destination pixels.
+ * @param[in,out] dst The destination row.
+ * @param[in] src The source row, which must be at least @a count pixels long.
+ * @param[in] count The number of pixels to blend.
+ * @param[in] opacity A value between @c 0 and @c 255 the source alpha is multiplied by.
+ */
+void RGSS_Pixels_BlendRow(uint32_t *dst, const uint32_t *src, int count, int opacity);
+
+/**
+ * @brief Blends an area of a source buffer over an area of a destination buffer, scaling it with nearest-neighbor
+ * sampling when the sizes differ. Both areas are clipped to their respective buffer bounds.
+ * @param[in,out] dst The destination pixel buffer.
+ * @param[in] dst_size The dimensions of the destination buffer.
+ * @param[in] dst_rect The area of the destination to draw into.
+ * @param[in] src The source pixel buffer.
+ * @param[in] src_size The dimensions of the source buffer.
+ * @param[in] src_rect The area of the source to draw.
+ * @param[in] opacity A value between @c 0 and @c 255 the source alpha is multiplied by.
+ */
+void RGSS_Pixels_StretchBlend(uint32_t *dst, const RGSS_Size *dst_size, const RGSS_Rect *dst_rect, const uint32_t *src,
+                              const RGSS_Size *src_size, const RGSS_Rect *src_rect, int opacity);
+
+/**
+ * @brief Transforms the color channels of an area of pixels by a 3x4 matrix, leaving alpha unchanged.
+ * @param[in,out] pixels A pointer to the first pixel of the area.
+ * @param[in] stride The number of pixels between the start of each row.
+ * @param[in] width The width of the area, in pixels.
+ * @param[in] height The height of the area, in pixels.
+ * @param[in] matrix A row-major matrix, where each row holds the red, green, and blue factors and a constant offset
+ * of the resulting channel, in normalized units.
+ */
+void RGSS_Pixels_ColorMatrix(uint32_t *pixels, int stride, int width, int height, const float matrix[12]);
+
+/**
+ * @brief Computes a color matrix equivalent to the hue rotation and tone of the sprite shader.
+ * @param[in] hue The hue rotation, in degrees.
+ * @param[in] tone The tone to apply, or @c NULL for none.
+ * @param[out] matrix The resulting matrix, suitable for use with @ref RGSS_Pixels_ColorMatrix.
+ */
+void RGSS_Pixels_HueToneMatrix(float hue, const float *tone, float matrix[12]);
+
+/**
+ * @brief Applies a box blur to an area of pixels in-place, sampling clamped to the edges of the area.
+ * @param[in,out] pixels A pointer to the first pixel of the area.
+ * @param[in] stride The number of pixels between the start of each row.
+ * @param[in] width The width of the area, in pixels.
+ * @param[in] height The height of the area, in pixels.
+ * @param[in] radius The number of neighboring pixels on each side averaged with each pixel.
+ */
+void RGSS_Pixels_BoxBlur(uint32_t *pixels, int stride, int width, int height, int radius);
+
+/**
+ * @brief Describes the filter used to compute each output pixel when resampling an image.
+ */
+typedef enum
+{
+    RGSS_FILTER_BOX,      /** Averages the area each output pixel covers. */
+    RGSS_FILTER_BILINEAR, /** Linear interpolation, widened to a tent filter when reducing. */
+    RGSS_FILTER_LANCZOS   /** A three-lobed Lanczos windowed sinc, which is the sharpest and the most expensive. */
+} RGSS_Filter;
+
+/**
+ * @brief Precomputed contributions of input samples to each output sample along one axis of a resize.
+ */
+typedef struct
+{
+    int taps;       /** The maximum number of input samples that contribute to an output sample. */
+    int *first;     /** The index of the first input sample of each output sample. */
+    int *count;     /** The number of input samples that contribute to each output sample. */
+    float *weights; /** The normalized weights of each output sample, with a stride of @c taps. */
+} RGSS_Resampler;
+
+/**
+ * @brief Computes the sample weights for resizing along one axis.
+ * @param[out] resampler The resampler to initialize.
+ * @param[in] src_size The number of input samples.
+ * @param[in] dst_size The number of output samples.
+ * @param[in] filter The filter to use.
+ * @return @c true on success, otherwise @c false if memory could not be allocated.
+ */
+int RGSS_Resampler_Init(RGSS_Resampler *resampler, int src_size, int dst_size, RGSS_Filter filter);
+
+/**
+ * @brief Frees the memory used by a resampler.
+ * @param[in] resampler The resampler to free.
+ */
+void RGSS_Resampler_Free(RGSS_Resampler *resampler);
+
+/**
+ * @brief Resizes a row of pixels horizontally into premultiplied floating-point channels.
+ * @param[in] resampler The horizontal resampler.
+ * @param[in] src The source row.
+ * @param[in] src_width The width of the source row, in pixels.
+ * @param[in] dst_width The width of the output row, in pixels.
+ * @param[in] scratch A buffer of at least @c src_width * 4 floats.
+ * @param[out] dst The output row, @c dst_width * 4 floats.
+ */
+void RGSS_Pixels_ResampleRow(const RGSS_Resampler *resampler, const uint32_t *src, int src_width, int dst_width,
+                             float *scratch, float *dst);
+
+/**
+ * @brief Resizes vertically to produce a single output row, from rows produced by @ref RGSS_Pixels_ResampleRow.
+ * @param[in] resampler The vertical resampler.
+ * @param[in] index The index of the output row.
+ * @param[in] rows The horizontally resized rows, starting with the first row that contributes to the output row.
+ * @param[in] width The width of each row, in pixels.
+ * @param[out] dst The output row.
+ */
+void RGSS_Pixels_ResampleColumns(const RGSS_Resampler *resampler, int index, const float *rows, int width,
+                                 uint32_t *dst);
+
+/**
+ * @brief Multiplies the color channels of each pixel by its alpha.
+ * @param[in,out] pixels The pixels to convert.
+ * @param[in] count The number of pixels.
+ */
+void RGSS_Pixels_Premultiply(uint32_t *pixels, int count);
+
+/**
+ * @brief Divides the color channels of each pixel by its alpha, reversing @ref RGSS_Pixels_Premultiply.
+ * @param[in,out] pixels The pixels to convert.
+ * @param[in] count The number of pixels.
+ */
+void RGSS_Pixels_Unpremultiply(uint32_t *pixels, int count);
+
+/**
+ * @brief Reverses the order of a row of pixels in-place.
+ * @param[in,out] pixels The pixels to reverse.
+ * @param[in] count The number of pixels.
+ */
+void RGSS_Pixels_Reverse(uint32_t *pixels, int count);
+
+/**
+ * @brief Converts native-endian ARGB words, as used by Cairo, to packed RGBA pixels.
+ * @param[out] dst The converted pixels.
+ * @param[in] src The pixels to convert.
+ * @param[in] count The number of pixels.
+ */
+void RGSS_Pixels_FromARGB(uint32_t *dst, const uint32_t *src, int count);
+
+#endif /* RGSS_PIXELS_H */
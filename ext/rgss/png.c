@@ -0,0 +1,519 @@
+#include "png.h"
+#include "parallel.h"
+#include <pthread.h>
+
+// The approximate number of uncompressed bytes in each group of rows that is compressed independently
+#define RGSS_PNG_PART_SIZE (256 * 1024)
+
+#define RGSS_PNG_WINDOW 32768
+#define RGSS_PNG_WINDOW_MASK (RGSS_PNG_WINDOW - 1)
+#define RGSS_PNG_HASH_BITS 15
+#define RGSS_PNG_HASH_SIZE (1 << RGSS_PNG_HASH_BITS)
+#define RGSS_PNG_MIN_MATCH 3
+#define RGSS_PNG_MAX_MATCH 258
+
+typedef struct
+{
+    unsigned char *data; /** The encoded IDAT chunk, including its length, tag, and CRC. */
+    size_t size;         /** The size of the encoded chunk, in bytes. */
+    size_t raw_size;     /** The number of uncompressed bytes in the part. */
+    uint32_t adler;      /** The Adler-32 checksum of the uncompressed bytes. */
+} RGSS_PNGPart;
+
+typedef struct
+{
+    const unsigned char *pixels;
+    int width;
+    int height;
+    int level;
+    int rows; /** The number of rows in each part. */
+    RGSS_PNGPart *parts;
+    int failed;
+} RGSS_PNGJob;
+
+typedef struct
+{
+    unsigned char *out;
+    uint64_t bits;
+    int count;
+} RGSS_BitWriter;
+
+// Tables for the fixed Huffman codes of deflate, with codes stored bit-reversed as they are written LSB-first
+static struct
+{
+    uint16_t literal[288];
+    uint8_t literal_bits[288];
+    uint16_t length_symbol[RGSS_PNG_MAX_MATCH + 1];
+    uint16_t length_base[29];
+    uint8_t length_extra[29];
+    uint8_t distance_code[512];
+    uint16_t distance_base[30];
+    uint8_t distance_extra[30];
+    uint8_t distance_reversed[30];
+    uint32_t crc[256];
+} RGSS_PNG_TABLES;
+
+static pthread_once_t RGSS_PNG_ONCE = PTHREAD_ONCE_INIT;
+
+static uint32_t RGSS_PNG_Reverse(uint32_t code, int bits)
+{
+    uint32_t result = 0;
+    while (bits--)
+    {
+        result = (result << 1) | (code & 1);
+        code >>= 1;
+    }
+    return result;
+}
+
+static void RGSS_PNG_InitTables(void)
+{
+    for (int n = 0; n < 288; n++)
+    {
+        uint32_t code;
+        int bits;
+        if (n < 144)
+            code = 0x30 + n, bits = 8;
+        else if (n < 256)
+            code = 0x190 + n - 144, bits = 9;
+        else if (n < 280)
+            code = n - 256, bits = 7;
+        else
+            code = 0xC0 + n - 280, bits = 8;
+        RGSS_PNG_TABLES.literal[n] = (uint16_t)RGSS_PNG_Reverse(code, bits);
+        RGSS_PNG_TABLES.literal_bits[n] = (uint8_t)bits;
+    }
+
+    int length = 3;
+    for (int code = 0; code < 28; code++)
+    {
+        int extra = (code < 8) ? 0 : (code - 4) / 4;
+        RGSS_PNG_TABLES.length_base[code] = length;
+        RGSS_PNG_TABLES.length_extra[code] = extra;
+        for (int n = 0; n < (1 << extra); n++)
+            RGSS_PNG_TABLES.length_symbol[length++] = 257 + code;
+    }
+    // A length of 258 has its own code, rather than being the last of the previous one
+    RGSS_PNG_TABLES.length_base[28] = 258;
+    RGSS_PNG_TABLES.length_extra[28] = 0;
+    RGSS_PNG_TABLES.length_symbol[258] = 285;
+
+    // Indexed by distance - 1 when below 256, otherwise by 256 + ((distance - 1) >> 7)
+    int distance = 0;
+    for (int code = 0; code < 30; code++)
+    {
+        int extra = (code < 4) ? 0 : (code - 2) / 2;
+        RGSS_PNG_TABLES.distance_base[code] = distance + 1;
+        RGSS_PNG_TABLES.distance_extra[code] = extra;
+        RGSS_PNG_TABLES.distance_reversed[code] = (uint8_t)RGSS_PNG_Reverse(code, 5);
+        for (int n = 0; n < (1 << extra); n++, distance++)
+        {
+            if (distance < 256)
+                RGSS_PNG_TABLES.distance_code[distance] = code;
+            else
+                RGSS_PNG_TABLES.distance_code[256 + (distance >> 7)] = code;
+        }
+    }
+
+    for (uint32_t n = 0; n < 256; n++)
+    {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        RGSS_PNG_TABLES.crc[n] = c;
+    }
+}
+
+static uint32_t RGSS_PNG_CRC(uint32_t crc, const unsigned char *data, size_t size)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+        crc = RGSS_PNG_TABLES.crc[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t RGSS_PNG_Adler(const unsigned char *data, size_t size)
+{
+    uint32_t a = 1, b = 0;
+    while (size > 0)
+    {
+        size_t block = RGSS_MIN(size, 5552);
+        size -= block;
+        while (block--)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+static uint32_t RGSS_PNG_AdlerCombine(uint32_t adler1, uint32_t adler2, size_t size2)
+{
+    // Same as adler32_combine of zlib
+    const uint32_t base = 65521;
+    uint32_t rem = (uint32_t)(size2 % base);
+    uint32_t sum1 = adler1 & 0xFFFF;
+    uint32_t sum2 = (rem * sum1) % base;
+    sum1 += (adler2 & 0xFFFF) + base - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + base - rem;
+    if (sum1 >= base)
+        sum1 -= base;
+    if (sum1 >= base)
+        sum1 -= base;
+    if (sum2 >= (base << 1))
+        sum2 -= (base << 1);
+    if (sum2 >= base)
+        sum2 -= base;
+    return sum1 | (sum2 << 16);
+}
+
+static inline void RGSS_PNG_Put32(unsigned char *out, uint32_t value)
+{
+    out[0] = (unsigned char)(value >> 24);
+    out[1] = (unsigned char)(value >> 16);
+    out[2] = (unsigned char)(value >> 8);
+    out[3] = (unsigned char)value;
+}
+
+static inline void RGSS_PNG_Bits(RGSS_BitWriter *writer, uint32_t value, int count)
+{
+    writer->bits |= (uint64_t)value << writer->count;
+    writer->count += count;
+    while (writer->count >= 8)
+    {
+        *writer->out++ = (unsigned char)writer->bits;
+        writer->bits >>= 8;
+        writer->count -= 8;
+    }
+}
+
+static inline void RGSS_PNG_Align(RGSS_BitWriter *writer)
+{
+    if (writer->count > 0)
+        RGSS_PNG_Bits(writer, 0, 8 - writer->count);
+}
+
+static inline uint32_t RGSS_PNG_Hash(const unsigned char *data)
+{
+    uint32_t value = data[0] | (data[1] << 8) | (data[2] << 16);
+    return (value * 2654435761u) >> (32 - RGSS_PNG_HASH_BITS);
+}
+
+static inline int RGSS_PNG_MatchLength(const unsigned char *a, const unsigned char *b, int limit)
+{
+    int n = 0;
+    while (n + 8 <= limit)
+    {
+        uint64_t x, y;
+        memcpy(&x, a + n, 8);
+        memcpy(&y, b + n, 8);
+        if (x != y)
+            return n + (__builtin_ctzll(x ^ y) >> 3);
+        n += 8;
+    }
+    while (n < limit && a[n] == b[n])
+        n++;
+    return n;
+}
+
+static int RGSS_PNG_FindMatch(const unsigned char *data, int pos, int size, const int32_t *head, const int32_t *prev,
+                              int chain, int nice, int *distance)
+{
+    int limit = RGSS_MIN(RGSS_PNG_MAX_MATCH, size - pos), best = 0;
+    int candidate = head[RGSS_PNG_Hash(data + pos)];
+    while (candidate >= 0 && candidate < pos && pos - candidate <= RGSS_PNG_WINDOW && chain-- > 0)
+    {
+        int length = RGSS_PNG_MatchLength(data + candidate, data + pos, limit);
+        if (length > best)
+        {
+            best = length;
+            *distance = pos - candidate;
+            if (length >= nice)
+                break;
+        }
+        int next = prev[candidate & RGSS_PNG_WINDOW_MASK];
+        if (next >= candidate)
+            break;
+        candidate = next;
+    }
+    return best;
+}
+
+static inline void RGSS_PNG_Insert(const unsigned char *data, int pos, int32_t *head, int32_t *prev)
+{
+    uint32_t hash = RGSS_PNG_Hash(data + pos);
+    prev[pos & RGSS_PNG_WINDOW_MASK] = head[hash];
+    head[hash] = pos;
+}
+
+static void RGSS_PNG_Deflate(const unsigned char *data, int size, int level, RGSS_BitWriter *writer, int32_t *head,
+                             int32_t *prev)
+{
+    if (level == 0)
+    {
+        for (int pos = 0; pos < size; pos += 65535)
+        {
+            uint32_t length = RGSS_MIN(size - pos, 65535);
+            RGSS_PNG_Bits(writer, 0, 3);
+            RGSS_PNG_Align(writer);
+            RGSS_PNG_Bits(writer, length | ((~length & 0xFFFF) << 16), 32);
+            memcpy(writer->out, data + pos, length);
+            writer->out += length;
+        }
+        return;
+    }
+
+    static const int chains[10] = {0, 1, 4, 8, 16, 32, 64, 128, 256, 1024};
+    const int chain = chains[RGSS_MIN(level, 9)];
+    const int nice = level >= 6 ? RGSS_PNG_MAX_MATCH : level >= 4 ? 128 : 32;
+    const int lazy = level >= 4;
+
+    for (int i = 0; i < RGSS_PNG_HASH_SIZE; i++)
+        head[i] = -1;
+
+    // A single non-final block using the fixed Huffman codes
+    RGSS_PNG_Bits(writer, 2, 3);
+
+    int pos = 0;
+    while (pos < size)
+    {
+        int distance = 0, length = 0;
+        if (pos + RGSS_PNG_MIN_MATCH <= size)
+        {
+            length = RGSS_PNG_FindMatch(data, pos, size, head, prev, chain, nice, &distance);
+            RGSS_PNG_Insert(data, pos, head, prev);
+
+            // Prefer a literal when the match starting at the next byte is longer
+            if (lazy && length >= RGSS_PNG_MIN_MATCH && length < nice && pos + 1 + RGSS_PNG_MIN_MATCH <= size)
+            {
+                int next_distance;
+                if (RGSS_PNG_FindMatch(data, pos + 1, size, head, prev, chain, nice, &next_distance) > length)
+                    length = 0;
+            }
+        }
+
+        if (length >= RGSS_PNG_MIN_MATCH)
+        {
+            int symbol = RGSS_PNG_TABLES.length_symbol[length], index = symbol - 257;
+            RGSS_PNG_Bits(writer, RGSS_PNG_TABLES.literal[symbol], RGSS_PNG_TABLES.literal_bits[symbol]);
+            if (RGSS_PNG_TABLES.length_extra[index])
+                RGSS_PNG_Bits(writer, length - RGSS_PNG_TABLES.length_base[index], RGSS_PNG_TABLES.length_extra[index]);
+
+            int d = distance - 1;
+            int code = RGSS_PNG_TABLES.distance_code[d < 256 ? d : 256 + (d >> 7)];
+            RGSS_PNG_Bits(writer, RGSS_PNG_TABLES.distance_reversed[code], 5);
+            if (RGSS_PNG_TABLES.distance_extra[code])
+                RGSS_PNG_Bits(writer, distance - RGSS_PNG_TABLES.distance_base[code], RGSS_PNG_TABLES.distance_extra[code]);
+
+            // The fastest level skips indexing the bytes within a match
+            if (level > 1)
+            {
+                for (int i = 1; i < length && pos + i + RGSS_PNG_MIN_MATCH <= size; i++)
+                    RGSS_PNG_Insert(data, pos + i, head, prev);
+            }
+            pos += length;
+        }
+        else
+        {
+            RGSS_PNG_Bits(writer, RGSS_PNG_TABLES.literal[data[pos]], RGSS_PNG_TABLES.literal_bits[data[pos]]);
+            pos++;
+        }
+    }
+
+    // End of block, followed by an empty stored block to align the part to a byte boundary
+    RGSS_PNG_Bits(writer, RGSS_PNG_TABLES.literal[256], RGSS_PNG_TABLES.literal_bits[256]);
+    RGSS_PNG_Bits(writer, 0, 3);
+    RGSS_PNG_Align(writer);
+    RGSS_PNG_Bits(writer, 0xFFFF0000u, 32);
+}
+
+static inline unsigned char RGSS_PNG_Paeth(int a, int b, int c)
+{
+    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return (unsigned char)a;
+    return (unsigned char)(pb <= pc ? b : c);
+}
+
+static void RGSS_PNG_FilterRow(int type, const unsigned char *row, const unsigned char *above, int size,
+                               unsigned char *out)
+{
+    const int bpp = 4;
+    switch (type)
+    {
+        case 0: memcpy(out, row, size); break;
+        case 1:
+            for (int i = 0; i < size; i++)
+                out[i] = row[i] - (i < bpp ? 0 : row[i - bpp]);
+            break;
+        case 2:
+            for (int i = 0; i < size; i++)
+                out[i] = row[i] - above[i];
+            break;
+        case 3:
+            for (int i = 0; i < size; i++)
+                out[i] = row[i] - (((i < bpp ? 0 : row[i - bpp]) + above[i]) >> 1);
+            break;
+        default:
+            for (int i = 0; i < bpp; i++)
+                out[i] = row[i] - above[i];
+            for (int i = bpp; i < size; i++)
+                out[i] = row[i] - RGSS_PNG_Paeth(row[i - bpp], above[i], above[i - bpp]);
+            break;
+    }
+}
+
+static void RGSS_PNG_Filter(const unsigned char *pixels, int width, int first, int last, int level, unsigned char *out,
+                            unsigned char *scratch)
+{
+    size_t size = (size_t)width * 4;
+    const unsigned char *zero = scratch + size * 5;
+    for (int y = first; y < last; y++, out += size + 1)
+    {
+        const unsigned char *row = pixels + (size_t)y * size;
+        const unsigned char *above = y > 0 ? row - size : zero;
+
+        // Fast levels use the "up" filter throughout, otherwise the filter with the smallest sum is chosen
+        int type = level == 0 ? 0 : 2;
+        if (level >= 4)
+        {
+            long best = LONG_MAX;
+            for (int f = 0; f < 5; f++)
+            {
+                unsigned char *filtered = scratch + size * f;
+                RGSS_PNG_FilterRow(f, row, above, (int)size, filtered);
+                long sum = 0;
+                for (size_t i = 0; i < size; i++)
+                    sum += abs((signed char)filtered[i]);
+                if (sum < best)
+                {
+                    best = sum;
+                    type = f;
+                }
+            }
+            out[0] = (unsigned char)type;
+            memcpy(out + 1, scratch + size * type, size);
+        }
+        else
+        {
+            out[0] = (unsigned char)type;
+            RGSS_PNG_FilterRow(type, row, above, (int)size, out + 1);
+        }
+    }
+}
+
+static void RGSS_PNG_EncodeParts(void *data, int start, int end)
+{
+    RGSS_PNGJob *job = data;
+    size_t row_size = (size_t)job->width * 4 + 1;
+    size_t max_raw = row_size * job->rows;
+    size_t capacity = max_raw + max_raw / 8 + 5 * (max_raw / 65535 + 1) + 64;
+
+    unsigned char *raw = malloc(max_raw);
+    unsigned char *scratch = calloc(6, row_size);
+    int32_t *head = malloc(RGSS_PNG_HASH_SIZE * sizeof(int32_t));
+    int32_t *prev = malloc(RGSS_PNG_WINDOW * sizeof(int32_t));
+
+    for (int i = start; i < end; i++)
+    {
+        RGSS_PNGPart *part = &job->parts[i];
+        part->data = malloc(capacity);
+        if (!raw || !scratch || !head || !prev || !part->data)
+        {
+            __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+            break;
+        }
+
+        int first = i * job->rows, last = RGSS_MIN(first + job->rows, job->height);
+        RGSS_PNG_Filter(job->pixels, job->width, first, last, job->level, raw, scratch);
+        part->raw_size = row_size * (last - first);
+        part->adler = RGSS_PNG_Adler(raw, part->raw_size);
+
+        // Leave room for the chunk length and tag, and begin the zlib stream in the first part
+        RGSS_BitWriter writer = {part->data + 8};
+        if (i == 0)
+        {
+            static const unsigned char flags[10] = {0x01, 0x01, 0x5E, 0x5E, 0x5E, 0x5E, 0x9C, 0xDA, 0xDA, 0xDA};
+            *writer.out++ = 0x78;
+            *writer.out++ = flags[job->level];
+        }
+        RGSS_PNG_Deflate(raw, (int)part->raw_size, job->level, &writer, head, prev);
+
+        uint32_t length = (uint32_t)(writer.out - part->data - 8);
+        RGSS_PNG_Put32(part->data, length);
+        memcpy(part->data + 4, "IDAT", 4);
+        RGSS_PNG_Put32(writer.out, RGSS_PNG_CRC(0, part->data + 4, length + 4));
+        part->size = length + 12;
+    }
+
+    free(raw);
+    free(scratch);
+    free(head);
+    free(prev);
+}
+
+static int RGSS_PNG_WriteChunk(FILE *file, const char *tag, const unsigned char *data, uint32_t length)
+{
+    unsigned char header[8], footer[4];
+    RGSS_PNG_Put32(header, length);
+    memcpy(header + 4, tag, 4);
+    uint32_t crc = RGSS_PNG_CRC(RGSS_PNG_CRC(0, header + 4, 4), data, length);
+    RGSS_PNG_Put32(footer, crc);
+    return fwrite(header, 8, 1, file) == 1 && (length == 0 || fwrite(data, length, 1, file) == 1) &&
+           fwrite(footer, 4, 1, file) == 1;
+}
+
+int RGSS_PNG_Write(const char *filename, const unsigned char *pixels, int width, int height, int level)
+{
+    if (filename == NULL || pixels == NULL || width < 1 || height < 1)
+        return false;
+    pthread_once(&RGSS_PNG_ONCE, RGSS_PNG_InitTables);
+
+    RGSS_PNGJob job = {pixels, width, height, RGSS_MAX(0, RGSS_MIN(9, level))};
+    job.rows = RGSS_MAX(1, RGSS_PNG_PART_SIZE / (width * 4 + 1));
+    int count = (height + job.rows - 1) / job.rows;
+    job.parts = calloc(count, sizeof(RGSS_PNGPart));
+    if (job.parts == NULL)
+        return false;
+
+    RGSS_Parallel_For(count, 1, RGSS_PNG_EncodeParts, &job);
+
+    int result = false;
+    FILE *file = job.failed ? NULL : fopen(filename, "wb");
+    if (file)
+    {
+        static const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+        unsigned char header[13];
+        RGSS_PNG_Put32(header, width);
+        RGSS_PNG_Put32(header + 4, height);
+        header[8] = 8;  // Bit depth
+        header[9] = 6;  // RGBA
+        header[10] = 0; // Deflate
+        header[11] = 0; // Adaptive filtering
+        header[12] = 0; // No interlacing
+
+        result = fwrite(signature, sizeof(signature), 1, file) == 1 && RGSS_PNG_WriteChunk(file, "IHDR", header, 13);
+
+        uint32_t adler = 1;
+        for (int i = 0; i < count && result; i++)
+        {
+            result = fwrite(job.parts[i].data, job.parts[i].size, 1, file) == 1;
+            adler = RGSS_PNG_AdlerCombine(adler, job.parts[i].adler, job.parts[i].raw_size);
+        }
+
+        // An empty final block with the fixed codes ends the stream, followed by the checksum
+        unsigned char trailer[6] = {0x03, 0x00};
+        RGSS_PNG_Put32(trailer + 2, adler);
+        result = result && RGSS_PNG_WriteChunk(file, "IDAT", trailer, sizeof(trailer));
+        result = result && RGSS_PNG_WriteChunk(file, "IEND", NULL, 0);
+        result = (fclose(file) == 0) && result;
+    }
+
+    for (int i = 0; i < count; i++)
+        free(job.parts[i].data);
+    free(job.parts);
+    return result;
+}
@@ -0,0 +1,22 @@
+#ifndef RGSS_PNG_H
+#define RGSS_PNG_H 1
+
+#include "rgss.h"
+
+#define RGSS_PNG_LEVEL_FAST 1    /** Fixed filtering and a single match probe, suited to screenshots. */
+#define RGSS_PNG_LEVEL_DEFAULT 8 /** Adaptive filtering and long match searches. */
+
+/**
+ * @brief Encodes RGBA pixels in PNG format and writes them to a file. Groups of rows are filtered and compressed
+ * in parallel as independent deflate blocks, which are joined into a single zlib stream.
+ * @param[in] filename The path of the file to write.
+ * @param[in] pixels Tightly packed RGBA pixel data, 4 bytes per pixel.
+ * @param[in] width The width of the image, in pixels.
+ * @param[in] height The height of the image, in pixels.
+ * @param[in] level The compression level from @c 0 (stored) to @c 9 (smallest).
+ * @return @c true on success, otherwise @c false.
+ * @note This function does not call into Ruby, and may be used without holding the GVL.
+ */
+int RGSS_PNG_Write(const char *filename, const unsigned char *pixels, int width, int height, int level);
+
+#endif /* RGSS_PNG_H */
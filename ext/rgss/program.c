@@ -0,0 +1,627 @@
+#include "graphics.h"
+#include "game.h"
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define RGSS_MKDIR(path) _mkdir(path)
+#else
+#define RGSS_MKDIR(path) mkdir(path, 0755)
+#endif
+
+#define RGSS_PROGRAM_CACHE_MAGIC "RGSP"
+#define RGSS_PROGRAM_CACHE_VERSION 1
+
+struct RGSS_Uniform
+{
+    GLint location; /** The location of the uniform. */
+    GLenum type;    /** The type the uniform is declared with. */
+    int dirty;      /** Flag indicating if the value has yet to be applied to the program. */
+    union
+    {
+        GLfloat f[16];
+        GLint i[4];
+        GLuint u[4];
+    } value;           /** The value to apply to the uniform. */
+    UT_hash_handle hh; /** Makes the structure hashable by name. */
+    char name[];       /** The name of the uniform. */
+};
+
+typedef struct
+{
+    char magic[4];    /** Identifies the file as a cached program binary. */
+    uint32_t version; /** The version of the file layout. */
+    uint64_t key;     /** The key the binary was stored with. */
+    uint32_t format;  /** The driver-specific format of the binary. */
+    uint32_t length;  /** The length of the binary that follows, in bytes. */
+} RGSS_ProgramCacheHeader;
+
+static struct
+{
+    char *directory;        /** The directory binaries are stored in, or NULL when caching is disabled. */
+    int supported;          /** Flag indicating if the driver is able to retrieve program binaries. */
+    uint64_t device;        /** A hash of the strings identifying the driver. */
+    unsigned long hits;     /** The number of programs loaded from the cache. */
+    unsigned long misses;   /** The number of programs compiled from source. */
+    unsigned long rejected; /** The number of cached binaries the driver refused to load. */
+    unsigned long stored;   /** The number of binaries written to the cache. */
+} RGSS_PROGRAM_CACHE;
+
+static uint64_t RGSS_Program_Hash(uint64_t hash, const char *str)
+{
+    // Each string is hashed with its terminator so that sources cannot run together, and NULL differs from empty
+    if (str == NULL)
+        return (hash ^ 0xFF) * 0x100000001B3ULL;
+    do
+    {
+        hash ^= (unsigned char)*str;
+        hash *= 0x100000001B3ULL;
+    } while (*str++);
+    return hash;
+}
+
+void RGSS_Program_Init(void)
+{
+    GLint formats = 0;
+    int available =
+        GLAD_GL_ARB_get_program_binary || GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+    if (available && glGetProgramBinary && glProgramBinary && glProgramParameteri)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    RGSS_PROGRAM_CACHE.supported = formats > 0;
+
+    // A driver update invalidates binaries, so they are keyed to the exact driver that produced them
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = RGSS_Program_Hash(hash, (const char *)glGetString(GL_VENDOR));
+    hash = RGSS_Program_Hash(hash, (const char *)glGetString(GL_RENDERER));
+    hash = RGSS_Program_Hash(hash, (const char *)glGetString(GL_VERSION));
+    hash = RGSS_Program_Hash(hash, (const char *)glGetString(GL_SHADING_LANGUAGE_VERSION));
+    RGSS_PROGRAM_CACHE.device = hash;
+
+    if (GLAD_GL_KHR_parallel_shader_compile)
+    {
+        // Let the driver decide how many threads to use
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        RGSS_LogDebug("Enabled parallel shader compilation");
+    }
+
+    if (RGSS_PROGRAM_CACHE.directory)
+    {
+        if (RGSS_PROGRAM_CACHE.supported)
+            RGSS_LogDebug("Shader program cache enabled at %s", RGSS_PROGRAM_CACHE.directory);
+        else
+            RGSS_LogWarn("Shader program cache disabled, driver does not support program binaries");
+    }
+}
+
+void RGSS_Program_Deinit(void)
+{
+    if (RGSS_PROGRAM_CACHE.directory && RGSS_PROGRAM_CACHE.supported)
+    {
+        RGSS_LogInfo("Shader program cache: %lu hits, %lu misses, %lu rejected", RGSS_PROGRAM_CACHE.hits,
+                     RGSS_PROGRAM_CACHE.misses, RGSS_PROGRAM_CACHE.rejected);
+    }
+}
+
+int RGSS_Program_CacheEnabled(void)
+{
+    return RGSS_PROGRAM_CACHE.directory != NULL && RGSS_PROGRAM_CACHE.supported;
+}
+
+uint64_t RGSS_Program_CacheKey(const char *vert_src, const char *frag_src, const char *geom_src)
+{
+    uint64_t hash = RGSS_PROGRAM_CACHE.device;
+    hash = RGSS_Program_Hash(hash, vert_src);
+    hash = RGSS_Program_Hash(hash, frag_src);
+    return RGSS_Program_Hash(hash, geom_src);
+}
+
+static void RGSS_Program_CachePath(uint64_t key, const char *suffix, char *path, size_t size)
+{
+    snprintf(path, size, "%s/%016llx%s", RGSS_PROGRAM_CACHE.directory, (unsigned long long)key, suffix);
+}
+
+GLuint RGSS_Program_CacheLoad(uint64_t key)
+{
+    if (!RGSS_Program_CacheEnabled())
+        return GL_NONE;
+
+    char path[4096];
+    RGSS_Program_CachePath(key, ".bin", path, sizeof(path));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        RGSS_PROGRAM_CACHE.misses++;
+        return GL_NONE;
+    }
+
+    RGSS_ProgramCacheHeader header;
+    void *binary = NULL;
+    int valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(header.magic, RGSS_PROGRAM_CACHE_MAGIC, 4) == 0 &&
+                header.version == RGSS_PROGRAM_CACHE_VERSION && header.key == key && header.length > 0;
+    if (valid)
+    {
+        binary = xmalloc(header.length);
+        valid = fread(binary, header.length, 1, file) == 1;
+    }
+    fclose(file);
+
+    GLuint program = GL_NONE;
+    if (valid)
+    {
+        // Drivers are free to reject a binary for any reason, which is not an error
+        GLint status = GL_FALSE;
+        program = glCreateProgram();
+        glProgramBinary(program, header.format, binary, (GLsizei)header.length);
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        if (status != GL_TRUE)
+        {
+            RGSS_Graphics_DeleteProgram(program);
+            program = GL_NONE;
+        }
+    }
+    if (binary)
+        xfree(binary);
+
+    if (program == GL_NONE)
+    {
+        RGSS_PROGRAM_CACHE.misses++;
+        RGSS_PROGRAM_CACHE.rejected++;
+        remove(path);
+        RGSS_LogDebug("Shader cache rejected binary %016llx", (unsigned long long)key);
+        return GL_NONE;
+    }
+
+    RGSS_PROGRAM_CACHE.hits++;
+    RGSS_LogDebug("Shader (ID:%u) loaded from cached binary %016llx", program, (unsigned long long)key);
+    return program;
+}
+
+void RGSS_Program_CacheStore(uint64_t key, GLuint program)
+{
+    if (!RGSS_Program_CacheEnabled())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    RGSS_ProgramCacheHeader header;
+    memcpy(header.magic, RGSS_PROGRAM_CACHE_MAGIC, 4);
+    header.version = RGSS_PROGRAM_CACHE_VERSION;
+    header.key = key;
+
+    void *binary = xmalloc(length);
+    GLsizei written = 0;
+    GLenum format = GL_NONE;
+    glGetProgramBinary(program, length, &written, &format, binary);
+    header.format = format;
+    header.length = (uint32_t)written;
+
+    // Written to a temporary file first, so a crash or another instance never leaves a partial binary behind
+    char temp[4096], path[4096];
+    RGSS_Program_CachePath(key, ".tmp", temp, sizeof(temp));
+    RGSS_Program_CachePath(key, ".bin", path, sizeof(path));
+
+    FILE *file = written > 0 ? fopen(temp, "wb") : NULL;
+    int ok = file != NULL && fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, written, 1, file) == 1;
+    ok = (file == NULL || fclose(file) == 0) && ok;
+    xfree(binary);
+
+#ifdef _WIN32
+    remove(path);
+#endif
+    if (ok && rename(temp, path) == 0)
+    {
+        RGSS_PROGRAM_CACHE.stored++;
+        return;
+    }
+    remove(temp);
+    RGSS_LogWarn("Failed to write shader cache file %s", path);
+}
+
+void RGSS_Program_BindBlocks(GLuint program)
+{
+    GLint index = glGetUniformBlockIndex(program, "RGSS");
+    if (index != GL_INVALID_INDEX)
+    {
+        glUniformBlockBinding(program, index, 0);
+        RGSS_LogDebug("Shader (ID:%u) bound to projection UBO at index %d", program, index);
+    }
+}
+
+static GLuint RGSS_Program_Compile(const char *source, GLenum type)
+{
+    GLuint id = glCreateShader(type);
+    GLint length = (GLint)strlen(source);
+    glShaderSource(id, 1, &source, &length);
+    glCompileShader(id);
+    return id;
+}
+
+void RGSS_Program_Begin(RGSS_Shader *shader, const char *vert_src, const char *frag_src, const char *geom_src)
+{
+    if (vert_src == NULL || frag_src == NULL)
+        rb_raise(rb_eArgError, "shader source cannot be nil");
+
+    memset(shader, 0, sizeof(RGSS_Shader));
+    shader->key = RGSS_Program_CacheKey(vert_src, frag_src, geom_src);
+    shader->id = RGSS_Program_CacheLoad(shader->key);
+    if (shader->id != GL_NONE)
+    {
+        // Uniform block bindings are not guaranteed to be restored with the binary
+        RGSS_Program_BindBlocks(shader->id);
+        return;
+    }
+
+    // Querying any status here would wait on the driver, so that is left until the program is first used
+    shader->stages[0] = RGSS_Program_Compile(vert_src, GL_VERTEX_SHADER);
+    shader->stages[1] = RGSS_Program_Compile(frag_src, GL_FRAGMENT_SHADER);
+    shader->stages[2] = geom_src ? RGSS_Program_Compile(geom_src, GL_GEOMETRY_SHADER) : GL_NONE;
+
+    shader->id = glCreateProgram();
+    for (int i = 0; i < 3; i++)
+    {
+        if (shader->stages[i] != GL_NONE)
+            glAttachShader(shader->id, shader->stages[i]);
+    }
+    if (RGSS_Program_CacheEnabled())
+        glProgramParameteri(shader->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(shader->id);
+    shader->pending = true;
+}
+
+static void RGSS_Program_AppendLog(VALUE message, GLuint id, int program)
+{
+    GLint length = 0;
+    if (program)
+        glGetProgramiv(id, GL_INFO_LOG_LENGTH, &length);
+    else
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+    if (length <= 1)
+        return;
+
+    char buffer[length];
+    if (program)
+        glGetProgramInfoLog(id, length, NULL, buffer);
+    else
+        glGetShaderInfoLog(id, length, NULL, buffer);
+    rb_str_cat_cstr(message, buffer);
+}
+
+void RGSS_Program_Finish(RGSS_Shader *shader)
+{
+    if (!shader->pending)
+        return;
+
+    GLint status;
+    shader->pending = false;
+    glGetProgramiv(shader->id, GL_LINK_STATUS, &status);
+
+    if (status != GL_TRUE)
+    {
+        // A failed compile also fails the link, but the compile log is the useful one
+        VALUE message = rb_str_new_cstr("failed to create shader program: ");
+        for (int i = 0; i < 3; i++)
+        {
+            if (shader->stages[i] == GL_NONE)
+                continue;
+            glGetShaderiv(shader->stages[i], GL_COMPILE_STATUS, &status);
+            if (status != GL_TRUE)
+                RGSS_Program_AppendLog(message, shader->stages[i], false);
+        }
+        RGSS_Program_AppendLog(message, shader->id, true);
+        RGSS_Program_Delete(shader);
+        rb_exc_raise(rb_exc_new_str(rb_eRGSSError, message));
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (shader->stages[i] == GL_NONE)
+            continue;
+        glDetachShader(shader->id, shader->stages[i]);
+        glDeleteShader(shader->stages[i]);
+        shader->stages[i] = GL_NONE;
+    }
+
+    RGSS_Program_BindBlocks(shader->id);
+    RGSS_Program_CacheStore(shader->key, shader->id);
+    RGSS_LogDebug("Shader (ID:%u) compilation and linkage completed successfully", shader->id);
+}
+
+int RGSS_Program_IsReady(RGSS_Shader *shader)
+{
+    if (!shader->pending || !GLAD_GL_KHR_parallel_shader_compile)
+        return true;
+
+    GLint complete = GL_TRUE;
+    glGetProgramiv(shader->id, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+void RGSS_Program_FreeUniforms(RGSS_Shader *shader)
+{
+    RGSS_Uniform *uniform, *temp;
+    HASH_ITER(hh, shader->uniforms, uniform, temp)
+    {
+        HASH_DEL(shader->uniforms, uniform);
+        xfree(uniform);
+    }
+    shader->reflected = false;
+    shader->dirty = 0;
+}
+
+void RGSS_Program_Delete(RGSS_Shader *shader)
+{
+    RGSS_Program_FreeUniforms(shader);
+    for (int i = 0; i < 3; i++)
+    {
+        if (shader->stages[i] != GL_NONE)
+            glDeleteShader(shader->stages[i]);
+        shader->stages[i] = GL_NONE;
+    }
+    if (shader->id != GL_NONE)
+        RGSS_Graphics_DeleteProgram(shader->id);
+    shader->id = GL_NONE;
+    shader->pending = false;
+}
+
+static RGSS_Uniform *RGSS_Program_AddUniform(RGSS_Shader *shader, const char *name, GLint location, GLenum type)
+{
+    size_t length = strlen(name);
+    RGSS_Uniform *uniform = xmalloc(sizeof(RGSS_Uniform) + length + 1);
+    memset(uniform, 0, sizeof(RGSS_Uniform));
+    memcpy(uniform->name, name, length + 1);
+    uniform->location = location;
+    uniform->type = type;
+    HASH_ADD_KEYPTR(hh, shader->uniforms, uniform->name, length, uniform);
+    return uniform;
+}
+
+static void RGSS_Program_Reflect(RGSS_Shader *shader)
+{
+    GLint count = 0, max = 0;
+    glGetProgramiv(shader->id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(shader->id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max);
+    shader->reflected = true;
+
+    char name[max + 1];
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(shader->id, (GLuint)i, max + 1, &length, &size, &type, name);
+
+        // Arrays are reported by their first element, but are looked up by their plain name
+        if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+            name[length - 3] = '\0';
+
+        // Members of uniform blocks have no location
+        GLint location = glGetUniformLocation(shader->id, name);
+        if (location >= 0)
+            RGSS_Program_AddUniform(shader, name, location, type);
+    }
+}
+
+static RGSS_Uniform *RGSS_Program_FindUniform(RGSS_Shader *shader, const char *name)
+{
+    if (!shader->reflected)
+        RGSS_Program_Reflect(shader);
+
+    RGSS_Uniform *uniform;
+    HASH_FIND_STR(shader->uniforms, name, uniform);
+    if (uniform)
+        return uniform;
+
+    // Individual array elements are resolved once, taking the type from the array. Names that are not active are
+    // not remembered, as any number of them may be given, and they would grow the table without bound.
+    GLint location = glGetUniformLocation(shader->id, name);
+    if (location < 0)
+        return NULL;
+
+    GLenum type = GL_NONE;
+    const char *bracket = strchr(name, '[');
+    if (bracket)
+    {
+        RGSS_Uniform *array;
+        HASH_FIND(hh, shader->uniforms, name, (unsigned)(bracket - name), array);
+        type = array ? array->type : GL_NONE;
+    }
+    return RGSS_Program_AddUniform(shader, name, location, type);
+}
+
+GLint RGSS_Program_Locate(RGSS_Shader *shader, const char *name)
+{
+    RGSS_Uniform *uniform = RGSS_Program_FindUniform(shader, name);
+    return uniform ? uniform->location : -1;
+}
+
+static void RGSS_Program_Floats(VALUE value, GLfloat *result, int count, VALUE klass)
+{
+    if (RB_TYPE_P(value, T_ARRAY))
+    {
+        if (RARRAY_LEN(value) != count)
+            rb_raise(rb_eArgError, "expected %d uniform components (given %ld)", count, RARRAY_LEN(value));
+        for (int i = 0; i < count; i++)
+            result[i] = NUM2FLT(rb_ary_entry(value, i));
+        return;
+    }
+
+    // Matrices without a class of their own may only be given as arrays
+    int valid = !NIL_P(klass) && rb_obj_is_kind_of(value, klass) == Qtrue;
+    if (klass == rb_cVec4)
+        valid = valid || rb_obj_is_kind_of(value, rb_cColor) == Qtrue || rb_obj_is_kind_of(value, rb_cTone) == Qtrue;
+    if (!valid)
+        rb_raise(rb_eTypeError, "cannot set %s as a uniform with %d components", CLASS_NAME(value), count);
+    memcpy(result, DATA_PTR(value), sizeof(GLfloat) * count);
+}
+
+static void RGSS_Program_Ints(VALUE value, GLint *result, int count, int is_unsigned)
+{
+    if (count == 2 && !is_unsigned && rb_obj_is_kind_of(value, rb_cIVec2) == Qtrue)
+    {
+        memcpy(result, DATA_PTR(value), sizeof(GLint) * 2);
+        return;
+    }
+    if (!RB_TYPE_P(value, T_ARRAY))
+        rb_raise(rb_eTypeError, "cannot set %s as a uniform with %d components", CLASS_NAME(value), count);
+    if (RARRAY_LEN(value) != count)
+        rb_raise(rb_eArgError, "expected %d uniform components (given %ld)", count, RARRAY_LEN(value));
+
+    for (int i = 0; i < count; i++)
+    {
+        VALUE v = rb_ary_entry(value, i);
+        if (v == Qtrue || v == Qfalse)
+            result[i] = RTEST(v);
+        else
+            result[i] = is_unsigned ? (GLint)NUM2UINT(v) : NUM2INT(v);
+    }
+}
+
+void RGSS_Program_Set(RGSS_Shader *shader, const char *name, VALUE value)
+{
+    RGSS_Uniform *uniform = RGSS_Program_FindUniform(shader, name);
+    if (uniform == NULL)
+        return;
+
+    switch (uniform->type)
+    {
+        case GL_FLOAT: uniform->value.f[0] = NUM2FLT(value); break;
+        case GL_FLOAT_VEC2: RGSS_Program_Floats(value, uniform->value.f, 2, rb_cVec2); break;
+        case GL_FLOAT_VEC3: RGSS_Program_Floats(value, uniform->value.f, 3, rb_cVec3); break;
+        case GL_FLOAT_VEC4: RGSS_Program_Floats(value, uniform->value.f, 4, rb_cVec4); break;
+        case GL_FLOAT_MAT2: RGSS_Program_Floats(value, uniform->value.f, 4, Qnil); break;
+        case GL_FLOAT_MAT3: RGSS_Program_Floats(value, uniform->value.f, 9, Qnil); break;
+        case GL_FLOAT_MAT4: RGSS_Program_Floats(value, uniform->value.f, 16, rb_cMat4); break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2: RGSS_Program_Ints(value, uniform->value.i, 2, false); break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3: RGSS_Program_Ints(value, uniform->value.i, 3, false); break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4: RGSS_Program_Ints(value, uniform->value.i, 4, false); break;
+        case GL_UNSIGNED_INT: uniform->value.u[0] = NUM2UINT(value); break;
+        case GL_UNSIGNED_INT_VEC2: RGSS_Program_Ints(value, uniform->value.i, 2, true); break;
+        case GL_UNSIGNED_INT_VEC3: RGSS_Program_Ints(value, uniform->value.i, 3, true); break;
+        case GL_UNSIGNED_INT_VEC4: RGSS_Program_Ints(value, uniform->value.i, 4, true); break;
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        {
+            uniform->value.i[0] = (value == Qtrue || value == Qfalse) ? RTEST(value) : NUM2INT(value);
+            break;
+        }
+        default: rb_raise(rb_eTypeError, "unsupported type for uniform \"%s\" (0x%04X)", name, uniform->type);
+    }
+
+    if (!uniform->dirty)
+    {
+        uniform->dirty = true;
+        shader->dirty++;
+    }
+}
+
+static void RGSS_Program_Apply(RGSS_Uniform *uniform)
+{
+    switch (uniform->type)
+    {
+        case GL_FLOAT: glUniform1fv(uniform->location, 1, uniform->value.f); break;
+        case GL_FLOAT_VEC2: glUniform2fv(uniform->location, 1, uniform->value.f); break;
+        case GL_FLOAT_VEC3: glUniform3fv(uniform->location, 1, uniform->value.f); break;
+        case GL_FLOAT_VEC4: glUniform4fv(uniform->location, 1, uniform->value.f); break;
+        case GL_FLOAT_MAT2: glUniformMatrix2fv(uniform->location, 1, GL_FALSE, uniform->value.f); break;
+        case GL_FLOAT_MAT3: glUniformMatrix3fv(uniform->location, 1, GL_FALSE, uniform->value.f); break;
+        case GL_FLOAT_MAT4: glUniformMatrix4fv(uniform->location, 1, GL_FALSE, uniform->value.f); break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2: glUniform2iv(uniform->location, 1, uniform->value.i); break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3: glUniform3iv(uniform->location, 1, uniform->value.i); break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4: glUniform4iv(uniform->location, 1, uniform->value.i); break;
+        case GL_UNSIGNED_INT: glUniform1uiv(uniform->location, 1, uniform->value.u); break;
+        case GL_UNSIGNED_INT_VEC2: glUniform2uiv(uniform->location, 1, uniform->value.u); break;
+        case GL_UNSIGNED_INT_VEC3: glUniform3uiv(uniform->location, 1, uniform->value.u); break;
+        case GL_UNSIGNED_INT_VEC4: glUniform4uiv(uniform->location, 1, uniform->value.u); break;
+        default: glUniform1iv(uniform->location, 1, uniform->value.i); break;
+    }
+    uniform->dirty = false;
+}
+
+void RGSS_Program_Use(RGSS_Shader *shader)
+{
+    RGSS_Program_Finish(shader);
+    RGSS_Graphics_UseProgram(shader->id);
+    if (shader->dirty == 0)
+        return;
+
+    RGSS_Uniform *uniform, *temp;
+    HASH_ITER(hh, shader->uniforms, uniform, temp)
+    {
+        if (uniform->dirty)
+            RGSS_Program_Apply(uniform);
+    }
+    shader->dirty = 0;
+}
+
+VALUE RGSS_Program_Uniforms(RGSS_Shader *shader)
+{
+    if (!shader->reflected)
+        RGSS_Program_Reflect(shader);
+
+    VALUE hash = rb_hash_new();
+    RGSS_Uniform *uniform, *temp;
+    HASH_ITER(hh, shader->uniforms, uniform, temp)
+    {
+        if (uniform->type != GL_NONE && !strchr(uniform->name, '['))
+            rb_hash_aset(hash, rb_str_new_cstr(uniform->name), UINT2NUM(uniform->type));
+    }
+    return hash;
+}
+
+static VALUE RGSS_Program_GetCacheDirectory(VALUE klass)
+{
+    return RGSS_PROGRAM_CACHE.directory ? rb_str_new_cstr(RGSS_PROGRAM_CACHE.directory) : Qnil;
+}
+
+static VALUE RGSS_Program_SetCacheDirectory(VALUE klass, VALUE directory)
+{
+    if (RGSS_PROGRAM_CACHE.directory)
+    {
+        xfree(RGSS_PROGRAM_CACHE.directory);
+        RGSS_PROGRAM_CACHE.directory = NULL;
+    }
+
+    if (RTEST(directory))
+    {
+        const char *path = StringValueCStr(directory);
+        if (RGSS_MKDIR(path) != 0 && errno != EEXIST)
+            rb_raise(rb_eRGSSError, "failed to create shader cache directory: %s", path);
+
+        size_t length = strlen(path);
+        RGSS_PROGRAM_CACHE.directory = xmalloc(length + 1);
+        memcpy(RGSS_PROGRAM_CACHE.directory, path, length + 1);
+    }
+    return directory;
+}
+
+static VALUE RGSS_Program_GetCacheStats(VALUE klass)
+{
+    VALUE hash = rb_hash_new();
+    rb_hash_aset(hash, STR2SYM("hits"), ULONG2NUM(RGSS_PROGRAM_CACHE.hits));
+    rb_hash_aset(hash, STR2SYM("misses"), ULONG2NUM(RGSS_PROGRAM_CACHE.misses));
+    rb_hash_aset(hash, STR2SYM("rejected"), ULONG2NUM(RGSS_PROGRAM_CACHE.rejected));
+    rb_hash_aset(hash, STR2SYM("stored"), ULONG2NUM(RGSS_PROGRAM_CACHE.stored));
+    return hash;
+}
+
+void RGSS_Init_Program(VALUE parent)
+{
+    rb_define_singleton_method0(parent, "cache_directory", RGSS_Program_GetCacheDirectory, 0);
+    rb_define_singleton_method1(parent, "cache_directory=", RGSS_Program_SetCacheDirectory, 1);
+    rb_define_singleton_method0(parent, "cache_stats", RGSS_Program_GetCacheStats, 0);
+}
@@ -59,4 +59,281 @@ const char *SPRITE_FRAG_SRC =
     "\x68\x2E\x72\x67\x62\x2C\x20\x66\x6C\x61\x73\x68\x2E\x61\x29\x2C\x20\x72\x65\x73\x75\x6C\x74\x2E"
     "\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x6F\x70\x61\x63\x69\x74"
     "\x79\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x2A\x3D\x20\x6F\x70\x61\x63\x69\x74\x79\x3B"
-    "\x0A\x7D";
\ No newline at end of file
+    "\x0A\x7D";
+
+const char *BLIT_VERT_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x6C\x61\x79\x6F\x75"
+    "\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20\x3D\x20\x30\x29\x20\x69\x6E\x20\x76\x65\x63\x34\x20"
+    "\x76\x65\x72\x74\x65\x78\x3B\x0A\x6C\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20"
+    "\x3D\x20\x31\x29\x20\x69\x6E\x20\x76\x65\x63\x34\x20\x64\x73\x74\x5F\x72\x65\x63\x74\x3B\x0A\x6C"
+    "\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20\x3D\x20\x32\x29\x20\x69\x6E\x20\x76"
+    "\x65\x63\x34\x20\x73\x72\x63\x5F\x72\x65\x63\x74\x3B\x0A\x6C\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63"
+    "\x61\x74\x69\x6F\x6E\x20\x3D\x20\x33\x29\x20\x69\x6E\x20\x76\x65\x63\x34\x20\x62\x6C\x65\x6E\x64"
+    "\x3B\x0A\x0A\x6F\x75\x74\x20\x76\x65\x63\x32\x20\x75\x76\x3B\x0A\x6F\x75\x74\x20\x76\x65\x63\x34"
+    "\x20\x74\x69\x6E\x74\x3B\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x32\x20\x74\x61\x72"
+    "\x67\x65\x74\x5F\x73\x69\x7A\x65\x3B\x0A\x0A\x76\x6F\x69\x64\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B"
+    "\x0A\x20\x20\x20\x20\x75\x76\x20\x3D\x20\x6D\x69\x78\x28\x73\x72\x63\x5F\x72\x65\x63\x74\x2E\x78"
+    "\x79\x2C\x20\x73\x72\x63\x5F\x72\x65\x63\x74\x2E\x7A\x77\x2C\x20\x76\x65\x72\x74\x65\x78\x2E\x7A"
+    "\x77\x29\x3B\x0A\x20\x20\x20\x20\x74\x69\x6E\x74\x20\x3D\x20\x62\x6C\x65\x6E\x64\x3B\x0A\x20\x20"
+    "\x20\x20\x76\x65\x63\x32\x20\x70\x6F\x73\x69\x74\x69\x6F\x6E\x20\x3D\x20\x64\x73\x74\x5F\x72\x65"
+    "\x63\x74\x2E\x78\x79\x20\x2B\x20\x76\x65\x72\x74\x65\x78\x2E\x78\x79\x20\x2A\x20\x64\x73\x74\x5F"
+    "\x72\x65\x63\x74\x2E\x7A\x77\x3B\x0A\x20\x20\x20\x20\x67\x6C\x5F\x50\x6F\x73\x69\x74\x69\x6F\x6E"
+    "\x20\x3D\x20\x76\x65\x63\x34\x28\x70\x6F\x73\x69\x74\x69\x6F\x6E\x20\x2F\x20\x74\x61\x72\x67\x65"
+    "\x74\x5F\x73\x69\x7A\x65\x20\x2A\x20\x32\x2E\x30\x20\x2D\x20\x31\x2E\x30\x2C\x20\x30\x2E\x30\x2C"
+    "\x20\x31\x2E\x30\x29\x3B\x0A\x7D";
+
+const char *BLIT_FRAG_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x69\x6E\x20\x76\x65"
+    "\x63\x32\x20\x75\x76\x3B\x0A\x69\x6E\x20\x76\x65\x63\x34\x20\x74\x69\x6E\x74\x3B\x0A\x6F\x75\x74"
+    "\x20\x76\x65\x63\x34\x20\x72\x65\x73\x75\x6C\x74\x3B\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x73"
+    "\x61\x6D\x70\x6C\x65\x72\x32\x44\x20\x69\x6D\x61\x67\x65\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20"
+    "\x62\x6F\x6F\x6C\x20\x74\x65\x78\x74\x75\x72\x65\x64\x3B\x0A\x0A\x76\x6F\x69\x64\x20\x6D\x61\x69"
+    "\x6E\x28\x29\x20\x7B\x0A\x20\x20\x20\x20\x2F\x2F\x20\x42\x6C\x69\x74\x73\x20\x6D\x6F\x64\x75\x6C"
+    "\x61\x74\x65\x20\x74\x68\x65\x20\x73\x6F\x75\x72\x63\x65\x20\x74\x65\x78\x74\x75\x72\x65\x2C\x20"
+    "\x66\x69\x6C\x6C\x73\x20\x77\x72\x69\x74\x65\x20\x74\x68\x65\x20\x63\x6F\x6C\x6F\x72\x20\x61\x73"
+    "\x2D\x69\x73\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x74\x65\x78\x74\x75\x72\x65"
+    "\x64\x20\x3F\x20\x74\x65\x78\x74\x75\x72\x65\x28\x69\x6D\x61\x67\x65\x2C\x20\x75\x76\x29\x20\x2A"
+    "\x20\x74\x69\x6E\x74\x20\x3A\x20\x74\x69\x6E\x74\x3B\x0A\x7D";
+
+const char *TRANSITION_VERT_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x6C\x61\x79\x6F\x75"
+    "\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20\x3D\x20\x30\x29\x20\x69\x6E\x20\x76\x65\x63\x32\x20"
+    "\x5F\x70\x3B\x0A\x6F\x75\x74\x20\x76\x65\x63\x32\x20\x5F\x75\x76\x3B\x0A\x0A\x6C\x61\x79\x6F\x75"
+    "\x74\x20\x28\x73\x74\x64\x31\x34\x30\x29\x20\x75\x6E\x69\x66\x6F\x72\x6D\x20\x52\x47\x53\x53\x0A"
+    "\x7B\x0A\x20\x20\x20\x20\x6D\x61\x74\x34\x20\x70\x72\x6F\x6A\x65\x63\x74\x69\x6F\x6E\x3B\x0A\x7D"
+    "\x3B\x0A\x0A\x76\x6F\x69\x64\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B\x0A\x20\x20\x20\x20\x67\x6C\x5F"
+    "\x50\x6F\x73\x69\x74\x69\x6F\x6E\x20\x3D\x20\x70\x72\x6F\x6A\x65\x63\x74\x69\x6F\x6E\x20\x2A\x20"
+    "\x76\x65\x63\x34\x28\x5F\x70\x2E\x78\x79\x2C\x20\x30\x2E\x30\x2C\x20\x31\x2E\x30\x29\x3B\x0A\x20"
+    "\x20\x20\x20\x5F\x75\x76\x20\x3D\x20\x76\x65\x63\x32\x28\x30\x2E\x35\x2C\x20\x30\x2E\x35\x29\x20"
+    "\x2A\x20\x28\x5F\x70\x20\x2B\x20\x76\x65\x63\x32\x28\x31\x2E\x30\x2C\x20\x31\x2E\x30\x29\x29\x3B"
+    "\x0A\x7D";
+
+const char *TRANSITION_FRAG_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x69\x6E\x20\x76\x65"
+    "\x63\x32\x20\x5F\x75\x76\x3B\x0A\x6F\x75\x74\x20\x76\x65\x63\x34\x20\x72\x65\x73\x75\x6C\x74\x3B"
+    "\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x73\x61\x6D\x70\x6C\x65\x72\x32\x44\x20\x66\x72\x6F\x6D"
+    "\x2C\x20\x74\x6F\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x70\x72\x6F\x67"
+    "\x72\x65\x73\x73\x2C\x20\x72\x61\x74\x69\x6F\x3B\x0A\x0A\x76\x65\x63\x34\x20\x67\x65\x74\x46\x72"
+    "\x6F\x6D\x43\x6F\x6C\x6F\x72\x28\x76\x65\x63\x32\x20\x75\x76\x29\x20\x7B\x0A\x20\x20\x20\x20\x72"
+    "\x65\x74\x75\x72\x6E\x20\x74\x65\x78\x74\x75\x72\x65\x28\x66\x72\x6F\x6D\x2C\x20\x75\x76\x29\x3B"
+    "\x0A\x7D\x0A\x0A\x76\x65\x63\x34\x20\x67\x65\x74\x54\x6F\x43\x6F\x6C\x6F\x72\x28\x76\x65\x63\x32"
+    "\x20\x75\x76\x29\x20\x7B\x0A\x20\x20\x20\x20\x72\x65\x74\x75\x72\x6E\x20\x74\x65\x78\x74\x75\x72"
+    "\x65\x28\x74\x6F\x2C\x20\x75\x76\x29\x3B\x0A\x7D\x0A\x0A\x2F\x2F\x20\x54\x68\x65\x20\x62\x75\x69"
+    "\x6C\x74\x2D\x69\x6E\x20\x63\x72\x6F\x73\x73\x2D\x66\x61\x64\x65\x20\x75\x73\x65\x64\x20\x77\x68"
+    "\x65\x6E\x20\x6E\x6F\x20\x74\x72\x61\x6E\x73\x69\x74\x69\x6F\x6E\x20\x69\x73\x20\x67\x69\x76\x65"
+    "\x6E\x0A\x76\x65\x63\x34\x20\x74\x72\x61\x6E\x73\x69\x74\x69\x6F\x6E\x28\x76\x65\x63\x32\x20\x75"
+    "\x76\x29\x20\x7B\x0A\x20\x20\x20\x20\x72\x65\x74\x75\x72\x6E\x20\x6D\x69\x78\x28\x67\x65\x74\x46"
+    "\x72\x6F\x6D\x43\x6F\x6C\x6F\x72\x28\x75\x76\x29\x2C\x20\x67\x65\x74\x54\x6F\x43\x6F\x6C\x6F\x72"
+    "\x28\x75\x76\x29\x2C\x20\x70\x72\x6F\x67\x72\x65\x73\x73\x29\x3B\x0A\x7D\x0A\x0A\x76\x6F\x69\x64"
+    "\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x74"
+    "\x72\x61\x6E\x73\x69\x74\x69\x6F\x6E\x28\x5F\x75\x76\x29\x3B\x0A\x7D";
+
+const char *TEXT_VERT_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x6C\x61\x79\x6F\x75"
+    "\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20\x3D\x20\x30\x29\x20\x69\x6E\x20\x76\x65\x63\x32\x20"
+    "\x63\x6F\x72\x6E\x65\x72\x3B\x0A\x6C\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20"
+    "\x3D\x20\x31\x29\x20\x69\x6E\x20\x76\x65\x63\x34\x20\x64\x73\x74\x5F\x72\x65\x63\x74\x3B\x0A\x6C"
+    "\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20\x3D\x20\x32\x29\x20\x69\x6E\x20\x76"
+    "\x65\x63\x34\x20\x73\x72\x63\x5F\x72\x65\x63\x74\x3B\x0A\x6C\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63"
+    "\x61\x74\x69\x6F\x6E\x20\x3D\x20\x33\x29\x20\x69\x6E\x20\x76\x65\x63\x34\x20\x67\x6C\x79\x70\x68"
+    "\x5F\x63\x6F\x6C\x6F\x72\x3B\x0A\x6C\x61\x79\x6F\x75\x74\x28\x6C\x6F\x63\x61\x74\x69\x6F\x6E\x20"
+    "\x3D\x20\x34\x29\x20\x69\x6E\x20\x66\x6C\x6F\x61\x74\x20\x67\x6C\x79\x70\x68\x5F\x69\x6E\x64\x65"
+    "\x78\x3B\x0A\x0A\x6F\x75\x74\x20\x76\x65\x63\x32\x20\x75\x76\x3B\x0A\x6F\x75\x74\x20\x76\x65\x63"
+    "\x34\x20\x74\x69\x6E\x74\x3B\x0A\x66\x6C\x61\x74\x20\x6F\x75\x74\x20\x76\x65\x63\x34\x20\x62\x6F"
+    "\x75\x6E\x64\x73\x3B\x0A\x66\x6C\x61\x74\x20\x6F\x75\x74\x20\x76\x65\x63\x32\x20\x74\x65\x78\x65"
+    "\x6C\x3B\x0A\x0A\x6C\x61\x79\x6F\x75\x74\x20\x28\x73\x74\x64\x31\x34\x30\x29\x20\x75\x6E\x69\x66"
+    "\x6F\x72\x6D\x20\x52\x47\x53\x53\x0A\x7B\x0A\x20\x20\x20\x20\x6D\x61\x74\x34\x20\x70\x72\x6F\x6A"
+    "\x65\x63\x74\x69\x6F\x6E\x3B\x0A\x7D\x3B\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x6D\x61\x74\x34"
+    "\x20\x6D\x6F\x64\x65\x6C\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x72\x65"
+    "\x76\x65\x61\x6C\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x72\x65\x76\x65"
+    "\x61\x6C\x5F\x66\x61\x64\x65\x3B\x0A\x0A\x76\x6F\x69\x64\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B\x0A"
+    "\x20\x20\x20\x20\x2F\x2F\x20\x45\x61\x63\x68\x20\x69\x6E\x73\x74\x61\x6E\x63\x65\x20\x69\x73\x20"
+    "\x61\x20\x67\x6C\x79\x70\x68\x2C\x20\x70\x6F\x73\x69\x74\x69\x6F\x6E\x65\x64\x20\x69\x6E\x20\x70"
+    "\x69\x78\x65\x6C\x73\x20\x72\x65\x6C\x61\x74\x69\x76\x65\x20\x74\x6F\x20\x74\x68\x65\x20\x6F\x72"
+    "\x69\x67\x69\x6E\x20\x6F\x66\x20\x74\x68\x65\x20\x74\x65\x78\x74\x0A\x20\x20\x20\x20\x75\x76\x20"
+    "\x3D\x20\x6D\x69\x78\x28\x73\x72\x63\x5F\x72\x65\x63\x74\x2E\x78\x79\x2C\x20\x73\x72\x63\x5F\x72"
+    "\x65\x63\x74\x2E\x7A\x77\x2C\x20\x63\x6F\x72\x6E\x65\x72\x29\x3B\x0A\x20\x20\x20\x20\x74\x69\x6E"
+    "\x74\x20\x3D\x20\x67\x6C\x79\x70\x68\x5F\x63\x6F\x6C\x6F\x72\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F"
+    "\x20\x47\x6C\x79\x70\x68\x73\x20\x61\x72\x65\x20\x72\x65\x76\x65\x61\x6C\x65\x64\x20\x69\x6E\x20"
+    "\x74\x68\x65\x20\x6F\x72\x64\x65\x72\x20\x6F\x66\x20\x74\x68\x65\x20\x74\x65\x78\x74\x2C\x20\x65"
+    "\x61\x63\x68\x20\x66\x61\x64\x69\x6E\x67\x20\x69\x6E\x20\x6F\x76\x65\x72\x20\x74\x68\x65\x20\x67"
+    "\x69\x76\x65\x6E\x20\x6E\x75\x6D\x62\x65\x72\x20\x6F\x66\x20\x67\x6C\x79\x70\x68\x73\x0A\x20\x20"
+    "\x20\x20\x69\x66\x20\x28\x72\x65\x76\x65\x61\x6C\x5F\x66\x61\x64\x65\x20\x3E\x20\x30\x2E\x30\x29"
+    "\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x74\x69\x6E\x74\x2E\x61\x20\x2A\x3D\x20\x63\x6C\x61\x6D\x70"
+    "\x28\x28\x72\x65\x76\x65\x61\x6C\x20\x2D\x20\x67\x6C\x79\x70\x68\x5F\x69\x6E\x64\x65\x78\x29\x20"
+    "\x2F\x20\x72\x65\x76\x65\x61\x6C\x5F\x66\x61\x64\x65\x2C\x20\x30\x2E\x30\x2C\x20\x31\x2E\x30\x29"
+    "\x3B\x0A\x20\x20\x20\x20\x65\x6C\x73\x65\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x74\x69\x6E\x74\x2E"
+    "\x61\x20\x2A\x3D\x20\x73\x74\x65\x70\x28\x67\x6C\x79\x70\x68\x5F\x69\x6E\x64\x65\x78\x20\x2B\x20"
+    "\x31\x2E\x30\x2C\x20\x72\x65\x76\x65\x61\x6C\x29\x3B\x0A\x0A\x20\x20\x20\x20\x62\x6F\x75\x6E\x64"
+    "\x73\x20\x3D\x20\x73\x72\x63\x5F\x72\x65\x63\x74\x3B\x0A\x20\x20\x20\x20\x74\x65\x78\x65\x6C\x20"
+    "\x3D\x20\x28\x73\x72\x63\x5F\x72\x65\x63\x74\x2E\x7A\x77\x20\x2D\x20\x73\x72\x63\x5F\x72\x65\x63"
+    "\x74\x2E\x78\x79\x29\x20\x2F\x20\x64\x73\x74\x5F\x72\x65\x63\x74\x2E\x7A\x77\x3B\x0A\x20\x20\x20"
+    "\x20\x67\x6C\x5F\x50\x6F\x73\x69\x74\x69\x6F\x6E\x20\x3D\x20\x70\x72\x6F\x6A\x65\x63\x74\x69\x6F"
+    "\x6E\x20\x2A\x20\x6D\x6F\x64\x65\x6C\x20\x2A\x20\x76\x65\x63\x34\x28\x64\x73\x74\x5F\x72\x65\x63"
+    "\x74\x2E\x78\x79\x20\x2B\x20\x63\x6F\x72\x6E\x65\x72\x20\x2A\x20\x64\x73\x74\x5F\x72\x65\x63\x74"
+    "\x2E\x7A\x77\x2C\x20\x30\x2E\x30\x2C\x20\x31\x2E\x30\x29\x3B\x0A\x7D";
+
+const char *TEXT_FRAG_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x69\x6E\x20\x76\x65"
+    "\x63\x32\x20\x75\x76\x3B\x0A\x69\x6E\x20\x76\x65\x63\x34\x20\x74\x69\x6E\x74\x3B\x0A\x6F\x75\x74"
+    "\x20\x76\x65\x63\x34\x20\x72\x65\x73\x75\x6C\x74\x3B\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x73"
+    "\x61\x6D\x70\x6C\x65\x72\x32\x44\x20\x61\x74\x6C\x61\x73\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20"
+    "\x76\x65\x63\x34\x20\x63\x6F\x6C\x6F\x72\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34"
+    "\x20\x74\x6F\x6E\x65\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34\x20\x66\x6C\x61\x73"
+    "\x68\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x6F\x70\x61\x63\x69\x74\x79"
+    "\x20\x3D\x20\x31\x2E\x30\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x68\x75"
+    "\x65\x3B\x0A\x0A\x63\x6F\x6E\x73\x74\x20\x76\x65\x63\x33\x20\x6B\x20\x3D\x20\x76\x65\x63\x33\x28"
+    "\x30\x2E\x35\x37\x37\x33\x35\x2C\x20\x30\x2E\x35\x37\x37\x33\x35\x2C\x20\x30\x2E\x35\x37\x37\x33"
+    "\x35\x29\x3B\x0A\x0A\x76\x6F\x69\x64\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B\x0A\x0A\x20\x20\x20\x20"
+    "\x2F\x2F\x20\x54\x68\x65\x20\x61\x74\x6C\x61\x73\x20\x6F\x6E\x6C\x79\x20\x73\x74\x6F\x72\x65\x73"
+    "\x20\x63\x6F\x76\x65\x72\x61\x67\x65\x2C\x20\x74\x68\x65\x20\x63\x6F\x6C\x6F\x72\x20\x63\x6F\x6D"
+    "\x65\x73\x20\x66\x72\x6F\x6D\x20\x74\x68\x65\x20\x67\x6C\x79\x70\x68\x0A\x20\x20\x20\x20\x72\x65"
+    "\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x74\x69\x6E\x74\x2E\x72\x67\x62\x2C\x20\x74\x69"
+    "\x6E\x74\x2E\x61\x20\x2A\x20\x74\x65\x78\x74\x75\x72\x65\x28\x61\x74\x6C\x61\x73\x2C\x20\x75\x76"
+    "\x29\x2E\x72\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x68\x75\x65\x20"
+    "\x73\x68\x69\x66\x74\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61\x6E\x67\x6C\x65\x20\x3D\x20"
+    "\x63\x6F\x73\x28\x72\x61\x64\x69\x61\x6E\x73\x28\x68\x75\x65\x29\x29\x3B\x0A\x20\x20\x20\x20\x76"
+    "\x65\x63\x33\x20\x72\x67\x62\x20\x3D\x20\x76\x65\x63\x33\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67"
+    "\x62\x20\x2A\x20\x61\x6E\x67\x6C\x65\x20\x2B\x20\x63\x72\x6F\x73\x73\x28\x6B\x2C\x20\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x72\x67\x62\x29\x20\x2A\x20\x73\x69\x6E\x28\x72\x61\x64\x69\x61\x6E\x73\x28\x68"
+    "\x75\x65\x29\x29\x20\x2B\x20\x6B\x20\x2A\x20\x64\x6F\x74\x28\x6B\x2C\x20\x72\x65\x73\x75\x6C\x74"
+    "\x2E\x72\x67\x62\x29\x20\x2A\x20\x28\x31\x2E\x30\x20\x2D\x20\x61\x6E\x67\x6C\x65\x29\x29\x3B\x0A"
+    "\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x72\x67\x62\x2C\x20\x72"
+    "\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20"
+    "\x63\x6F\x6C\x6F\x72\x20\x62\x6C\x65\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C"
+    "\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x6D\x69\x78\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67\x62\x2C"
+    "\x20\x63\x6F\x6C\x6F\x72\x2E\x72\x67\x62\x2C\x20\x63\x6F\x6C\x6F\x72\x2E\x61\x29\x2C\x20\x72\x65"
+    "\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x74"
+    "\x6F\x6E\x65\x20\x62\x6C\x65\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61"
+    "\x76\x67\x20\x3D\x20\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2B\x20\x72\x65\x73\x75\x6C\x74\x2E"
+    "\x67\x20\x2B\x20\x72\x65\x73\x75\x6C\x74\x2E\x62\x29\x20\x2F\x20\x33\x2E\x30\x3B\x0A\x20\x20\x20"
+    "\x20\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x20\x3D\x20\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2D\x20"
+    "\x28\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2D\x20\x61\x76\x67\x29\x20\x2A\x20\x74\x6F\x6E\x65"
+    "\x2E\x61\x29\x3B\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x2E\x67\x20\x20\x3D\x20\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x67\x20\x2D\x20\x28\x28\x72\x65\x73\x75\x6C\x74\x2E\x67\x20\x2D\x20\x61\x76\x67"
+    "\x29\x20\x2A\x20\x74\x6F\x6E\x65\x2E\x61\x29\x3B\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x2E"
+    "\x62\x20\x20\x3D\x20\x72\x65\x73\x75\x6C\x74\x2E\x62\x20\x2D\x20\x28\x28\x72\x65\x73\x75\x6C\x74"
+    "\x2E\x62\x20\x2D\x20\x61\x76\x67\x29\x20\x2A\x20\x74\x6F\x6E\x65\x2E\x61\x29\x3B\x0A\x20\x20\x20"
+    "\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x63\x6C\x61\x6D\x70\x28\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x72\x67\x62\x20\x2B\x20\x74\x6F\x6E\x65\x2E\x72\x67\x62\x2C\x20\x30\x2E\x30\x2C"
+    "\x20\x31\x2E\x30\x29\x2C\x20\x72\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F"
+    "\x2F\x20\x46\x6C\x61\x73\x68\x20\x65\x66\x66\x65\x63\x74\x20\x63\x6F\x6C\x6F\x72\x20\x62\x6C\x65"
+    "\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28"
+    "\x6D\x69\x78\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67\x62\x2C\x20\x66\x6C\x61\x73\x68\x2E\x72\x67"
+    "\x62\x2C\x20\x66\x6C\x61\x73\x68\x2E\x61\x29\x2C\x20\x72\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A"
+    "\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x6F\x70\x61\x63\x69\x74\x79\x0A\x20\x20"
+    "\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x2A\x3D\x20\x6F\x70\x61\x63\x69\x74\x79\x3B\x0A\x7D";
+
+const char *TEXT_SDF_FRAG_SRC =
+    "\x23\x76\x65\x72\x73\x69\x6F\x6E\x20\x33\x33\x30\x20\x63\x6F\x72\x65\x0A\x0A\x69\x6E\x20\x76\x65"
+    "\x63\x32\x20\x75\x76\x3B\x0A\x69\x6E\x20\x76\x65\x63\x34\x20\x74\x69\x6E\x74\x3B\x0A\x66\x6C\x61"
+    "\x74\x20\x69\x6E\x20\x76\x65\x63\x34\x20\x62\x6F\x75\x6E\x64\x73\x3B\x0A\x66\x6C\x61\x74\x20\x69"
+    "\x6E\x20\x76\x65\x63\x32\x20\x74\x65\x78\x65\x6C\x3B\x0A\x6F\x75\x74\x20\x76\x65\x63\x34\x20\x72"
+    "\x65\x73\x75\x6C\x74\x3B\x0A\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x73\x61\x6D\x70\x6C\x65\x72\x32"
+    "\x44\x20\x61\x74\x6C\x61\x73\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34\x20\x63\x6F"
+    "\x6C\x6F\x72\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34\x20\x74\x6F\x6E\x65\x3B\x0A"
+    "\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34\x20\x66\x6C\x61\x73\x68\x3B\x0A\x75\x6E\x69\x66"
+    "\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x6F\x70\x61\x63\x69\x74\x79\x20\x3D\x20\x31\x2E\x30\x3B"
+    "\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x68\x75\x65\x3B\x0A\x0A\x75\x6E\x69"
+    "\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x73\x70\x72\x65\x61\x64\x3B\x0A\x75\x6E\x69\x66\x6F"
+    "\x72\x6D\x20\x76\x65\x63\x34\x20\x6F\x75\x74\x6C\x69\x6E\x65\x5F\x63\x6F\x6C\x6F\x72\x3B\x0A\x75"
+    "\x6E\x69\x66\x6F\x72\x6D\x20\x66\x6C\x6F\x61\x74\x20\x6F\x75\x74\x6C\x69\x6E\x65\x5F\x77\x69\x64"
+    "\x74\x68\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x34\x20\x73\x68\x61\x64\x6F\x77\x5F"
+    "\x63\x6F\x6C\x6F\x72\x3B\x0A\x75\x6E\x69\x66\x6F\x72\x6D\x20\x76\x65\x63\x32\x20\x73\x68\x61\x64"
+    "\x6F\x77\x5F\x6F\x66\x66\x73\x65\x74\x3B\x0A\x0A\x63\x6F\x6E\x73\x74\x20\x76\x65\x63\x33\x20\x6B"
+    "\x20\x3D\x20\x76\x65\x63\x33\x28\x30\x2E\x35\x37\x37\x33\x35\x2C\x20\x30\x2E\x35\x37\x37\x33\x35"
+    "\x2C\x20\x30\x2E\x35\x37\x37\x33\x35\x29\x3B\x0A\x0A\x76\x65\x63\x34\x20\x6F\x76\x65\x72\x28\x76"
+    "\x65\x63\x34\x20\x74\x6F\x70\x2C\x20\x76\x65\x63\x34\x20\x62\x6F\x74\x74\x6F\x6D\x29\x20\x7B\x0A"
+    "\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61\x20\x3D\x20\x74\x6F\x70\x2E\x61\x20\x2B\x20\x62\x6F"
+    "\x74\x74\x6F\x6D\x2E\x61\x20\x2A\x20\x28\x31\x2E\x30\x20\x2D\x20\x74\x6F\x70\x2E\x61\x29\x3B\x0A"
+    "\x20\x20\x20\x20\x69\x66\x20\x28\x61\x20\x3C\x3D\x20\x30\x2E\x30\x29\x0A\x20\x20\x20\x20\x20\x20"
+    "\x20\x20\x72\x65\x74\x75\x72\x6E\x20\x76\x65\x63\x34\x28\x30\x2E\x30\x29\x3B\x0A\x20\x20\x20\x20"
+    "\x72\x65\x74\x75\x72\x6E\x20\x76\x65\x63\x34\x28\x28\x74\x6F\x70\x2E\x72\x67\x62\x20\x2A\x20\x74"
+    "\x6F\x70\x2E\x61\x20\x2B\x20\x62\x6F\x74\x74\x6F\x6D\x2E\x72\x67\x62\x20\x2A\x20\x62\x6F\x74\x74"
+    "\x6F\x6D\x2E\x61\x20\x2A\x20\x28\x31\x2E\x30\x20\x2D\x20\x74\x6F\x70\x2E\x61\x29\x29\x20\x2F\x20"
+    "\x61\x2C\x20\x61\x29\x3B\x0A\x7D\x0A\x0A\x66\x6C\x6F\x61\x74\x20\x73\x61\x6D\x70\x6C\x65\x44\x69"
+    "\x73\x74\x61\x6E\x63\x65\x28\x76\x65\x63\x32\x20\x63\x6F\x6F\x72\x64\x29\x20\x7B\x0A\x20\x20\x20"
+    "\x20\x2F\x2F\x20\x4E\x65\x69\x67\x68\x62\x6F\x72\x69\x6E\x67\x20\x67\x6C\x79\x70\x68\x73\x20\x6D"
+    "\x75\x73\x74\x20\x6E\x6F\x74\x20\x62\x65\x20\x73\x61\x6D\x70\x6C\x65\x64\x2C\x20\x61\x6E\x79\x74"
+    "\x68\x69\x6E\x67\x20\x6F\x75\x74\x73\x69\x64\x65\x20\x6F\x66\x20\x74\x68\x65\x20\x67\x6C\x79\x70"
+    "\x68\x20\x69\x73\x20\x66\x61\x72\x20\x66\x72\x6F\x6D\x20\x69\x74\x73\x20\x6F\x75\x74\x6C\x69\x6E"
+    "\x65\x0A\x20\x20\x20\x20\x69\x66\x20\x28\x61\x6E\x79\x28\x6C\x65\x73\x73\x54\x68\x61\x6E\x28\x63"
+    "\x6F\x6F\x72\x64\x2C\x20\x62\x6F\x75\x6E\x64\x73\x2E\x78\x79\x29\x29\x20\x7C\x7C\x20\x61\x6E\x79"
+    "\x28\x67\x72\x65\x61\x74\x65\x72\x54\x68\x61\x6E\x28\x63\x6F\x6F\x72\x64\x2C\x20\x62\x6F\x75\x6E"
+    "\x64\x73\x2E\x7A\x77\x29\x29\x29\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x72\x65\x74\x75\x72\x6E\x20"
+    "\x30\x2E\x30\x3B\x0A\x20\x20\x20\x20\x72\x65\x74\x75\x72\x6E\x20\x74\x65\x78\x74\x75\x72\x65\x28"
+    "\x61\x74\x6C\x61\x73\x2C\x20\x63\x6F\x6F\x72\x64\x29\x2E\x72\x3B\x0A\x7D\x0A\x0A\x76\x6F\x69\x64"
+    "\x20\x6D\x61\x69\x6E\x28\x29\x20\x7B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x54\x68\x65\x20\x61\x74"
+    "\x6C\x61\x73\x20\x73\x74\x6F\x72\x65\x73\x20\x74\x68\x65\x20\x64\x69\x73\x74\x61\x6E\x63\x65\x20"
+    "\x74\x6F\x20\x74\x68\x65\x20\x6F\x75\x74\x6C\x69\x6E\x65\x2C\x20\x77\x68\x69\x63\x68\x20\x69\x73"
+    "\x20\x61\x74\x20\x30\x2E\x35\x20\x61\x6E\x64\x20\x69\x6E\x63\x72\x65\x61\x73\x65\x73\x20\x74\x6F"
+    "\x77\x61\x72\x64\x73\x20\x74\x68\x65\x20\x69\x6E\x73\x69\x64\x65\x0A\x20\x20\x20\x20\x66\x6C\x6F"
+    "\x61\x74\x20\x66\x69\x65\x6C\x64\x20\x3D\x20\x74\x65\x78\x74\x75\x72\x65\x28\x61\x74\x6C\x61\x73"
+    "\x2C\x20\x75\x76\x29\x2E\x72\x3B\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61\x61\x20\x3D\x20"
+    "\x6D\x61\x78\x28\x66\x77\x69\x64\x74\x68\x28\x66\x69\x65\x6C\x64\x29\x20\x2A\x20\x30\x2E\x35\x2C"
+    "\x20\x30\x2E\x30\x30\x30\x31\x29\x3B\x0A\x20\x20\x20\x20\x76\x65\x63\x34\x20\x67\x6C\x79\x70\x68"
+    "\x20\x3D\x20\x76\x65\x63\x34\x28\x74\x69\x6E\x74\x2E\x72\x67\x62\x2C\x20\x74\x69\x6E\x74\x2E\x61"
+    "\x20\x2A\x20\x73\x6D\x6F\x6F\x74\x68\x73\x74\x65\x70\x28\x30\x2E\x35\x20\x2D\x20\x61\x61\x2C\x20"
+    "\x30\x2E\x35\x20\x2B\x20\x61\x61\x2C\x20\x66\x69\x65\x6C\x64\x29\x29\x3B\x0A\x0A\x20\x20\x20\x20"
+    "\x2F\x2F\x20\x54\x68\x65\x20\x6F\x75\x74\x6C\x69\x6E\x65\x20\x67\x72\x6F\x77\x73\x20\x74\x68\x65"
+    "\x20\x67\x6C\x79\x70\x68\x20\x6F\x75\x74\x77\x61\x72\x64\x73\x2C\x20\x6C\x69\x6D\x69\x74\x65\x64"
+    "\x20\x62\x79\x20\x68\x6F\x77\x20\x66\x61\x72\x20\x74\x68\x65\x20\x64\x69\x73\x74\x61\x6E\x63\x65"
+    "\x20\x66\x69\x65\x6C\x64\x20\x72\x65\x61\x63\x68\x65\x73\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74"
+    "\x20\x65\x64\x67\x65\x20\x3D\x20\x30\x2E\x35\x3B\x0A\x20\x20\x20\x20\x69\x66\x20\x28\x6F\x75\x74"
+    "\x6C\x69\x6E\x65\x5F\x77\x69\x64\x74\x68\x20\x3E\x20\x30\x2E\x30\x29\x20\x7B\x0A\x20\x20\x20\x20"
+    "\x20\x20\x20\x20\x65\x64\x67\x65\x20\x3D\x20\x6D\x61\x78\x28\x30\x2E\x35\x20\x2D\x20\x6F\x75\x74"
+    "\x6C\x69\x6E\x65\x5F\x77\x69\x64\x74\x68\x20\x2A\x20\x74\x65\x78\x65\x6C\x2E\x78\x20\x2F\x20\x28"
+    "\x32\x2E\x30\x20\x2A\x20\x73\x70\x72\x65\x61\x64\x29\x2C\x20\x61\x61\x29\x3B\x0A\x20\x20\x20\x20"
+    "\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x6F\x75\x74\x6C\x69\x6E\x65\x20\x3D\x20\x73\x6D\x6F\x6F"
+    "\x74\x68\x73\x74\x65\x70\x28\x65\x64\x67\x65\x20\x2D\x20\x61\x61\x2C\x20\x65\x64\x67\x65\x20\x2B"
+    "\x20\x61\x61\x2C\x20\x66\x69\x65\x6C\x64\x29\x3B\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x67\x6C\x79"
+    "\x70\x68\x20\x3D\x20\x6F\x76\x65\x72\x28\x67\x6C\x79\x70\x68\x2C\x20\x76\x65\x63\x34\x28\x6F\x75"
+    "\x74\x6C\x69\x6E\x65\x5F\x63\x6F\x6C\x6F\x72\x2E\x72\x67\x62\x2C\x20\x6F\x75\x74\x6C\x69\x6E\x65"
+    "\x5F\x63\x6F\x6C\x6F\x72\x2E\x61\x20\x2A\x20\x74\x69\x6E\x74\x2E\x61\x20\x2A\x20\x6F\x75\x74\x6C"
+    "\x69\x6E\x65\x29\x29\x3B\x0A\x20\x20\x20\x20\x7D\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x54\x68\x65"
+    "\x20\x73\x68\x61\x64\x6F\x77\x20\x69\x73\x20\x74\x68\x65\x20\x73\x68\x61\x70\x65\x20\x6F\x66\x20"
+    "\x74\x68\x65\x20\x67\x6C\x79\x70\x68\x20\x61\x6E\x64\x20\x69\x74\x73\x20\x6F\x75\x74\x6C\x69\x6E"
+    "\x65\x2C\x20\x73\x61\x6D\x70\x6C\x65\x64\x20\x61\x74\x20\x61\x6E\x20\x6F\x66\x66\x73\x65\x74\x0A"
+    "\x20\x20\x20\x20\x69\x66\x20\x28\x73\x68\x61\x64\x6F\x77\x5F\x63\x6F\x6C\x6F\x72\x2E\x61\x20\x3E"
+    "\x20\x30\x2E\x30\x29\x20\x7B\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x73\x68"
+    "\x61\x64\x6F\x77\x20\x3D\x20\x73\x6D\x6F\x6F\x74\x68\x73\x74\x65\x70\x28\x65\x64\x67\x65\x20\x2D"
+    "\x20\x61\x61\x2C\x20\x65\x64\x67\x65\x20\x2B\x20\x61\x61\x2C\x20\x73\x61\x6D\x70\x6C\x65\x44\x69"
+    "\x73\x74\x61\x6E\x63\x65\x28\x75\x76\x20\x2D\x20\x73\x68\x61\x64\x6F\x77\x5F\x6F\x66\x66\x73\x65"
+    "\x74\x20\x2A\x20\x74\x65\x78\x65\x6C\x29\x29\x3B\x0A\x20\x20\x20\x20\x20\x20\x20\x20\x67\x6C\x79"
+    "\x70\x68\x20\x3D\x20\x6F\x76\x65\x72\x28\x67\x6C\x79\x70\x68\x2C\x20\x76\x65\x63\x34\x28\x73\x68"
+    "\x61\x64\x6F\x77\x5F\x63\x6F\x6C\x6F\x72\x2E\x72\x67\x62\x2C\x20\x73\x68\x61\x64\x6F\x77\x5F\x63"
+    "\x6F\x6C\x6F\x72\x2E\x61\x20\x2A\x20\x74\x69\x6E\x74\x2E\x61\x20\x2A\x20\x73\x68\x61\x64\x6F\x77"
+    "\x29\x29\x3B\x0A\x20\x20\x20\x20\x7D\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x67"
+    "\x6C\x79\x70\x68\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x68\x75\x65\x20"
+    "\x73\x68\x69\x66\x74\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61\x6E\x67\x6C\x65\x20\x3D\x20"
+    "\x63\x6F\x73\x28\x72\x61\x64\x69\x61\x6E\x73\x28\x68\x75\x65\x29\x29\x3B\x0A\x20\x20\x20\x20\x76"
+    "\x65\x63\x33\x20\x72\x67\x62\x20\x3D\x20\x76\x65\x63\x33\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67"
+    "\x62\x20\x2A\x20\x61\x6E\x67\x6C\x65\x20\x2B\x20\x63\x72\x6F\x73\x73\x28\x6B\x2C\x20\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x72\x67\x62\x29\x20\x2A\x20\x73\x69\x6E\x28\x72\x61\x64\x69\x61\x6E\x73\x28\x68"
+    "\x75\x65\x29\x29\x20\x2B\x20\x6B\x20\x2A\x20\x64\x6F\x74\x28\x6B\x2C\x20\x72\x65\x73\x75\x6C\x74"
+    "\x2E\x72\x67\x62\x29\x20\x2A\x20\x28\x31\x2E\x30\x20\x2D\x20\x61\x6E\x67\x6C\x65\x29\x29\x3B\x0A"
+    "\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x72\x67\x62\x2C\x20\x72"
+    "\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20"
+    "\x63\x6F\x6C\x6F\x72\x20\x62\x6C\x65\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C"
+    "\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x6D\x69\x78\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67\x62\x2C"
+    "\x20\x63\x6F\x6C\x6F\x72\x2E\x72\x67\x62\x2C\x20\x63\x6F\x6C\x6F\x72\x2E\x61\x29\x2C\x20\x72\x65"
+    "\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x74"
+    "\x6F\x6E\x65\x20\x62\x6C\x65\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x66\x6C\x6F\x61\x74\x20\x61"
+    "\x76\x67\x20\x3D\x20\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2B\x20\x72\x65\x73\x75\x6C\x74\x2E"
+    "\x67\x20\x2B\x20\x72\x65\x73\x75\x6C\x74\x2E\x62\x29\x20\x2F\x20\x33\x2E\x30\x3B\x0A\x20\x20\x20"
+    "\x20\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x20\x3D\x20\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2D\x20"
+    "\x28\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x20\x2D\x20\x61\x76\x67\x29\x20\x2A\x20\x74\x6F\x6E\x65"
+    "\x2E\x61\x29\x3B\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x2E\x67\x20\x20\x3D\x20\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x67\x20\x2D\x20\x28\x28\x72\x65\x73\x75\x6C\x74\x2E\x67\x20\x2D\x20\x61\x76\x67"
+    "\x29\x20\x2A\x20\x74\x6F\x6E\x65\x2E\x61\x29\x3B\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x2E"
+    "\x62\x20\x20\x3D\x20\x72\x65\x73\x75\x6C\x74\x2E\x62\x20\x2D\x20\x28\x28\x72\x65\x73\x75\x6C\x74"
+    "\x2E\x62\x20\x2D\x20\x61\x76\x67\x29\x20\x2A\x20\x74\x6F\x6E\x65\x2E\x61\x29\x3B\x0A\x20\x20\x20"
+    "\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28\x63\x6C\x61\x6D\x70\x28\x72\x65\x73"
+    "\x75\x6C\x74\x2E\x72\x67\x62\x20\x2B\x20\x74\x6F\x6E\x65\x2E\x72\x67\x62\x2C\x20\x30\x2E\x30\x2C"
+    "\x20\x31\x2E\x30\x29\x2C\x20\x72\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A\x0A\x20\x20\x20\x20\x2F"
+    "\x2F\x20\x46\x6C\x61\x73\x68\x20\x65\x66\x66\x65\x63\x74\x20\x63\x6F\x6C\x6F\x72\x20\x62\x6C\x65"
+    "\x6E\x64\x69\x6E\x67\x0A\x20\x20\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x3D\x20\x76\x65\x63\x34\x28"
+    "\x6D\x69\x78\x28\x72\x65\x73\x75\x6C\x74\x2E\x72\x67\x62\x2C\x20\x66\x6C\x61\x73\x68\x2E\x72\x67"
+    "\x62\x2C\x20\x66\x6C\x61\x73\x68\x2E\x61\x29\x2C\x20\x72\x65\x73\x75\x6C\x74\x2E\x61\x29\x3B\x0A"
+    "\x0A\x20\x20\x20\x20\x2F\x2F\x20\x41\x70\x70\x6C\x79\x20\x6F\x70\x61\x63\x69\x74\x79\x0A\x20\x20"
+    "\x20\x20\x72\x65\x73\x75\x6C\x74\x20\x2A\x3D\x20\x6F\x70\x61\x63\x69\x74\x79\x3B\x0A\x7D";
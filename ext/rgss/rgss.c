@@ -13,11 +13,6 @@ ID RGSS_ID_RENDER;
 ID RGSS_ID_UPDATE;
 ID RGSS_ID_ADD;
 
-struct xoshiro256ss_state
-{
-    uint64_t s[4];
-};
-
 struct xoshiro256ss_state RGSS_RAND_STATE;
 
 static inline uint64_t rol64(uint64_t x, int k)
@@ -51,6 +46,71 @@ static inline double to_double(uint64_t x)
     return u.d - 1.0;
 }
 
+static void RGSS_Rand_JumpBy(RGSS_RandState *state, const uint64_t *polynomial)
+{
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++)
+    {
+        for (int b = 0; b < 64; b++)
+        {
+            if (polynomial[i] & UINT64_C(1) << b)
+            {
+                s[0] ^= state->s[0];
+                s[1] ^= state->s[1];
+                s[2] ^= state->s[2];
+                s[3] ^= state->s[3];
+            }
+            xoshiro256ss(state);
+        }
+    }
+    memcpy(state->s, s, sizeof(s));
+}
+
+void RGSS_Rand_Jump(RGSS_RandState *state)
+{
+    // Equivalent to 2^128 calls to xoshiro256ss
+    static const uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    RGSS_Rand_JumpBy(state, JUMP);
+}
+
+void RGSS_Rand_LongJump(RGSS_RandState *state)
+{
+    // Equivalent to 2^192 calls to xoshiro256ss
+    static const uint64_t JUMP[] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635};
+    RGSS_Rand_JumpBy(state, JUMP);
+}
+
+void RGSS_Rand_Stream(RGSS_RandState *stream)
+{
+    // The stream takes the next 2^192 values of the global sequence, which then continues after them, so streams can
+    // be split further without overlapping the next one
+    *stream = RGSS_RAND_STATE;
+    RGSS_Rand_LongJump(&RGSS_RAND_STATE);
+}
+
+void RGSS_Rand_Split(RGSS_RandState *state, RGSS_RandState *stream)
+{
+    *stream = *state;
+    RGSS_Rand_Jump(state);
+}
+
+void RGSS_Rand_Seed(RGSS_RandState *state, uint64_t seed)
+{
+    // SplitMix64, as recommended for seeding xoshiro generators, which never gives a state of all zeros
+    for (int i = 0; i < 4; i++)
+    {
+        uint64_t z = (seed += UINT64_C(0x9e3779b97f4a7c15));
+        z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+        state->s[i] = z ^ (z >> 31);
+    }
+}
+
+float RGSS_Rand_Next(RGSS_RandState *state)
+{
+    return (float)to_double(xoshiro256ss(state));
+}
+
 void RGSS_Log(RGSS_LOG_LEVEL level, const char *format, ...)
 {
     if (!RTEST(RGSS_LOGGER))
@@ -122,6 +182,16 @@ char *RGSS_ReadFileDescriptorText(int fd)
 
 char *RGSS_ReadFileText(const char *path)
 {
+    RGSS_Resource resource;
+    if (RGSS_Archive_Find(path, &resource))
+    {
+        char *buffer = xmalloc(resource.size + 1);
+        memcpy(buffer, resource.data, resource.size);
+        buffer[resource.size] = '\0';
+        RGSS_Resource_Free(&resource);
+        return buffer;
+    }
+
     VALUE file = rb_file_open(path, "rb");
     rb_io_t *io;
 
@@ -134,6 +204,20 @@ char *RGSS_ReadFileText(const char *path)
 
 void *RGSS_ReadFile(const char *path, long *bufsize)
 {
+    RGSS_Resource resource;
+    if (RGSS_Archive_Find(path, &resource))
+    {
+        void *buffer = resource.buffer;
+        if (buffer == NULL)
+        {
+            buffer = xmalloc(RGSS_MAX(resource.size, 1));
+            memcpy(buffer, resource.data, resource.size);
+        }
+        if (bufsize)
+            *bufsize = (long)resource.size;
+        return buffer;
+    }
+
     VALUE file = rb_file_open(path, "rb");
     rb_io_t *io;
 
@@ -163,31 +247,15 @@ char *RGSS_ReadFileTextRB(VALUE source)
     if (FIXNUM_P(source))
         return RGSS_ReadFileDescriptorText(NUM2INT(source));
 
-    VALUE file;
-    int close;
+    if (RB_TYPE_P(source, T_STRING))
+        return RGSS_ReadFileText(StringValueCStr(source));
 
-    if (RB_TYPE_P(source, T_FILE))
-    {
-        file = source;
-        close = false;
-    }
-    else if (RB_TYPE_P(source, T_STRING))
-    {
-        file = rb_file_open(StringValueCStr(source), "rb");
-        close = true;
-    }
-    else
-    {
+    if (!RB_TYPE_P(source, T_FILE))
         rb_raise(rb_eTypeError, "%s is not a String, File, or Integer", CLASS_NAME(source));
-    }
 
     rb_io_t *io;
     GetOpenFile(source, io);
-    char *buffer = RGSS_ReadFileDescriptorText(io->fd);
-    if (close)
-        rb_io_close(file);
-
-    return buffer;
+    return RGSS_ReadFileDescriptorText(io->fd);
 }
 
 inline void RGSS_ParseRect(int argc, VALUE *argv, RGSS_Rect *rect)
@@ -242,6 +310,8 @@ void Init_rgss(void)
     RGSS_Init_GLFW(rb_mRGSS);
     RGSS_Init_Game(rb_mRGSS);
     RGSS_Init_Graphics(rb_mRGSS);
+    RGSS_Init_Program(rb_cShader);
+    RGSS_Init_Transition(rb_mGraphics);
     RGSS_Init_Input(rb_mRGSS);
 
     RGSS_Init_Batch(rb_mGraphics);
@@ -254,8 +324,12 @@ void Init_rgss(void)
     RGSS_Init_Mat4(rb_mRGSS);
     RGSS_Init_Entity(rb_mRGSS);
     RGSS_Init_Texture(rb_mRGSS);
+    RGSS_Init_Bitmap(rb_mRGSS);
     RGSS_Init_Font(rb_mRGSS);
+    RGSS_Init_Text(rb_mRGSS);
     RGSS_Init_Particles(rb_mRGSS);
+    RGSS_Init_RNG(rb_mRGSS);
+    RGSS_Init_Archive(rb_mRGSS);
 
     rb_define_const(rb_mRGSS, "SIZEOF_VOIDP", INT2NUM(SIZEOF_VOIDP));
     rb_define_const(rb_mRGSS, "SIZEOF_CHAR", INT2NUM(1));
@@ -45,11 +45,12 @@ extern VALUE rb_cVideoMode;
 extern VALUE rb_cGamepad; // TODO
 extern VALUE rb_cGammaRamp;
 
-extern VALUE rb_mGL;    /** Module containing the OpenGL bindings. */
-extern VALUE rb_mAL;    /** Module containing the OpenAL bindings. */
-extern VALUE rb_mALC;   /** Module containing the context-related OpenAL bindings. */
-extern VALUE rb_cSound; /** Class representing a sound file. */
-extern VALUE rb_cImage; /** Class representing an image. */
+extern VALUE rb_mGL;      /** Module containing the OpenGL bindings. */
+extern VALUE rb_mAL;      /** Module containing the OpenAL bindings. */
+extern VALUE rb_mALC;     /** Module containing the context-related OpenAL bindings. */
+extern VALUE rb_cSound;   /** Class representing a sound file. */
+extern VALUE rb_cImage;   /** Class representing an image. */
+extern VALUE rb_cArchive; /** Class representing a packed file archive. */
 
 extern VALUE rb_mGraphics;
 extern VALUE rb_cShader;
@@ -61,8 +62,10 @@ extern VALUE rb_cViewport;
 extern VALUE rb_cSprite;
 extern VALUE rb_cPlane;
 extern VALUE rb_cTexture;
+extern VALUE rb_cBitmap;
 
 extern VALUE rb_cFont;
+extern VALUE rb_cText;
 
 extern VALUE rb_cTable;
 extern VALUE rb_cColor;
@@ -75,6 +78,7 @@ extern VALUE rb_cVec2;
 extern VALUE rb_cVec3;
 extern VALUE rb_cVec4;
 extern VALUE rb_cMat4; // TODO
+extern VALUE rb_cRNG;
 
 void RGSS_Init_GLFW(VALUE parent);
 void RGSS_Init_GL(VALUE parent);
@@ -93,13 +97,27 @@ void RGSS_Init_Mat4(VALUE parent);
 void RGSS_Init_Batch(VALUE parent);
 void RGSS_Init_Entity(VALUE parent);
 void RGSS_Init_Font(VALUE parent);
+void RGSS_Init_Text(VALUE parent);
 void RGSS_Init_Texture(VALUE parent);
+void RGSS_Init_Bitmap(VALUE parent);
 void RGSS_Init_Particles(VALUE parent);
+void RGSS_Init_Archive(VALUE parent);
+void RGSS_Init_Program(VALUE parent);
+void RGSS_Init_Transition(VALUE parent);
+void RGSS_Init_RNG(VALUE parent);
 
 VALUE RGSS_Handle_Alloc(VALUE klass);
 
 #define RGSS_HAS_FLAG(value, flag) (((value) & (flag)) != 0)
 
+typedef enum
+{
+    RGSS_FLIP_NONE = 0x00,
+    RGSS_FLIP_X = 0x01,
+    RGSS_FLIP_Y = 0x02,
+    RGSS_FLIP_BOTH = (RGSS_FLIP_X | RGSS_FLIP_Y)
+} RGSS_Flip;
+
 typedef vec4 RGSS_Color;
 typedef vec4 RGSS_Tone;
 
@@ -177,6 +195,13 @@ static inline VALUE RGSS_Rect_New(int x, int y, int w, int h)
 
 extern const char *SPRITE_VERT_SRC;
 extern const char *SPRITE_FRAG_SRC;
+extern const char *BLIT_VERT_SRC;
+extern const char *BLIT_FRAG_SRC;
+extern const char *TRANSITION_VERT_SRC;
+extern const char *TRANSITION_FRAG_SRC;
+extern const char *TEXT_VERT_SRC;
+extern const char *TEXT_FRAG_SRC;
+extern const char *TEXT_SDF_FRAG_SRC;
 
 static inline void *RGSS_MALLOC_ALIGNED(size_t size, size_t alignment)
 {
@@ -232,6 +257,102 @@ void RGSS_ParseRect(int argc, VALUE *argv, RGSS_Rect *rect); // TODO
  */
 float RGSS_Rand(void);
 
+/**
+ * @brief The state of a Xoshiro256** generator, which may be used as an independent stream of random numbers.
+ */
+typedef struct xoshiro256ss_state
+{
+    uint64_t s[4];
+} RGSS_RandState;
+
+/**
+ * @brief Advances the state of a generator by the next random number.
+ * @param[in,out] state The state of the generator.
+ * @return A random 64-bit integer.
+ */
+uint64_t xoshiro256ss(RGSS_RandState *state);
+
+/**
+ * @brief Advances a generator as if it generated 2^128 numbers, which is used to split a sequence into streams that
+ * never overlap.
+ * @param[in,out] state The state of the generator.
+ */
+void RGSS_Rand_Jump(RGSS_RandState *state);
+
+/**
+ * @brief Advances a generator as if it generated 2^192 numbers, which leaves room for 2^64 streams split from the
+ * skipped numbers with @ref RGSS_Rand_Jump.
+ * @param[in,out] state The state of the generator.
+ */
+void RGSS_Rand_LongJump(RGSS_RandState *state);
+
+/**
+ * @brief Initializes a stream of random numbers that never overlaps with the global generator or other streams,
+ * allowing it to be used from another thread without locking. Streams may be split further with
+ * @ref RGSS_Rand_Split.
+ * @param[out] stream The state to initialize.
+ */
+void RGSS_Rand_Stream(RGSS_RandState *stream);
+
+/**
+ * @brief Initializes a stream with the next 2^128 numbers of a generator, which then continues after them.
+ * @param[in,out] state The state of the generator to split the stream from.
+ * @param[out] stream The state to initialize.
+ */
+void RGSS_Rand_Split(RGSS_RandState *state, RGSS_RandState *stream);
+
+/**
+ * @brief Initializes a generator from a single number, so that the same seed always gives the same sequence.
+ * @param[out] state The state to initialize.
+ * @param[in] seed The seed.
+ */
+void RGSS_Rand_Seed(RGSS_RandState *state, uint64_t seed);
+
+/**
+ * @brief Returns a random float between @c 0.0 and @c 1.0 from a stream of random numbers.
+ * @param[in,out] state The state of the stream.
+ * @return A value between @c 0.0 and @c 1.0.
+ */
+float RGSS_Rand_Next(RGSS_RandState *state);
+
+#define RGSS_RAND_LANES 2 /** The number of streams advanced together when generating numbers in bulk. */
+
+/**
+ * @brief Streams of random numbers that are advanced together to generate numbers in bulk, using SIMD instructions
+ * where available. The order of the numbers is the same either way.
+ */
+typedef struct
+{
+    RGSS_RandState lane[RGSS_RAND_LANES]; /** The state of each stream. */
+} RGSS_RandLanes;
+
+/**
+ * @brief Initializes the streams used to generate numbers in bulk by splitting them from a generator.
+ * @param[in,out] state The state of the generator to split the streams from.
+ * @param[out] lanes The streams to initialize.
+ */
+void RGSS_Rand_SplitLanes(RGSS_RandState *state, RGSS_RandLanes *lanes);
+
+/**
+ * @brief Fills an array with random floats within a range.
+ * @param[in,out] lanes The streams to generate the numbers with.
+ * @param[out] values The array to fill, which does not need to be aligned.
+ * @param[in] count The number of values to fill.
+ * @param[in] min The lower bound (inclusive).
+ * @param[in] max The upper bound (exclusive).
+ */
+void RGSS_Rand_FillFloats(RGSS_RandLanes *lanes, float *values, long count, float min, float max);
+
+/**
+ * @brief Fills an array with random integers within a range.
+ * @param[in,out] lanes The streams to generate the numbers with.
+ * @param[out] values The array to fill, which does not need to be aligned.
+ * @param[in] count The number of values to fill.
+ * @param[in] min The lower bound (inclusive).
+ * @param[in] max The upper bound (inclusive).
+ */
+void RGSS_Rand_FillInts(RGSS_RandLanes *lanes, int32_t *values, long count, int32_t min, int32_t max);
+
 /**
  * @brief Converts a Ruby VALUE object into a C pointer, accepting multiple Ruby types.
  *
@@ -379,8 +500,31 @@ typedef struct
     int width;             /** The width of the image in pixel units. */
     int height;            /** The height of the image in pixel units. */
     unsigned char *pixels; /** The pixel data. */
+    int busy;              /** The number of threads reading the pixels without the GVL, or -1 while one writes them. */
 } RGSS_Image;
 
+typedef struct
+{
+    const void *data; /** The contents of the file. */
+    size_t size;      /** The size of the contents, in bytes. */
+    void *buffer;     /** Memory allocated for decompressed contents, or NULL when they point into the archive. */
+} RGSS_Resource;
+
+/**
+ * @brief Searches the mounted archives for a file, starting with the most recently mounted. Contents that are stored
+ * uncompressed point directly into the mapped archive and are not copied.
+ * @param[in] path The path of the file, which is matched case-insensitively with either path separator.
+ * @param[out] resource Receives the contents of the file when found. Must be released with @ref RGSS_Resource_Free.
+ * @return @c true if the file was found, otherwise @c false.
+ */
+int RGSS_Archive_Find(const char *path, RGSS_Resource *resource);
+
+/**
+ * @brief Releases memory associated with a resource found with @ref RGSS_Archive_Find.
+ * @param[in] resource The resource to free.
+ */
+void RGSS_Resource_Free(RGSS_Resource *resource);
+
 /**
  * @brief Read the context of the specified file descriptor into a buffer, raising an appropriate Ruby excpetion on
  * failure.
@@ -391,6 +535,7 @@ char *RGSS_ReadFileDescriptorText(int fd);
 
 /**
  * @brief Read the context of the specified file into a buffer, raising an appropriate Ruby excpetion on failure.
+ * Mounted archives are searched before the file system.
  * @param[in] path The path of the file to read.
  * @return A null-terminated buffer containing the file text The pointer must be freed when done with it.
  */
@@ -405,6 +550,7 @@ char *RGSS_ReadFileTextRB(VALUE source);
 
 /**
  * @brief Read the contents of the file specified file into a buffer, raising an appropriate Ruby excpetion on failure.
+ * Mounted archives are searched before the file system.
  * @param[in] path The path of the file to read.
  * @param[in,out] bufsize The number of bytes contained in the returned buffer.
  * @return A buffer containing the file contents. The pointer must be freed when done with it.
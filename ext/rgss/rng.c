@@ -0,0 +1,267 @@
+#include "rgss.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define RGSS_RNG_SSE2 1
+#include <emmintrin.h>
+#endif
+
+VALUE rb_cRNG;
+
+typedef struct
+{
+    RGSS_RandState state; /** The stream single numbers are generated from, and further streams are split from. */
+    RGSS_RandLanes lanes; /** The streams numbers are generated from in bulk. */
+} RGSS_RNG;
+
+void RGSS_Rand_SplitLanes(RGSS_RandState *state, RGSS_RandLanes *lanes)
+{
+    for (int i = 0; i < RGSS_RAND_LANES; i++)
+        RGSS_Rand_Split(state, &lanes->lane[i]);
+}
+
+#ifdef RGSS_RNG_SSE2
+
+static inline __m128i RGSS_Rotate_SSE2(__m128i x, int k)
+{
+    return _mm_or_si128(_mm_slli_epi64(x, k), _mm_srli_epi64(x, 64 - k));
+}
+
+/**
+ * @brief Advances both lanes of a generator at once. The multiplications by 5 and 9 are done with shifts and adds,
+ * as SSE2 has no 64-bit multiply.
+ * @param[in,out] s The words of the state, each holding the same word of both lanes.
+ * @return The next 64-bit number of each lane, which is the same as four 32-bit numbers.
+ */
+static inline __m128i RGSS_Xoshiro_SSE2(__m128i s[4])
+{
+    __m128i x = _mm_add_epi64(_mm_slli_epi64(s[1], 2), s[1]);
+    x = RGSS_Rotate_SSE2(x, 7);
+    __m128i result = _mm_add_epi64(_mm_slli_epi64(x, 3), x);
+    __m128i t = _mm_slli_epi64(s[1], 17);
+
+    s[2] = _mm_xor_si128(s[2], s[0]);
+    s[3] = _mm_xor_si128(s[3], s[1]);
+    s[1] = _mm_xor_si128(s[1], s[2]);
+    s[0] = _mm_xor_si128(s[0], s[3]);
+
+    s[2] = _mm_xor_si128(s[2], t);
+    s[3] = RGSS_Rotate_SSE2(s[3], 45);
+    return result;
+}
+
+static inline void RGSS_Lanes_Load(RGSS_RandLanes *lanes, __m128i s[4])
+{
+    for (int i = 0; i < 4; i++)
+        s[i] = _mm_set_epi64x((long long)lanes->lane[1].s[i], (long long)lanes->lane[0].s[i]);
+}
+
+static inline void RGSS_Lanes_Store(RGSS_RandLanes *lanes, __m128i s[4])
+{
+    uint64_t words[2];
+    for (int i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128((__m128i *)words, s[i]);
+        lanes->lane[0].s[i] = words[0];
+        lanes->lane[1].s[i] = words[1];
+    }
+}
+
+#endif /* RGSS_RNG_SSE2 */
+
+/**
+ * @brief Generates the next four 32-bit numbers from both lanes, in the same order as the SSE2 path.
+ */
+static inline void RGSS_Lanes_Next(RGSS_RandLanes *lanes, uint32_t bits[4])
+{
+    uint64_t a = xoshiro256ss(&lanes->lane[0]);
+    uint64_t b = xoshiro256ss(&lanes->lane[1]);
+    bits[0] = (uint32_t)a;
+    bits[1] = (uint32_t)(a >> 32);
+    bits[2] = (uint32_t)b;
+    bits[3] = (uint32_t)(b >> 32);
+}
+
+static inline float RGSS_Bits_ToFloat(uint32_t bits, float min, float range)
+{
+    // Places the top 23 bits in the mantissa of a float between 1.0 and 2.0
+    union {
+        uint32_t i;
+        float f;
+    } u = {.i = (bits >> 9) | 0x3F800000};
+    return ((u.f - 1.0f) * range) + min;
+}
+
+static inline int32_t RGSS_Bits_ToInt(uint32_t bits, int32_t min, uint32_t span)
+{
+    // Scales by multiplying instead of a modulo, a span of 0 is the full 32-bit range
+    return span ? (int32_t)((uint32_t)min + (uint32_t)(((uint64_t)bits * span) >> 32)) : (int32_t)bits;
+}
+
+void RGSS_Rand_FillFloats(RGSS_RandLanes *lanes, float *values, long count, float min, float max)
+{
+    const float range = max - min;
+    long i = 0;
+#ifdef RGSS_RNG_SSE2
+    __m128i s[4];
+    RGSS_Lanes_Load(lanes, s);
+    const __m128i one = _mm_set1_epi32(0x3F800000);
+    const __m128 lower = _mm_set1_ps(min), scale = _mm_set1_ps(range), offset = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 f = _mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(RGSS_Xoshiro_SSE2(s), 9), one));
+        _mm_storeu_ps(&values[i], _mm_add_ps(_mm_mul_ps(_mm_sub_ps(f, offset), scale), lower));
+    }
+    RGSS_Lanes_Store(lanes, s);
+#endif
+
+    uint32_t bits[4];
+    for (; i < count; i += 4)
+    {
+        RGSS_Lanes_Next(lanes, bits);
+        for (long j = 0; j < 4 && i + j < count; j++)
+            values[i + j] = RGSS_Bits_ToFloat(bits[j], min, range);
+    }
+}
+
+void RGSS_Rand_FillInts(RGSS_RandLanes *lanes, int32_t *values, long count, int32_t min, int32_t max)
+{
+    const uint32_t span = (uint32_t)max - (uint32_t)min + 1;
+    long i = 0;
+#ifdef RGSS_RNG_SSE2
+    __m128i s[4];
+    RGSS_Lanes_Load(lanes, s);
+    const __m128i lower = _mm_set1_epi32(min), multiplier = _mm_set1_epi32((int)span);
+    const __m128i high = _mm_set_epi32(-1, 0, -1, 0);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i bits = RGSS_Xoshiro_SSE2(s);
+        if (span)
+        {
+            // Keep the high half of each 64-bit product, the even lanes shifted down and the odd lanes in place
+            __m128i even = _mm_srli_epi64(_mm_mul_epu32(bits, multiplier), 32);
+            __m128i odd = _mm_and_si128(_mm_mul_epu32(_mm_srli_epi64(bits, 32), multiplier), high);
+            bits = _mm_add_epi32(_mm_or_si128(even, odd), lower);
+        }
+        _mm_storeu_si128((__m128i *)&values[i], bits);
+    }
+    RGSS_Lanes_Store(lanes, s);
+#endif
+
+    uint32_t bits[4];
+    for (; i < count; i += 4)
+    {
+        RGSS_Lanes_Next(lanes, bits);
+        for (long j = 0; j < 4 && i + j < count; j++)
+            values[i + j] = RGSS_Bits_ToInt(bits[j], min, span);
+    }
+}
+
+static VALUE RGSS_RNG_Alloc(VALUE klass)
+{
+    RGSS_RNG *rng = ALLOC(RGSS_RNG);
+    memset(rng, 0, sizeof(RGSS_RNG));
+    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, rng);
+}
+
+static VALUE RGSS_RNG_Initialize(int argc, VALUE *argv, VALUE self)
+{
+    VALUE seed;
+    rb_scan_args(argc, argv, "01", &seed);
+
+    RGSS_RNG *rng = DATA_PTR(self);
+    if (NIL_P(seed))
+        RGSS_Rand_Stream(&rng->state);
+    else
+        RGSS_Rand_Seed(&rng->state, NUM2ULL(seed));
+    RGSS_Rand_SplitLanes(&rng->state, &rng->lanes);
+    return self;
+}
+
+static VALUE RGSS_RNG_Split(VALUE self)
+{
+    RGSS_RNG *rng = DATA_PTR(self);
+    VALUE stream = RGSS_RNG_Alloc(CLASS_OF(self));
+    RGSS_RNG *other = DATA_PTR(stream);
+    RGSS_Rand_Split(&rng->state, &other->state);
+    RGSS_Rand_SplitLanes(&other->state, &other->lanes);
+    return stream;
+}
+
+static VALUE RGSS_RNG_Rand(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_RNG *rng = DATA_PTR(self);
+    if (argc == 0)
+        return DBL2NUM(RGSS_Rand_Next(&rng->state));
+
+    if (argc != 2)
+        rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 0 or 2)", argc);
+
+    int64_t lower = NUM2LL(argv[0]);
+    int64_t upper = NUM2LL(argv[1]);
+    if (lower > upper)
+        rb_raise(rb_eArgError, "upper bound cannot be less than lower bound");
+
+    int64_t n = (int64_t)((xoshiro256ss(&rng->state) % (uint64_t)(upper - lower + 1)) + lower);
+    return LL2NUM(n);
+}
+
+static VALUE RGSS_RNG_Fill(int argc, VALUE *argv, VALUE self)
+{
+    VALUE buffer, min, max;
+    rb_scan_args(argc, argv, "12", &buffer, &min, &max);
+    if (argc == 2)
+        rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 1 or 3)", argc);
+
+    RGSS_RNG *rng = DATA_PTR(self);
+    int integers = RB_INTEGER_TYPE_P(min) && RB_INTEGER_TYPE_P(max);
+    if (integers && NUM2INT(min) > NUM2INT(max))
+        rb_raise(rb_eArgError, "upper bound cannot be less than lower bound");
+    float lower = NIL_P(min) ? 0.0f : NUM2FLT(min);
+    float upper = NIL_P(max) ? 1.0f : NUM2FLT(max);
+
+    if (RB_TYPE_P(buffer, T_STRING))
+    {
+        // Packed as native 32-bit values, the same as Array#pack with "f*" or "l*"
+        rb_str_modify(buffer);
+        long count = RSTRING_LEN(buffer) / 4;
+        void *values = RSTRING_PTR(buffer);
+        if (integers)
+            RGSS_Rand_FillInts(&rng->lanes, values, count, NUM2INT(min), NUM2INT(max));
+        else
+            RGSS_Rand_FillFloats(&rng->lanes, values, count, lower, upper);
+        return buffer;
+    }
+
+    if (!RB_TYPE_P(buffer, T_ARRAY))
+        rb_raise(rb_eTypeError, "%s is not a String or Array", CLASS_NAME(buffer));
+
+    rb_ary_modify(buffer);
+    VALUE temp;
+    long count = RARRAY_LEN(buffer);
+    if (integers)
+    {
+        int32_t *values = ALLOCV_N(int32_t, temp, RGSS_MAX(count, 1));
+        RGSS_Rand_FillInts(&rng->lanes, values, count, NUM2INT(min), NUM2INT(max));
+        for (long i = 0; i < count; i++)
+            rb_ary_store(buffer, i, INT2NUM(values[i]));
+    }
+    else
+    {
+        float *values = ALLOCV_N(float, temp, RGSS_MAX(count, 1));
+        RGSS_Rand_FillFloats(&rng->lanes, values, count, lower, upper);
+        for (long i = 0; i < count; i++)
+            rb_ary_store(buffer, i, DBL2NUM(values[i]));
+    }
+    ALLOCV_END(temp);
+    return buffer;
+}
+
+void RGSS_Init_RNG(VALUE parent)
+{
+    rb_cRNG = rb_define_class_under(parent, "RNG", rb_cObject);
+    rb_define_alloc_func(rb_cRNG, RGSS_RNG_Alloc);
+    rb_define_methodm1(rb_cRNG, "initialize", RGSS_RNG_Initialize, -1);
+    rb_define_methodm1(rb_cRNG, "rand", RGSS_RNG_Rand, -1);
+    rb_define_methodm1(rb_cRNG, "fill", RGSS_RNG_Fill, -1);
+    rb_define_method0(rb_cRNG, "split", RGSS_RNG_Split, 0);
+}
@@ -0,0 +1,958 @@
+#include "font.h"
+#include "graphics.h"
+
+#define RGSS_GLYPH_PADDING 1 /** Transparent border around each glyph, so filtering never samples its neighbors. */
+
+#define RGSS_GLYPH_OFFSET(base, field) ((base) + offsetof(RGSS_GlyphQuad, field))
+
+#define RGSS_SDF_INF 1e20f /** Squared distance of samples that have no nearest pixel yet. */
+
+VALUE rb_cText;
+
+typedef struct
+{
+    RGSS_Renderable base; /** The base Renderable structure. */
+    VALUE font;           /** The Ruby Font the text is laid out with. */
+    VALUE text;           /** The Ruby String of text or markup being drawn. */
+    int align;            /** The alignment of lines. */
+    int wrap;             /** The width in pixels lines are wrapped at, or @c -1 to not wrap. */
+    int plain;            /** Flag indicating if the text is drawn as-is instead of parsed as markup. */
+    int sdf;              /** Flag indicating if glyphs are drawn from distance fields. */
+    RGSS_Color outline;   /** The color of the outline, only drawn with distance fields. */
+    float outline_width;  /** The width of the outline in pixels, or @c 0 for none. */
+    RGSS_Color shadow;    /** The color of the drop shadow, only drawn with distance fields. */
+    vec2 shadow_offset;   /** The offset of the drop shadow, in pixels. */
+    float reveal;         /** The number of glyphs shown, or a negative value to show all of them. */
+    float reveal_fade;    /** The number of glyphs the fade-in of revealed glyphs spans, or @c 0 to not fade. */
+    float reveal_speed;   /** The number of glyphs revealed each update. */
+    RGSS_GlyphRun run;    /** The positioned glyphs of the text. */
+    GLuint instances;     /** The buffer the glyphs are uploaded to as per-instance attributes. */
+    GLsizeiptr capacity;  /** The size of the instance buffer, in bytes. */
+} RGSS_Text;
+
+/**
+ * @brief A set of textures glyphs are packed into, with the glyphs stored in them.
+ */
+typedef struct
+{
+    RGSS_Glyph *glyphs; /** All glyphs that have been rasterized, by font and glyph index. */
+    vec_t(GLuint) pages; /** The textures of the atlas pages, glyphs are only ever added to the last one. */
+    int x;               /** The horizontal position of the next glyph in the current shelf. */
+    int y;               /** The top of the current shelf. */
+    int shelf;           /** The height of the tallest glyph in the current shelf. */
+} RGSS_GlyphAtlas;
+
+/**
+ * @brief Maps a font to the same face at the reference size distance fields are generated at.
+ */
+typedef struct
+{
+    PangoFont *font;      /** The font glyphs are shaped with. */
+    PangoFont *reference; /** The same face at the reference size. */
+    float scale;          /** The size of the font relative to the reference size. */
+    UT_hash_handle hh;    /** Makes the structure hashable by font. */
+} RGSS_GlyphFace;
+
+static RGSS_GlyphAtlas RGSS_GLYPHS;     /** Glyphs stored as coverage, drawn at the size they were shaped at. */
+static RGSS_GlyphAtlas RGSS_SDF_GLYPHS; /** Glyphs stored as distance fields, drawn at any size. */
+static RGSS_GlyphFace *RGSS_GLYPH_FACES;
+
+/**
+ * @brief The corners of a unit quad, drawn as a triangle strip.
+ */
+static const GLfloat RGSS_TEXT_CORNERS[] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+
+static void RGSS_GlyphAtlas_AddPage(RGSS_GlyphAtlas *atlas)
+{
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Cleared so the area between glyphs never contains undefined data
+    void *zeros = xcalloc(RGSS_GLYPH_PAGE_SIZE * RGSS_GLYPH_PAGE_SIZE, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, RGSS_GLYPH_PAGE_SIZE, RGSS_GLYPH_PAGE_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE,
+                 zeros);
+    xfree(zeros);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+    vec_push(&atlas->pages, texture);
+    atlas->x = 0;
+    atlas->y = 0;
+    atlas->shelf = 0;
+    RGSS_LogDebug("Created %s atlas page %d (%dx%d)", atlas == &RGSS_SDF_GLYPHS ? "distance field" : "glyph",
+                  atlas->pages.length, RGSS_GLYPH_PAGE_SIZE, RGSS_GLYPH_PAGE_SIZE);
+}
+
+static void RGSS_GlyphAtlas_Allocate(RGSS_GlyphAtlas *atlas, int width, int height, int *page, int *x, int *y)
+{
+    // Glyphs are packed left to right in shelves, starting a new shelf or page when one is full
+    if (atlas->x + width > RGSS_GLYPH_PAGE_SIZE)
+    {
+        atlas->x = 0;
+        atlas->y += atlas->shelf;
+        atlas->shelf = 0;
+    }
+    if (atlas->pages.length == 0 || atlas->y + height > RGSS_GLYPH_PAGE_SIZE)
+        RGSS_GlyphAtlas_AddPage(atlas);
+
+    *page = atlas->pages.length - 1;
+    *x = atlas->x;
+    *y = atlas->y;
+    atlas->x += width;
+    atlas->shelf = RGSS_MAX(atlas->shelf, height);
+}
+
+static void RGSS_GlyphAtlas_Store(RGSS_GlyphAtlas *atlas, RGSS_Glyph *glyph, const unsigned char *data, int stride,
+                                  int width, int height)
+{
+    int x, y;
+    RGSS_GlyphAtlas_Allocate(atlas, width, height, &glyph->page, &x, &y);
+    glBindTexture(GL_TEXTURE_2D, atlas->pages.data[glyph->page]);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+    const float scale = 1.0f / RGSS_GLYPH_PAGE_SIZE;
+    glyph->uv[0] = x * scale;
+    glyph->uv[1] = y * scale;
+    glyph->uv[2] = (x + width) * scale;
+    glyph->uv[3] = (y + height) * scale;
+    glyph->width = width;
+    glyph->height = height;
+}
+
+static cairo_surface_t *RGSS_Glyph_Render(RGSS_Glyph *glyph, int padding, PangoRectangle *ink)
+{
+    pango_font_get_glyph_extents(glyph->key.font, glyph->key.glyph, ink, NULL);
+    pango_extents_to_pixels(ink, NULL);
+    if (ink->width <= 0 || ink->height <= 0)
+        return NULL;
+
+    int width = ink->width + (padding * 2);
+    int height = ink->height + (padding * 2);
+    if (width > RGSS_GLYPH_PAGE_SIZE || height > RGSS_GLYPH_PAGE_SIZE)
+    {
+        RGSS_LogWarn("Glyph of %dx%d pixels is too large for the glyph atlas", width, height);
+        return NULL;
+    }
+
+    // Draw the glyph with its origin offset so the ink box starts at the padding
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_A8, width, height);
+    cairo_t *context = cairo_create(surface);
+    PangoGlyphString *glyphs = pango_glyph_string_new();
+    pango_glyph_string_set_size(glyphs, 1);
+    memset(glyphs->glyphs, 0, sizeof(PangoGlyphInfo));
+    glyphs->glyphs[0].glyph = glyph->key.glyph;
+    glyphs->glyphs[0].attr.is_cluster_start = 1;
+    glyphs->log_clusters[0] = 0;
+    cairo_move_to(context, padding - ink->x, padding - ink->y);
+    pango_cairo_show_glyph_string(context, glyph->key.font, glyphs);
+    pango_glyph_string_free(glyphs);
+    cairo_destroy(context);
+    cairo_surface_flush(surface);
+
+    glyph->x = ink->x - padding;
+    glyph->y = ink->y - padding;
+    return surface;
+}
+
+static void RGSS_Glyph_Rasterize(RGSS_Glyph *glyph)
+{
+    PangoRectangle ink;
+    cairo_surface_t *surface = RGSS_Glyph_Render(glyph, RGSS_GLYPH_PADDING, &ink);
+    if (surface == NULL)
+        return;
+
+    RGSS_GlyphAtlas_Store(&RGSS_GLYPHS, glyph, cairo_image_surface_get_data(surface),
+                          cairo_image_surface_get_stride(surface), cairo_image_surface_get_width(surface),
+                          cairo_image_surface_get_height(surface));
+    cairo_surface_destroy(surface);
+}
+
+static void RGSS_Glyph_Transform1D(const float *f, int n, float *d, int *v, float *z)
+{
+    // Lower envelope of parabolas rooted at each sample (Felzenszwalb and Huttenlocher)
+    int k = 0;
+    v[0] = 0;
+    z[0] = -RGSS_SDF_INF;
+    z[1] = RGSS_SDF_INF;
+    for (int q = 1; q < n; q++)
+    {
+        float s;
+        while (true)
+        {
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            if (s > z[k] || k == 0)
+                break;
+            k--;
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = RGSS_SDF_INF;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; q++)
+    {
+        while (z[k + 1] < q)
+            k++;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+static void RGSS_Glyph_Transform(float *grid, int width, int height)
+{
+    // Squared euclidean distance transform, separated into a pass over columns and then rows
+    int n = RGSS_MAX(width, height);
+    float *f = xmalloc(n * sizeof(float));
+    float *d = xmalloc(n * sizeof(float));
+    float *z = xmalloc((n + 1) * sizeof(float));
+    int *v = xmalloc(n * sizeof(int));
+
+    for (int x = 0; x < width; x++)
+    {
+        for (int y = 0; y < height; y++)
+            f[y] = grid[y * width + x];
+        RGSS_Glyph_Transform1D(f, height, d, v, z);
+        for (int y = 0; y < height; y++)
+            grid[y * width + x] = d[y];
+    }
+    for (int y = 0; y < height; y++)
+    {
+        memcpy(f, &grid[y * width], width * sizeof(float));
+        RGSS_Glyph_Transform1D(f, width, &grid[y * width], v, z);
+    }
+
+    xfree(f);
+    xfree(d);
+    xfree(z);
+    xfree(v);
+}
+
+static void RGSS_Glyph_RasterizeDistance(RGSS_Glyph *glyph)
+{
+    // The padding is the spread, so the field falls off to nothing before reaching the edge of the glyph
+    PangoRectangle ink;
+    cairo_surface_t *surface = RGSS_Glyph_Render(glyph, RGSS_SDF_SPREAD, &ink);
+    if (surface == NULL)
+        return;
+
+    int width = cairo_image_surface_get_width(surface);
+    int height = cairo_image_surface_get_height(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+    unsigned char *coverage = cairo_image_surface_get_data(surface);
+
+    // Distances to the nearest pixel inside the glyph, and to the nearest pixel outside of it
+    size_t count = (size_t)width * height;
+    float *outside = xmalloc(count * sizeof(float));
+    float *inside = xmalloc(count * sizeof(float));
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int in = coverage[y * stride + x] >= 128;
+            outside[y * width + x] = in ? 0.0f : RGSS_SDF_INF;
+            inside[y * width + x] = in ? RGSS_SDF_INF : 0.0f;
+        }
+    }
+    RGSS_Glyph_Transform(outside, width, height);
+    RGSS_Glyph_Transform(inside, width, height);
+
+    // Stored with the outline at 0.5, positive inside, measured from the pixel edge rather than its center
+    unsigned char *field = xmalloc(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        float distance = sqrtf(inside[i]) - sqrtf(outside[i]);
+        distance += distance > 0.0f ? -0.5f : 0.5f;
+        float value = 0.5f + distance / (2.0f * RGSS_SDF_SPREAD);
+        field[i] = (unsigned char)(glm_clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    RGSS_GlyphAtlas_Store(&RGSS_SDF_GLYPHS, glyph, field, width, width, height);
+    xfree(field);
+    xfree(inside);
+    xfree(outside);
+    cairo_surface_destroy(surface);
+}
+
+static RGSS_Glyph *RGSS_GlyphAtlas_Get(RGSS_GlyphAtlas *atlas, PangoFont *font, PangoGlyph glyph)
+{
+    RGSS_Glyph *result, key;
+    memset(&key, 0, sizeof(RGSS_Glyph));
+    key.key.font = font;
+    key.key.glyph = glyph;
+
+    HASH_FIND(hh, atlas->glyphs, &key.key, sizeof(key.key), result);
+    if (result)
+        return result;
+
+    // Fonts are shared by the font map, the reference keeps the pointer from being reused while cached
+    result = ALLOC(RGSS_Glyph);
+    memset(result, 0, sizeof(RGSS_Glyph));
+    result->key.font = g_object_ref(font);
+    result->key.glyph = glyph;
+    if (atlas == &RGSS_SDF_GLYPHS)
+        RGSS_Glyph_RasterizeDistance(result);
+    else
+        RGSS_Glyph_Rasterize(result);
+    HASH_ADD(hh, atlas->glyphs, key, sizeof(result->key), result);
+    return result;
+}
+
+RGSS_Glyph *RGSS_Glyph_Get(PangoFont *font, PangoGlyph glyph)
+{
+    return RGSS_GlyphAtlas_Get(&RGSS_GLYPHS, font, glyph);
+}
+
+static RGSS_GlyphFace *RGSS_Glyph_GetFace(PangoFont *font)
+{
+    RGSS_GlyphFace *face;
+    HASH_FIND_PTR(RGSS_GLYPH_FACES, &font, face);
+    if (face)
+        return face;
+
+    // Glyph indices belong to the face, so the same face loaded at the reference size has the same glyphs
+    PangoFontDescription *desc = pango_font_describe_with_absolute_size(font);
+    double size = (double)pango_font_description_get_size(desc) / PANGO_SCALE;
+    pango_font_description_set_absolute_size(desc, RGSS_SDF_SIZE * PANGO_SCALE);
+    PangoFontMap *map = pango_font_get_font_map(font);
+    PangoContext *context = pango_font_map_create_context(map);
+    PangoFont *reference = pango_font_map_load_font(map, context, desc);
+    g_object_unref(context);
+    pango_font_description_free(desc);
+
+    face = ALLOC(RGSS_GlyphFace);
+    face->font = g_object_ref(font);
+    face->reference = reference ? reference : g_object_ref(font);
+    face->scale = reference ? (float)(size / RGSS_SDF_SIZE) : 1.0f;
+    HASH_ADD_PTR(RGSS_GLYPH_FACES, font, face);
+    return face;
+}
+
+RGSS_Glyph *RGSS_Glyph_GetDistance(PangoFont *font, PangoGlyph glyph, float *scale)
+{
+    RGSS_GlyphFace *face = RGSS_Glyph_GetFace(font);
+    *scale = face->scale;
+    return RGSS_GlyphAtlas_Get(&RGSS_SDF_GLYPHS, face->reference, glyph);
+}
+
+GLuint RGSS_Glyph_GetPage(int page, int sdf)
+{
+    RGSS_GlyphAtlas *atlas = sdf ? &RGSS_SDF_GLYPHS : &RGSS_GLYPHS;
+    return (page >= 0 && page < atlas->pages.length) ? atlas->pages.data[page] : GL_NONE;
+}
+
+static void RGSS_GlyphAtlas_Free(RGSS_GlyphAtlas *atlas)
+{
+    RGSS_Glyph *glyph, *temp;
+    HASH_ITER(hh, atlas->glyphs, glyph, temp)
+    {
+        HASH_DEL(atlas->glyphs, glyph);
+        g_object_unref(glyph->key.font);
+        xfree(glyph);
+    }
+
+    if (atlas->pages.length > 0)
+        glDeleteTextures(atlas->pages.length, atlas->pages.data);
+    vec_deinit(&atlas->pages);
+    atlas->x = 0;
+    atlas->y = 0;
+    atlas->shelf = 0;
+}
+
+void RGSS_Glyph_Deinit(void)
+{
+    RGSS_GlyphAtlas_Free(&RGSS_GLYPHS);
+    RGSS_GlyphAtlas_Free(&RGSS_SDF_GLYPHS);
+
+    RGSS_GlyphFace *face, *temp;
+    HASH_ITER(hh, RGSS_GLYPH_FACES, face, temp)
+    {
+        HASH_DEL(RGSS_GLYPH_FACES, face);
+        g_object_unref(face->font);
+        g_object_unref(face->reference);
+        xfree(face);
+    }
+}
+
+static void RGSS_GlyphRun_GetColor(PangoLayoutRun *item, const RGSS_Color color, vec4 result)
+{
+    glm_vec4_copy((float *)color, result);
+    for (GSList *node = item->item->analysis.extra_attrs; node != NULL; node = node->next)
+    {
+        PangoAttribute *attr = node->data;
+        if (attr->klass->type == PANGO_ATTR_FOREGROUND)
+        {
+            PangoColor *c = &((PangoAttrColor *)attr)->color;
+            result[0] = c->red / 65535.0f;
+            result[1] = c->green / 65535.0f;
+            result[2] = c->blue / 65535.0f;
+        }
+        else if (attr->klass->type == PANGO_ATTR_FOREGROUND_ALPHA)
+        {
+            result[3] = ((PangoAttrInt *)attr)->value / 65535.0f;
+        }
+    }
+}
+
+void RGSS_GlyphRun_Build(PangoLayout *layout, const RGSS_Color color, int sdf, RGSS_GlyphRun *run)
+{
+    vec_clear(&run->quads);
+    vec_clear(&run->batches);
+    run->sdf = sdf;
+    pango_layout_get_pixel_size(layout, &run->width, &run->height);
+
+    PangoLayoutIter *iter = pango_layout_get_iter(layout);
+    do
+    {
+        PangoLayoutRun *item = pango_layout_iter_get_run_readonly(iter);
+        if (item == NULL)
+            continue;
+
+        PangoRectangle logical;
+        pango_layout_iter_get_run_extents(iter, NULL, &logical);
+        int baseline = pango_layout_iter_get_baseline(iter);
+        int pen = logical.x;
+
+        vec4 tint;
+        RGSS_GlyphRun_GetColor(item, color, tint);
+
+        for (int i = 0; i < item->glyphs->num_glyphs; i++)
+        {
+            PangoGlyphInfo *info = &item->glyphs->glyphs[i];
+            PangoFont *font = item->item->analysis.font;
+            RGSS_Glyph *glyph = NULL;
+            float scale = 1.0f;
+            if (info->glyph != PANGO_GLYPH_EMPTY)
+                glyph = sdf ? RGSS_Glyph_GetDistance(font, info->glyph, &scale) : RGSS_Glyph_Get(font, info->glyph);
+
+            if (glyph && glyph->width > 0)
+            {
+                RGSS_GlyphQuad quad;
+                if (sdf)
+                {
+                    // Distance fields are drawn at any size, so positions are kept exact
+                    quad.dst[0] = (float)(pen + info->geometry.x_offset) / PANGO_SCALE + glyph->x * scale;
+                    quad.dst[1] = (float)(baseline + info->geometry.y_offset) / PANGO_SCALE + glyph->y * scale;
+                    quad.dst[2] = glyph->width * scale;
+                    quad.dst[3] = glyph->height * scale;
+                }
+                else
+                {
+                    // Pen positions are snapped to whole pixels, as glyphs are rasterized at the origin
+                    quad.dst[0] = (float)(PANGO_PIXELS(pen + info->geometry.x_offset) + glyph->x);
+                    quad.dst[1] = (float)(PANGO_PIXELS(baseline + info->geometry.y_offset) + glyph->y);
+                    quad.dst[2] = (float)glyph->width;
+                    quad.dst[3] = (float)glyph->height;
+                }
+                glm_vec4_copy(glyph->uv, quad.src);
+                glm_vec4_copy(tint, quad.color);
+                quad.page = glyph->page;
+                quad.index = (float)run->quads.length;
+                vec_push(&run->quads, quad);
+
+                RGSS_GlyphBatch *last = run->batches.length ? &vec_last(&run->batches) : NULL;
+                if (last && last->page == glyph->page)
+                {
+                    last->count++;
+                }
+                else
+                {
+                    RGSS_GlyphBatch batch = {glyph->page, run->quads.length - 1, 1};
+                    vec_push(&run->batches, batch);
+                }
+            }
+            pen += info->geometry.width;
+        }
+    } while (pango_layout_iter_next_run(iter));
+    pango_layout_iter_free(iter);
+}
+
+void RGSS_GlyphRun_Upload(RGSS_GlyphRun *run, GLuint buffer, GLsizeiptr *capacity)
+{
+    GLsizeiptr size = run->quads.length * sizeof(RGSS_GlyphQuad);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (size > *capacity)
+    {
+        // Grown geometrically, so text that changes often settles on a buffer that fits it
+        *capacity = RGSS_MAX(size, *capacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, *capacity, NULL, GL_DYNAMIC_DRAW);
+    }
+    if (size > 0)
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, run->quads.data);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+}
+
+void RGSS_GlyphRun_Setup(GLuint corners)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, corners);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, SIZEOF_FLOAT * 2, NULL);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+
+    // Per-instance attributes are sourced from the glyphs, the offsets are set when drawing each page
+    for (GLuint i = 1; i <= 4; i++)
+    {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+}
+
+void RGSS_GlyphRun_Draw(RGSS_GlyphRun *run, GLuint vao, GLuint buffer, int count)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    RGSS_GlyphBatch *batch;
+    int i;
+    vec_foreach_ptr(&run->batches, batch, i)
+    {
+        if (batch->start >= count)
+            break;
+
+        const GLsizei stride = sizeof(RGSS_GlyphQuad);
+        const char *base = (const char *)(batch->start * sizeof(RGSS_GlyphQuad));
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, RGSS_GLYPH_OFFSET(base, dst));
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, RGSS_GLYPH_OFFSET(base, src));
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, RGSS_GLYPH_OFFSET(base, color));
+        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, RGSS_GLYPH_OFFSET(base, index));
+        glBindTexture(GL_TEXTURE_2D, RGSS_Glyph_GetPage(batch->page, run->sdf));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, RGSS_MIN(batch->count, count - batch->start));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+    glBindVertexArray(GL_NONE);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+}
+
+void RGSS_GlyphRun_Free(RGSS_GlyphRun *run)
+{
+    vec_deinit(&run->quads);
+    vec_deinit(&run->batches);
+    run->sdf = false;
+    run->width = 0;
+    run->height = 0;
+}
+
+static void RGSS_Text_Layout(RGSS_Text *text)
+{
+    if (text->instances == GL_NONE)
+        rb_raise(rb_eRGSSError, "disposed text");
+
+    // Text objects showing the same string share the cached layout, and it is only read before the next lookup
+    RGSS_NewFont *font = DATA_PTR(text->font);
+    const char *str = NIL_P(text->text) ? "" : RSTRING_PTR(text->text);
+    long length = NIL_P(text->text) ? 0 : RSTRING_LEN(text->text);
+    PangoLayout *layout = RGSS_Font_GetLayout(font, str, length, text->wrap, -1, text->align, text->plain, NULL, NULL);
+
+    // Only the glyphs are rewritten, the atlas pages and buffers are reused
+    RGSS_GlyphRun_Build(layout, font->color, text->sdf, &text->run);
+    RGSS_GlyphRun_Upload(&text->run, text->instances, &text->capacity);
+    text->base.entity.size[0] = (float)text->run.width;
+    text->base.entity.size[1] = (float)text->run.height;
+}
+
+static void RGSS_Text_Free(void *data)
+{
+    if (data == NULL)
+        return;
+    RGSS_Text *text = data;
+    RGSS_GlyphRun_Free(&text->run);
+    RGSS_Entity_Deinit(&text->base.entity);
+    xfree(data);
+}
+
+static void RGSS_Text_Mark(void *data)
+{
+    RGSS_Text *text = data;
+    rb_gc_mark(text->base.parent);
+    rb_gc_mark(text->font);
+    rb_gc_mark(text->text);
+}
+
+static VALUE RGSS_Text_Alloc(VALUE klass)
+{
+    RGSS_Text *text = ALLOC(RGSS_Text);
+    memset(text, 0, sizeof(RGSS_Text));
+    RGSS_Entity_Init(&text->base.entity);
+    text->base.parent = Qnil;
+    text->font = Qnil;
+    text->text = Qnil;
+    text->wrap = -1;
+    text->reveal = -1.0f;
+    return Data_Wrap_Struct(klass, RGSS_Text_Mark, RGSS_Text_Free, text);
+}
+
+static void RGSS_Text_CheckFont(RGSS_Text *text, VALUE value)
+{
+    if (rb_obj_is_kind_of(value, rb_cFont) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not a Font", CLASS_NAME(value));
+
+    RGSS_NewFont *font = DATA_PTR(value);
+    if (font->desc == NULL)
+        rb_raise(rb_eRGSSError, "font has not been initialized");
+    text->font = value;
+}
+
+static VALUE RGSS_Text_SetFont(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    RGSS_Text_CheckFont(text, value);
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_Initialize(int argc, VALUE *argv, VALUE self)
+{
+    VALUE font, viewport, opts;
+    rb_scan_args(argc, argv, "11:", &font, &viewport, &opts);
+    rb_call_super(1, &viewport);
+
+    RGSS_Text *text = DATA_PTR(self);
+    RGSS_Text_CheckFont(text, font);
+
+    glGenVertexArrays(1, &text->base.vao);
+    glBindVertexArray(text->base.vao);
+    text->base.vbo = RGSS_CreateBuffer(GL_ARRAY_BUFFER, sizeof(RGSS_TEXT_CORNERS), RGSS_TEXT_CORNERS, GL_STATIC_DRAW);
+    glGenBuffers(1, &text->instances);
+    RGSS_GlyphRun_Setup(text->base.vbo);
+    glBindVertexArray(GL_NONE);
+
+    if (RTEST(opts))
+    {
+        RGSS_ParseOpt(opts, "plain", false, &text->plain);
+        RGSS_ParseOpt(opts, "sdf", false, &text->sdf);
+        RGSS_ParseOpt(opts, "align", PANGO_ALIGN_LEFT, &text->align);
+
+        VALUE opt = rb_hash_aref(opts, STR2SYM("width"));
+        if (!NIL_P(opt))
+            text->wrap = NUM2INT(opt);
+        opt = rb_hash_aref(opts, STR2SYM("text"));
+        if (!NIL_P(opt))
+            text->text = rb_str_new_frozen(StringValue(opt));
+    }
+    RGSS_Text_Layout(text);
+
+    if (rb_block_given_p())
+        rb_yield(self);
+    return self;
+}
+
+static VALUE RGSS_Text_Dispose(VALUE self)
+{
+    rb_call_super(0, NULL);
+    RGSS_Text *text = DATA_PTR(self);
+    if (text->instances)
+    {
+        glDeleteBuffers(1, &text->instances);
+        text->instances = GL_NONE;
+        text->capacity = 0;
+    }
+    RGSS_GlyphRun_Free(&text->run);
+    return Qnil;
+}
+
+static VALUE RGSS_Text_GetFont(VALUE self)
+{
+    return ((RGSS_Text *)DATA_PTR(self))->font;
+}
+
+static VALUE RGSS_Text_GetText(VALUE self)
+{
+    return ((RGSS_Text *)DATA_PTR(self))->text;
+}
+
+static VALUE RGSS_Text_SetText(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->text = NIL_P(value) ? Qnil : rb_str_new_frozen(StringValue(value));
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_GetAlign(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return INT2NUM(text->align);
+}
+
+static VALUE RGSS_Text_SetAlign(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->align = NUM2INT(value);
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_GetWrapWidth(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return text->wrap < 0 ? Qnil : INT2NUM(text->wrap);
+}
+
+static VALUE RGSS_Text_SetWrapWidth(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->wrap = NIL_P(value) ? -1 : NUM2INT(value);
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_IsPlain(VALUE self)
+{
+    return RB_BOOL(((RGSS_Text *)DATA_PTR(self))->plain);
+}
+
+static VALUE RGSS_Text_SetPlain(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->plain = RTEST(value);
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_IsSDF(VALUE self)
+{
+    return RB_BOOL(((RGSS_Text *)DATA_PTR(self))->sdf);
+}
+
+static VALUE RGSS_Text_SetSDF(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->sdf = RTEST(value);
+    RGSS_Text_Layout(text);
+    return value;
+}
+
+static VALUE RGSS_Text_GetOutlineColor(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return Data_Wrap_Struct(rb_cColor, NULL, RUBY_NEVER_FREE, &text->outline);
+}
+
+static VALUE RGSS_Text_SetOutlineColor(VALUE self, VALUE color)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    if (rb_obj_is_kind_of(color, rb_cColor))
+        glm_vec4_copy(DATA_PTR(color), text->outline);
+    else
+        glm_vec4_zero(text->outline);
+    return color;
+}
+
+static VALUE RGSS_Text_GetOutlineWidth(VALUE self)
+{
+    return DBL2NUM(((RGSS_Text *)DATA_PTR(self))->outline_width);
+}
+
+static VALUE RGSS_Text_SetOutlineWidth(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->outline_width = RGSS_MAX(NUM2FLT(value), 0.0f);
+    return value;
+}
+
+static VALUE RGSS_Text_GetShadowColor(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return Data_Wrap_Struct(rb_cColor, NULL, RUBY_NEVER_FREE, &text->shadow);
+}
+
+static VALUE RGSS_Text_SetShadowColor(VALUE self, VALUE color)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    if (rb_obj_is_kind_of(color, rb_cColor))
+        glm_vec4_copy(DATA_PTR(color), text->shadow);
+    else
+        glm_vec4_zero(text->shadow);
+    return color;
+}
+
+static VALUE RGSS_Text_GetShadowOffset(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return Data_Wrap_Struct(rb_cVec2, NULL, RUBY_NEVER_FREE, text->shadow_offset);
+}
+
+static VALUE RGSS_Text_SetShadowOffset(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    if (NIL_P(value))
+        glm_vec2_zero(text->shadow_offset);
+    else
+        glm_vec2_copy(DATA_PTR(value), text->shadow_offset);
+    return value;
+}
+
+static inline float RGSS_Text_GetRevealEnd(RGSS_Text *text)
+{
+    // Everything is shown once the last glyph has completely faded in
+    return text->run.quads.length + text->reveal_fade;
+}
+
+static inline float RGSS_Text_GetRevealed(RGSS_Text *text)
+{
+    float end = RGSS_Text_GetRevealEnd(text);
+    return text->reveal < 0.0f ? end : RGSS_MIN(text->reveal, end);
+}
+
+static VALUE RGSS_Text_GetReveal(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return text->reveal < 0.0f ? Qnil : DBL2NUM(text->reveal);
+}
+
+static VALUE RGSS_Text_SetReveal(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->reveal = NIL_P(value) ? -1.0f : RGSS_MAX(NUM2FLT(value), 0.0f);
+    return value;
+}
+
+static VALUE RGSS_Text_GetRevealFade(VALUE self)
+{
+    return DBL2NUM(((RGSS_Text *)DATA_PTR(self))->reveal_fade);
+}
+
+static VALUE RGSS_Text_SetRevealFade(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->reveal_fade = RGSS_MAX(NUM2FLT(value), 0.0f);
+    return value;
+}
+
+static VALUE RGSS_Text_GetRevealSpeed(VALUE self)
+{
+    return DBL2NUM(((RGSS_Text *)DATA_PTR(self))->reveal_speed);
+}
+
+static VALUE RGSS_Text_SetRevealSpeed(VALUE self, VALUE value)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    text->reveal_speed = RGSS_MAX(NUM2FLT(value), 0.0f);
+    return value;
+}
+
+static VALUE RGSS_Text_IsRevealed(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return RB_BOOL(text->reveal < 0.0f || text->reveal >= RGSS_Text_GetRevealEnd(text));
+}
+
+static VALUE RGSS_Text_Update(VALUE self, VALUE delta)
+{
+    rb_call_super(1, &delta);
+    RGSS_Text *text = DATA_PTR(self);
+    float end = RGSS_Text_GetRevealEnd(text);
+    if (text->reveal >= 0.0f && text->reveal < end)
+        text->reveal = RGSS_MIN(text->reveal + text->reveal_speed, end);
+    return Qnil;
+}
+
+static VALUE RGSS_Text_Refresh(VALUE self)
+{
+    RGSS_Text_Layout(DATA_PTR(self));
+    return self;
+}
+
+static VALUE RGSS_Text_GetGlyphCount(VALUE self)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    return INT2NUM(text->run.quads.length);
+}
+
+static VALUE RGSS_Text_Render(VALUE self, VALUE alpha)
+{
+    RGSS_Text *text = DATA_PTR(self);
+    if (text->run.quads.length == 0 || !text->base.visible || text->base.opacity < FLT_EPSILON)
+        return Qnil;
+    if (text->reveal >= 0.0f && text->reveal < FLT_EPSILON)
+        return Qnil;
+
+    glBlendEquation(text->base.blend.op);
+    glBlendFunc(text->base.blend.src, text->base.blend.dst);
+
+    // The entity model scales a unit quad by the size, but glyphs are already positioned in pixels
+    RGSS_Entity *entity = &text->base.entity;
+    mat4 model;
+    vec3 pivot;
+    glm_vec3_add(entity->pivot, entity->position, pivot);
+    glm_rotate_atm(model, pivot, entity->angle, RGSS_AXIS_Z);
+    glm_translate(model, entity->position);
+    glm_scale(model, entity->scale);
+
+    if (text->run.sdf)
+    {
+        // Outlines and shadows are derived from the distance field, without drawing the glyphs again
+        RGSS_Graphics_UseProgram(RGSS_GRAPHICS.sdf_shader.id);
+        glUniformMatrix4fv(RGSS_GRAPHICS.sdf_shader.model, 1, GL_FALSE, model[0]);
+        glUniform4fv(RGSS_GRAPHICS.sdf_shader.color, 1, text->base.color);
+        glUniform4fv(RGSS_GRAPHICS.sdf_shader.tone, 1, text->base.tone);
+        glUniform4fv(RGSS_GRAPHICS.sdf_shader.flash, 1, text->base.flash_color);
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.hue, text->base.hue);
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.opacity, text->base.opacity);
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.spread, (GLfloat)RGSS_SDF_SPREAD / RGSS_GLYPH_PAGE_SIZE);
+        glUniform4fv(RGSS_GRAPHICS.sdf_shader.outline_color, 1, text->outline);
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.outline_width, text->outline_width);
+        glUniform4fv(RGSS_GRAPHICS.sdf_shader.shadow_color, 1, text->shadow);
+        glUniform2fv(RGSS_GRAPHICS.sdf_shader.shadow_offset, 1, text->shadow_offset);
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.reveal, RGSS_Text_GetRevealed(text));
+        glUniform1f(RGSS_GRAPHICS.sdf_shader.reveal_fade, text->reveal_fade);
+    }
+    else
+    {
+        RGSS_Graphics_UseProgram(RGSS_GRAPHICS.text_shader.id);
+        glUniformMatrix4fv(RGSS_GRAPHICS.text_shader.model, 1, GL_FALSE, model[0]);
+        glUniform4fv(RGSS_GRAPHICS.text_shader.color, 1, text->base.color);
+        glUniform4fv(RGSS_GRAPHICS.text_shader.tone, 1, text->base.tone);
+        glUniform4fv(RGSS_GRAPHICS.text_shader.flash, 1, text->base.flash_color);
+        glUniform1f(RGSS_GRAPHICS.text_shader.hue, text->base.hue);
+        glUniform1f(RGSS_GRAPHICS.text_shader.opacity, text->base.opacity);
+        glUniform1f(RGSS_GRAPHICS.text_shader.reveal, RGSS_Text_GetRevealed(text));
+        glUniform1f(RGSS_GRAPHICS.text_shader.reveal_fade, text->reveal_fade);
+    }
+
+    // Glyphs past the revealed count are never drawn, the shader fades in the ones being revealed
+    int count = text->run.quads.length;
+    if (text->reveal >= 0.0f)
+        count = RGSS_MIN(count, (int)ceilf(text->reveal));
+    RGSS_GlyphRun_Draw(&text->run, text->base.vao, text->instances, count);
+    return Qnil;
+}
+
+void RGSS_Init_Text(VALUE parent)
+{
+    rb_cText = rb_define_class_under(parent, "Text", rb_cRenderable);
+    rb_define_alloc_func(rb_cText, RGSS_Text_Alloc);
+
+    rb_define_methodm1(rb_cText, "initialize", RGSS_Text_Initialize, -1);
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, Font, "font");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, Text, "text");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, Align, "align");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, WrapWidth, "wrap_width");
+    rb_define_method0(rb_cText, "plain?", RGSS_Text_IsPlain, 0);
+    rb_define_method1(rb_cText, "plain=", RGSS_Text_SetPlain, 1);
+    rb_define_method0(rb_cText, "sdf?", RGSS_Text_IsSDF, 0);
+    rb_define_method1(rb_cText, "sdf=", RGSS_Text_SetSDF, 1);
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, OutlineColor, "outline_color");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, OutlineWidth, "outline_width");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, ShadowColor, "shadow_color");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, ShadowOffset, "shadow_offset");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, Reveal, "reveal");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, RevealFade, "reveal_fade");
+    DEFINE_ACCESSOR(rb_cText, RGSS_Text, RevealSpeed, "reveal_speed");
+    rb_define_method0(rb_cText, "revealed?", RGSS_Text_IsRevealed, 0);
+    rb_define_method1(rb_cText, "update", RGSS_Text_Update, 1);
+    rb_define_method0(rb_cText, "refresh", RGSS_Text_Refresh, 0);
+    rb_define_method0(rb_cText, "glyph_count", RGSS_Text_GetGlyphCount, 0);
+    rb_define_method0(rb_cText, "dispose", RGSS_Text_Dispose, 0);
+    rb_define_method1(rb_cText, "render", RGSS_Text_Render, 1);
+}
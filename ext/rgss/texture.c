@@ -1,27 +1,101 @@
-#include "game.h"
+#include "font.h"
 #include "graphics.h"
+#include "pixels.h"
 
 VALUE rb_cTexture;
 
-vec4 RGSS_VEC4_ZERO;
-mat4 RGSS_BLIT_MODEL;
-
 
 #define RGSS_TEXTURE_OPTS "@default_options"
+#define RGSS_MIPMAP_FILTER GL_LINEAR_MIPMAP_LINEAR
+#define RGSS_TEXT_SCRATCH_STEP 64 /** The granularity the text scratch surface is sized in, in pixels. */
 #define RGSS_ASSERT_TEXTURE(texture)                                                                                   \
     if ((texture)->id == 0)                                                                                            \
     rb_raise(rb_eRuntimeError, "disposed texture")
 
+static vec_void_t RGSS_PENDING_TEXTURES;
+
+static void RGSS_Texture_ClearCommands(RGSS_Texture *texture)
+{
+    RGSS_BlitCommand *cmd;
+    int i;
+    vec_foreach_ptr(&texture->commands, cmd, i)
+    {
+        if (cmd->source)
+            cmd->source->pending_reads--;
+    }
+    vec_clear(&texture->commands);
+    vec_remove(&RGSS_PENDING_TEXTURES, texture);
+}
+
+static void RGSS_Texture_Discard(RGSS_Texture *texture)
+{
+    // Nothing can observe the pending commands of a texture that is going away, but pending commands of other
+    // textures may still read from it, and must be executed (or dropped without a context) while it exists
+    if (texture->pending_reads > 0)
+    {
+        if (RGSS_GAME.window)
+            RGSS_Texture_FlushAll();
+        else
+        {
+            while (RGSS_PENDING_TEXTURES.length > 0)
+                RGSS_Texture_ClearCommands(vec_last(&RGSS_PENDING_TEXTURES));
+        }
+    }
+    RGSS_Texture_ClearCommands(texture);
+}
+
+void RGSS_Texture_Mark(void *data)
+{
+    RGSS_Texture *tex = data;
+    RGSS_BlitCommand *cmd;
+    int i;
+    vec_foreach_ptr(&tex->commands, cmd, i)
+    {
+        if (cmd->source)
+            rb_gc_mark(cmd->object);
+    }
+}
+
+void RGSS_Texture_Free(void *data)
+{
+    RGSS_Texture *tex = data;
+
+    // Sources are marked by pending commands, so a texture still read by one is only collected along with the
+    // textures reading it, which may be freed after it. Their commands are detached so they never touch it again.
+    if (tex->pending_reads > 0)
+    {
+        RGSS_BlitCommand *cmd;
+        int j;
+        for (int i = 0; i < RGSS_PENDING_TEXTURES.length; i++)
+        {
+            RGSS_Texture *texture = RGSS_PENDING_TEXTURES.data[i];
+            vec_foreach_ptr(&texture->commands, cmd, j)
+            {
+                if (cmd->source == tex)
+                {
+                    cmd->source = NULL;
+                    cmd->object = Qnil;
+                }
+            }
+        }
+        tex->pending_reads = 0;
+    }
+    RGSS_Texture_ClearCommands(tex);
+    vec_deinit(&tex->commands);
+    xfree(tex);
+}
+
 static VALUE RGSS_Texture_Alloc(VALUE klass)
 {
     RGSS_Texture *tex = ALLOC(RGSS_Texture);
     memset(tex, 0, sizeof(RGSS_Texture));
-    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, tex);
+    return Data_Wrap_Struct(klass, RGSS_Texture_Mark, RGSS_Texture_Free, tex);
 }
 
 static VALUE RGSS_Texture_Dispose(VALUE self)
 {
     RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_Texture_Discard(tex);
     if (tex->fbo)
     {
         glDeleteFramebuffers(1, &tex->fbo);
@@ -55,6 +129,206 @@ static inline void RGSS_Texture_BindFramebuffer(RGSS_Texture *texture)
     }
 }
 
+typedef struct
+{
+    RGSS_SamplerState state;
+    GLuint id;
+    UT_hash_handle hh;
+} RGSS_SamplerEntry;
+
+static RGSS_SamplerEntry *RGSS_SAMPLERS;
+
+GLuint RGSS_Sampler_Get(const RGSS_SamplerState *state)
+{
+    RGSS_SamplerEntry *entry;
+    HASH_FIND(hh, RGSS_SAMPLERS, state, sizeof(RGSS_SamplerState), entry);
+    if (entry)
+        return entry->id;
+
+    entry = ALLOC(RGSS_SamplerEntry);
+    memset(entry, 0, sizeof(RGSS_SamplerEntry));
+    memcpy(&entry->state, state, sizeof(RGSS_SamplerState));
+
+    glGenSamplers(1, &entry->id);
+    glSamplerParameteri(entry->id, GL_TEXTURE_MIN_FILTER, state->min_filter);
+    glSamplerParameteri(entry->id, GL_TEXTURE_MAG_FILTER, state->mag_filter);
+    glSamplerParameteri(entry->id, GL_TEXTURE_WRAP_S, state->wrap_s);
+    glSamplerParameteri(entry->id, GL_TEXTURE_WRAP_T, state->wrap_t);
+
+    if (GLAD_GL_EXT_texture_filter_anisotropic && state->anisotropy > 1.0f)
+    {
+        GLfloat max;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &max);
+        glSamplerParameterf(entry->id, GL_TEXTURE_MAX_ANISOTROPY_EXT, glm_min(state->anisotropy, max));
+    }
+
+    HASH_ADD(hh, RGSS_SAMPLERS, state, sizeof(RGSS_SamplerState), entry);
+    RGSS_LogDebug("Created sampler object %u (%u cached)", entry->id, HASH_COUNT(RGSS_SAMPLERS));
+    return entry->id;
+}
+
+void RGSS_Sampler_Deinit(void)
+{
+    RGSS_SamplerEntry *entry, *temp;
+    HASH_ITER(hh, RGSS_SAMPLERS, entry, temp)
+    {
+        HASH_DEL(RGSS_SAMPLERS, entry);
+        glDeleteSamplers(1, &entry->id);
+        xfree(entry);
+    }
+}
+
+static void RGSS_Texture_BindUnflushed(RGSS_Texture *texture, GLuint unit, const RGSS_SamplerState *state, int minified)
+{
+    RGSS_SamplerState sampler = state ? *state : texture->sampler;
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+
+    if (minified && texture->mipmaps)
+    {
+        if (texture->mipmaps_dirty)
+        {
+            glGenerateMipmap(GL_TEXTURE_2D);
+            texture->mipmaps_dirty = false;
+        }
+        sampler.min_filter = RGSS_MIPMAP_FILTER;
+    }
+
+    glBindSampler(unit, RGSS_Sampler_Get(&sampler));
+}
+
+void RGSS_Texture_BindSampled(RGSS_Texture *texture, GLuint unit, const RGSS_SamplerState *state, int minified)
+{
+    RGSS_Texture_Flush(texture);
+    RGSS_Texture_BindUnflushed(texture, unit, state, minified);
+}
+
+static inline void RGSS_Texture_Invalidate(RGSS_Texture *texture)
+{
+    if (texture->mipmaps)
+        texture->mipmaps_dirty = true;
+}
+
+static void RGSS_Texture_Record(RGSS_Texture *texture, RGSS_Texture *source, const RGSS_BlitCommand *command)
+{
+    // Commands of other textures still read the current contents, so they must be executed before any change
+    if (texture->pending_reads > 0)
+        RGSS_Texture_FlushAll();
+
+    if (texture->commands.length == 0)
+        vec_push(&RGSS_PENDING_TEXTURES, texture);
+    if (source)
+        source->pending_reads++;
+
+    vec_push(&texture->commands, *command);
+    RGSS_Texture_Invalidate(texture);
+}
+
+void RGSS_Texture_Flush(RGSS_Texture *texture)
+{
+    if (texture->sync)
+        texture->sync(texture);
+    if (texture->commands.length == 0)
+        return;
+
+    // Bring sources up to date first, as flushing them shares the instance buffer and framebuffer binding
+    RGSS_BlitCommand *cmd;
+    int i;
+    vec_foreach_ptr(&texture->commands, cmd, i)
+    {
+        if (cmd->source && cmd->source != texture)
+            RGSS_Texture_Flush(cmd->source);
+    }
+
+    // A flush may be triggered in the middle of rendering, so the state it changes is restored afterwards
+    GLint fbo, viewport[4], scissor[4], equation, src_factor, dst_factor;
+    GLuint program = RGSS_GRAPHICS.program;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &fbo);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_SCISSOR_BOX, scissor);
+    glGetIntegerv(GL_BLEND_EQUATION_RGB, &equation);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &src_factor);
+    glGetIntegerv(GL_BLEND_DST_RGB, &dst_factor);
+
+    RGSS_Texture_BindFramebuffer(texture);
+    glViewport(0, 0, texture->width, texture->height);
+    glScissor(0, 0, texture->width, texture->height);
+
+    GLsizeiptr size = texture->commands.length * sizeof(RGSS_BlitCommand);
+    glBindBuffer(GL_ARRAY_BUFFER, RGSS_BLIT_INSTANCES);
+    glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, texture->commands.data);
+
+    RGSS_Graphics_UseProgram(RGSS_GRAPHICS.blit_shader.id);
+    glUniform2f(RGSS_GRAPHICS.blit_shader.target_size, (GLfloat)texture->width, (GLfloat)texture->height);
+    glBindVertexArray(RGSS_BLIT_VAO);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Consecutive commands with the same source are drawn as a single instanced draw
+    int start = 0, count = texture->commands.length;
+    while (start < count)
+    {
+        RGSS_BlitCommand *first = &texture->commands.data[start];
+        int minified = false, end = start;
+        for (; end < count && texture->commands.data[end].source == first->source; end++)
+        {
+            cmd = &texture->commands.data[end];
+            if (cmd->source && (cmd->src[2] - cmd->src[0]) * cmd->source->width > cmd->dst[2])
+                minified = true;
+        }
+
+        if (first->source)
+        {
+            RGSS_Texture_BindUnflushed(first->source, 0, NULL, minified);
+            glUniform1i(RGSS_GRAPHICS.blit_shader.textured, GL_TRUE);
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            glUniform1i(RGSS_GRAPHICS.blit_shader.textured, GL_FALSE);
+            glDisable(GL_BLEND);
+        }
+
+        const GLsizei stride = sizeof(RGSS_BlitCommand);
+        const char *base = (const char *)(start * sizeof(RGSS_BlitCommand));
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(RGSS_BlitCommand, dst));
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(RGSS_BlitCommand, src));
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(RGSS_BlitCommand, color));
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL, end - start);
+        start = end;
+    }
+
+    glEnable(GL_BLEND);
+    glBindSampler(0, GL_NONE);
+    glBindVertexArray(GL_NONE);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+
+    RGSS_Texture_ClearCommands(texture);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+    RGSS_Graphics_UseProgram(program);
+    glBlendEquation(equation);
+    glBlendFunc(src_factor, dst_factor);
+}
+
+void RGSS_Texture_FlushAll(void)
+{
+    while (RGSS_PENDING_TEXTURES.length > 0)
+        RGSS_Texture_Flush(vec_last(&RGSS_PENDING_TEXTURES));
+}
+
+static VALUE RGSS_Texture_FlushRB(VALUE self)
+{
+    RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_ASSERT_TEXTURE(tex);
+    RGSS_Texture_Flush(tex);
+    return self;
+}
+
 static VALUE RGSS_Texture_GetDefaultOptions(VALUE klass)
 {
     VALUE opts = rb_iv_get(klass, RGSS_TEXTURE_OPTS);
@@ -68,6 +342,8 @@ static VALUE RGSS_Texture_GetDefaultOptions(VALUE klass)
         rb_hash_aset(opts, STR2SYM("wrap_t"), INT2NUM(GL_CLAMP_TO_EDGE));
         rb_hash_aset(opts, STR2SYM("min_filter"), INT2NUM(GL_NEAREST));
         rb_hash_aset(opts, STR2SYM("max_filter"), INT2NUM(GL_LINEAR));
+        rb_hash_aset(opts, STR2SYM("mipmaps"), Qfalse);
+        rb_hash_aset(opts, STR2SYM("anisotropy"), DBL2NUM(1.0));
         rb_iv_set(klass, RGSS_TEXTURE_OPTS, opts);
     }
     return opts;
@@ -77,6 +353,7 @@ static VALUE RGSS_Texture_GetID(VALUE self)
 {
     RGSS_Texture *tex = DATA_PTR(self);
     RGSS_ASSERT_TEXTURE(tex);
+    RGSS_Texture_Flush(tex);
     return INT2NUM(tex->id);
 }
 
@@ -115,7 +392,7 @@ static VALUE RGSS_Texture_GetRect(VALUE self)
     return RGSS_Rect_New(0, 0, tex->width, tex->height);
 }
 
-static void RGSS_Texture_Generate(int width, int height, void *data, VALUE opts, RGSS_Texture *texture)
+void RGSS_Texture_Generate(int width, int height, void *data, VALUE opts, RGSS_Texture *texture)
 {
     texture->width = width;
     texture->height = height;
@@ -129,6 +406,12 @@ static void RGSS_Texture_Generate(int width, int height, void *data, VALUE opts,
     RGSS_ParseOpt(opts, "wrap_t", GL_CLAMP_TO_EDGE, &wrap_t);
     RGSS_ParseOpt(opts, "min_filter", GL_NEAREST, &min_filter);
     RGSS_ParseOpt(opts, "max_filter", GL_LINEAR, &max_filter);
+    RGSS_ParseOpt(opts, "mipmaps", false, &texture->mipmaps);
+
+    VALUE anisotropy = NIL_P(opts) ? Qnil : rb_hash_aref(opts, STR2SYM("anisotropy"));
+    texture->sampler = (RGSS_SamplerState){min_filter, max_filter, wrap_s, wrap_t, 1.0f};
+    if (!NIL_P(anisotropy))
+        texture->sampler.anisotropy = glm_max(NUM2FLT(anisotropy), 1.0f);
 
     glGenTextures(1, &texture->id);
     glActiveTexture(GL_TEXTURE0);
@@ -139,6 +422,11 @@ static void RGSS_Texture_Generate(int width, int height, void *data, VALUE opts,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, max_filter);
+
+    // The mipmap chain is built now, and then rebuilt lazily when drawn scaled down after the texture is modified
+    if (texture->mipmaps)
+        glGenerateMipmap(GL_TEXTURE_2D);
+    texture->mipmaps_dirty = false;
 }
 
 static VALUE RGSS_Texture_Bind(int argc, VALUE *argv, VALUE self)
@@ -151,14 +439,14 @@ static VALUE RGSS_Texture_Bind(int argc, VALUE *argv, VALUE self)
     RGSS_Texture *tex = DATA_PTR(self);
     RGSS_ASSERT_TEXTURE(tex);
 
-    glActiveTexture(unit);
-    glBindTexture(GL_TEXTURE_2D, tex->id);
+    RGSS_Texture_BindSampled(tex, unit - GL_TEXTURE0, NULL, false);
 
     if (rb_block_given_p())
     {
         rb_yield(Qundef);
         glActiveTexture(unit);
         glBindTexture(GL_TEXTURE_2D, GL_NONE);
+        glBindSampler(unit - GL_TEXTURE0, GL_NONE);
     }
     return self;
 }
@@ -168,12 +456,37 @@ static VALUE RGSS_Texture_Unbind(VALUE klass, VALUE index)
     GLenum unit = GL_TEXTURE0 + NUM2INT(index);
     glActiveTexture(unit);
     glBindTexture(GL_TEXTURE_2D, GL_NONE);
+    glBindSampler(unit - GL_TEXTURE0, GL_NONE);
     return Qnil;
 }
 
+static VALUE RGSS_Texture_GenerateMipmaps(VALUE self)
+{
+    RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_ASSERT_TEXTURE(tex);
+    RGSS_Texture_Flush(tex);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tex->id);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+    tex->mipmaps = true;
+    tex->mipmaps_dirty = false;
+    return self;
+}
+
+static VALUE RGSS_Texture_IsMipmapped(VALUE self)
+{
+    RGSS_Texture *tex = DATA_PTR(self);
+    return RB_BOOL(tex->mipmaps);
+}
+
 static VALUE RGSS_Texture_FromID(VALUE klass, VALUE id, VALUE width, VALUE height)
 {
     RGSS_Texture *tex = ALLOC(RGSS_Texture);
+    memset(tex, 0, sizeof(RGSS_Texture));
+    tex->sampler = (RGSS_SamplerState){GL_NEAREST, GL_LINEAR, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE, 1.0f};
     tex->id = NUM2UINT(id);
     tex->width = NUM2INT(width);
     tex->height = NUM2INT(height);
@@ -182,7 +495,7 @@ static VALUE RGSS_Texture_FromID(VALUE klass, VALUE id, VALUE width, VALUE heigh
         rb_raise(rb_eArgError, "invalid texture ID");
     RGSS_SizeNotEmpty(tex->width, tex->height);
 
-    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, tex);
+    return Data_Wrap_Struct(klass, RGSS_Texture_Mark, RGSS_Texture_Free, tex);
 }
 
 static VALUE RGSS_Texture_Load(int argc, VALUE *argv, VALUE klass)
@@ -197,11 +510,12 @@ static VALUE RGSS_Texture_Load(int argc, VALUE *argv, VALUE klass)
     unsigned char *pixels;
 
     RGSS_Texture *tex = ALLOC(RGSS_Texture);
+    memset(tex, 0, sizeof(RGSS_Texture));
     RGSS_Image_Load(StringValueCStr(path), &width, &height, &pixels);
     RGSS_Texture_Generate(width, height, pixels, opts, tex);
     xfree(pixels);
 
-    return Data_Wrap_Struct(klass, NULL, RUBY_DEFAULT_FREE, tex);
+    return Data_Wrap_Struct(klass, RGSS_Texture_Mark, RGSS_Texture_Free, tex);
 }
 
 static VALUE RGSS_Texture_Initialize(int argc, VALUE *argv, VALUE self)
@@ -249,6 +563,7 @@ static VALUE RGSS_Texture_ToImage(VALUE self)
     RGSS_Texture *tex = DATA_PTR(self);
     RGSS_ASSERT_TEXTURE(tex);
 
+    RGSS_Texture_Flush(tex);
     unsigned char *pixels = xmalloc(tex->width * tex->height * sizeof(unsigned int));
     RGSS_Texture_BindFramebuffer(tex);
     glReadPixels(0, 0, tex->width, tex->height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
@@ -257,78 +572,110 @@ static VALUE RGSS_Texture_ToImage(VALUE self)
     return RGSS_Image_New(tex->width, tex->height, pixels);
 }
 
-#define RGSS_SHADER RGSS_GAME.graphics.shader
-
-static void RGSS_Texture_BlitImpl(RGSS_Texture *dst, RGSS_Texture *src, RGSS_Rect *src_rect, RGSS_Rect *dst_rect, float opacity)
+static void RGSS_Texture_BlitImpl(RGSS_Texture *dst, VALUE source, RGSS_Rect *src_rect, RGSS_Rect *dst_rect, float opacity)
 {
+    RGSS_Texture *src = DATA_PTR(source);
     if (dst_rect->width < 1 || dst_rect->height < 1)
         return;
     RGSS_SizeNotEmpty(src_rect->width, src_rect->height);
 
-    // Setup geometry of rendering area
-    int x = dst_rect->x;
-    int y = dst_rect->y;
-    int w = dst_rect->width;
-    int h = dst_rect->height;
+    RGSS_BlitCommand cmd;
+    cmd.source = src;
+    cmd.object = source;
+    cmd.dst[0] = (GLfloat) dst_rect->x;
+    cmd.dst[1] = (GLfloat) dst_rect->y;
+    cmd.dst[2] = (GLfloat) dst_rect->width;
+    cmd.dst[3] = (GLfloat) dst_rect->height;
+    cmd.src[0] = (GLfloat) src_rect->x / src->width;
+    cmd.src[1] = (GLfloat) src_rect->y / src->height;
+    cmd.src[2] = (GLfloat) (src_rect->x + src_rect->width) / src->width;
+    cmd.src[3] = (GLfloat) (src_rect->y + src_rect->height) / src->height;
+    glm_vec4_copy((vec4){1.0f, 1.0f, 1.0f, opacity}, cmd.color);
+
+    RGSS_Texture_Record(dst, src, &cmd);
+}
 
-    mat4 mat;
-    glm_ortho(x, x + w, y, y + h, -1.0f, 1.0f, mat);
-    glBindBuffer(GL_UNIFORM_BUFFER, RGSS_GAME.graphics.ubo);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, RGSS_MAT4_SIZE, mat);
-    glViewport(x, y, w, h);
-    glScissor(x, y, w, h);
+static void RGSS_Texture_CopyImpl(RGSS_Texture *dst, RGSS_Texture *src, RGSS_Rect *src_rect, int x, int y)
+{
+    // Clip the copied area to the bounds of both textures
+    int sx = RGSS_MAX(src_rect->x, RGSS_MAX(0, src_rect->x - x));
+    int sy = RGSS_MAX(src_rect->y, RGSS_MAX(0, src_rect->y - y));
+    x += sx - src_rect->x;
+    y += sy - src_rect->y;
+    int w = RGSS_MIN(src_rect->width - (sx - src_rect->x), RGSS_MIN(src->width - sx, dst->width - x));
+    int h = RGSS_MIN(src_rect->height - (sy - src_rect->y), RGSS_MIN(src->height - sy, dst->height - y));
+    if (w < 1 || h < 1)
+        return;
 
-    GLfloat l, t, r, b;
-    l = (GLfloat) src_rect->x / src->width;
-    t = (GLfloat) src_rect->y / src->height;
-    r = (GLfloat) src_rect->width /  src->width;
-    b = (GLfloat) src_rect->height / src->height;
-    
-    GLfloat vertices[] =
-    {
-        0.0f, 1.0f, l, b, // Bottom-Left
-        1.0f, 0.0f, r, t, // Top-Right
-        0.0f, 0.0f, l, t, // Top-Left
-        1.0f, 1.0f, r, b, // Bottom-Right
-    };
-    glBindBuffer(GL_ARRAY_BUFFER, RGSS_BLIT_VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-
-    // Bind the framebuffer of the texture to render to, then bind source texture to render
-    RGSS_Texture_BindFramebuffer(dst);
-    vec3 scale = { src_rect->width, src_rect->height, 0 };
-    glm_scale_make(RGSS_BLIT_MODEL, scale);
+    // A copy is executed immediately, so everything recorded before it must be too
+    if (dst->pending_reads > 0)
+        RGSS_Texture_FlushAll();
+    RGSS_Texture_Flush(src);
+    RGSS_Texture_Flush(dst);
 
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (GLAD_GL_ARB_copy_image && src != dst)
+    {
+        glCopyImageSubData(src->id, GL_TEXTURE_2D, 0, sx, sy, 0, dst->id, GL_TEXTURE_2D, 0, x, y, 0, w, h, 1);
+    }
+    else
+    {
+        RGSS_Texture_BindFramebuffer(src);
+        RGSS_Texture_BindFramebuffer(dst);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, src->fbo);
+        glScissor(x, y, w, h);
+        glBlitFramebuffer(sx, sy, sx + w, sy + h, x, y, x + w, y + h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        RGSS_Graphics_Restore(rb_mGraphics);
+    }
+    RGSS_Texture_Invalidate(dst);
+}
 
-    glUseProgram(RGSS_SHADER.id);
-    glUniformMatrix4fv(RGSS_SHADER.model, 1, GL_FALSE, RGSS_BLIT_MODEL);
-    glUniform4fv(RGSS_SHADER.color, 1, RGSS_VEC4_ZERO);
-    glUniform4fv(RGSS_SHADER.tone,  1, RGSS_VEC4_ZERO);
-    glUniform4fv(RGSS_SHADER.flash, 1, RGSS_VEC4_ZERO);
-    glUniform1f(RGSS_SHADER.hue, 0.0f);
-    glUniform1f(RGSS_SHADER.opacity, opacity); // TODO
+static struct
+{
+    cairo_surface_t *surface; /** Reused surface text is drawn to before uploading, grown to fit the largest area. */
+    cairo_t *context;         /** The drawing context of the surface. */
+} RGSS_TEXT_SCRATCH;
 
-    // Render 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, src->id);
-    glBindVertexArray(RGSS_BLIT_VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL);
+static cairo_t *RGSS_Texture_GetScratch(int width, int height)
+{
+    cairo_surface_t *surface = RGSS_TEXT_SCRATCH.surface;
+    int w = surface ? cairo_image_surface_get_width(surface) : 0;
+    int h = surface ? cairo_image_surface_get_height(surface) : 0;
+    if (w >= width && h >= height)
+        return RGSS_TEXT_SCRATCH.context;
+
+    // Rounded up and never shrunk, so drawing labels of similar sizes settles on a single surface
+    w = RGSS_MAX(w, width);
+    h = RGSS_MAX(h, height);
+    w = (w + RGSS_TEXT_SCRATCH_STEP - 1) / RGSS_TEXT_SCRATCH_STEP * RGSS_TEXT_SCRATCH_STEP;
+    h = (h + RGSS_TEXT_SCRATCH_STEP - 1) / RGSS_TEXT_SCRATCH_STEP * RGSS_TEXT_SCRATCH_STEP;
+    if (surface)
+    {
+        cairo_destroy(RGSS_TEXT_SCRATCH.context);
+        cairo_surface_destroy(surface);
+    }
 
-    // Restore rendering to screen 
-    RGSS_Graphics_Restore(rb_mGraphics);
+    RGSS_TEXT_SCRATCH.surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h);
+    RGSS_TEXT_SCRATCH.context = cairo_create(RGSS_TEXT_SCRATCH.surface);
+    if (cairo_status(RGSS_TEXT_SCRATCH.context) != CAIRO_STATUS_SUCCESS)
+    {
+        cairo_destroy(RGSS_TEXT_SCRATCH.context);
+        cairo_surface_destroy(RGSS_TEXT_SCRATCH.surface);
+        memset(&RGSS_TEXT_SCRATCH, 0, sizeof(RGSS_TEXT_SCRATCH));
+        rb_raise(rb_eRGSSError, "failed to create %dx%d surface for text", w, h);
+    }
+    return RGSS_TEXT_SCRATCH.context;
 }
 
-static VALUE RGSS_Dexture_DrawText(int argc, VALUE *argv, VALUE self)
+int RGSS_Texture_RenderText(int argc, VALUE *argv, int target_width, int target_height, RGSS_Rect *area,
+                            uint32_t **pixels, int *row_length)
 {
     VALUE a0, a1, a2, a3, a4, opts;
-    rb_scan_args(argc, argv, "23:", &a0, &a1, &a2, &a3, &a4, &opts);
+    int count = rb_scan_args(argc, argv, "23:", &a0, &a1, &a2, &a3, &a4, &opts);
 
-    RGSS_Rect dst_rect, src_rect;
+    RGSS_Rect dst_rect;
     VALUE text;
 
-    switch (argc)
+    switch (count)
     {
         case 2:
         {
@@ -342,11 +689,11 @@ static VALUE RGSS_Dexture_DrawText(int argc, VALUE *argv, VALUE self)
         {
             if (rb_obj_is_kind_of(a0, rb_cIVec2) != Qtrue)
                 rb_raise(rb_eArgError, "%s is not a Point", CLASS_NAME(a0));
-            if (rb_obj_is_kind_of(a0, rb_cIVec2) != Qtrue)
+            if (rb_obj_is_kind_of(a1, rb_cIVec2) != Qtrue)
                 rb_raise(rb_eArgError, "%s is not a Size", CLASS_NAME(a1));
             memcpy(&dst_rect.location, DATA_PTR(a0), sizeof(RGSS_Point));
             memcpy(&dst_rect.size, DATA_PTR(a1), sizeof(RGSS_Size));
-            text = a3;
+            text = a2;
             break;
         }
         case 5:
@@ -356,22 +703,106 @@ static VALUE RGSS_Dexture_DrawText(int argc, VALUE *argv, VALUE self)
             dst_rect.width = NUM2INT(a2);
             dst_rect.height = NUM2INT(a3);
             text = a4;
-            break; 
+            break;
         }
-        default: rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 2, 3, or 5)", argc);
+        default: rb_raise(rb_eArgError, "wrong number of arguments (given %d, expected 2, 3, or 5)", count);
     }
 
     RGSS_SizeNotEmpty(dst_rect.width, dst_rect.height);
-    // src_rect = (RGSS_Rect) 
+    VALUE value = NIL_P(opts) ? Qnil : rb_hash_aref(opts, STR2SYM("font"));
+    if (rb_obj_is_kind_of(value, rb_cFont) != Qtrue)
+        rb_raise(rb_eArgError, "a Font must be given with the :font option");
+    RGSS_NewFont *font = DATA_PTR(value);
+    if (font->desc == NULL)
+        rb_raise(rb_eRGSSError, "font has not been initialized");
+
+    int align, valign, plain;
+    RGSS_ParseOpt(opts, "align", PANGO_ALIGN_LEFT, &align);
+    RGSS_ParseOpt(opts, "valign", PANGO_ALIGN_LEFT, &valign);
+    RGSS_ParseOpt(opts, "plain", false, &plain);
+    value = NIL_P(opts) ? Qnil : rb_hash_aref(opts, STR2SYM("background"));
+    float *background = NIL_P(value) ? NULL : DATA_PTR(value);
+
+    // Only the part of the area within the texture is drawn and uploaded
+    int x0 = RGSS_MAX(dst_rect.x, 0), y0 = RGSS_MAX(dst_rect.y, 0);
+    int x1 = RGSS_MIN(dst_rect.x + dst_rect.width, target_width);
+    int y1 = RGSS_MIN(dst_rect.y + dst_rect.height, target_height);
+    if (x1 <= x0 || y1 <= y0)
+        return false;
+    int width = x1 - x0, height = y1 - y0;
+
+    text = StringValue(text);
+    int text_height;
+    PangoLayout *layout = RGSS_Font_GetLayout(font, RSTRING_PTR(text), RSTRING_LEN(text), dst_rect.width, -1, align,
+                                              plain, NULL, &text_height);
+    int offset = 0;
+    if (valign == PANGO_ALIGN_CENTER)
+        offset = (dst_rect.height - text_height) / 2;
+    else if (valign == PANGO_ALIGN_RIGHT)
+        offset = dst_rect.height - text_height;
+
+    // The area is replaced rather than blended, so the scratch surface starts as the background color
+    cairo_t *context = RGSS_Texture_GetScratch(width, height);
+    cairo_save(context);
+    cairo_rectangle(context, 0, 0, width, height);
+    cairo_clip(context);
+    cairo_set_operator(context, CAIRO_OPERATOR_SOURCE);
+    if (background)
+        cairo_set_source_rgba(context, background[0], background[1], background[2], background[3]);
+    else
+        cairo_set_source_rgba(context, 0.0, 0.0, 0.0, 0.0);
+    cairo_paint(context);
+    cairo_set_operator(context, CAIRO_OPERATOR_OVER);
+    cairo_set_source_rgba(context, font->color[0], font->color[1], font->color[2], font->color[3]);
+    cairo_move_to(context, dst_rect.x - x0, dst_rect.y - y0 + offset);
+    pango_cairo_show_layout(context, layout);
+    cairo_restore(context);
+
+    // Cairo stores premultiplied alpha, textures are straight alpha
+    cairo_surface_t *surface = RGSS_TEXT_SCRATCH.surface;
+    cairo_surface_flush(surface);
+    unsigned char *data = cairo_image_surface_get_data(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+    for (int y = 0; y < height; y++)
+        RGSS_Pixels_Unpremultiply((uint32_t *)(data + (size_t)y * stride), width);
+    cairo_surface_mark_dirty_rectangle(surface, 0, 0, width, height);
+
+    *area = (RGSS_Rect){x0, y0, width, height};
+    *pixels = (uint32_t *)data;
+    *row_length = stride / sizeof(uint32_t);
+    return true;
+}
 
-    // TODO: Parse opts, use vertical aligm, measure first, place appropriatly on image
+static VALUE RGSS_Texture_DrawText(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_ASSERT_TEXTURE(tex);
+
+    RGSS_Rect area;
+    uint32_t *data;
+    int row_length;
+    if (!RGSS_Texture_RenderText(argc, argv, tex->width, tex->height, &area, &data, &row_length))
+        return self;
+
+    // Pending commands are ordered before the text, and commands of other textures may still read the old contents
+    if (tex->pending_reads > 0)
+        RGSS_Texture_FlushAll();
+    RGSS_Texture_Flush(tex);
 
+    // Cairo pixels are native-endian ARGB words, which is what this format/type pair describes on any platform
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, tex->id);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, area.x, area.y, area.width, area.height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                    data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+    RGSS_Texture_Invalidate(tex);
     return self;
 }
 
-static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
+VALUE RGSS_Texture_ParseBlit(int argc, VALUE *argv, RGSS_Rect *dst_rect, RGSS_Rect *src_rect, float *opacity)
 {
-    
     // Quite a few argument combinations can be supplied.
     //
     // The first "section" of arguments can be any combination that make either a point, or a rectangle,
@@ -397,9 +828,7 @@ static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
     if (tex_index == -1)
         rb_raise(rb_eArgError, "invalid arguments");
 
-    float opacity;
-    RGSS_Texture *src = DATA_PTR(argv[tex_index]), *dst = DATA_PTR(self);
-    RGSS_Rect dst_rect, src_rect;
+    RGSS_Texture *src = DATA_PTR(argv[tex_index]);
 
     // Parse destination rect out of arguments
     switch (tex_index)
@@ -409,13 +838,13 @@ static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
             // (point)
             if (rb_obj_is_kind_of(argv[0], rb_cIVec2))
             {
-                memcpy(&dst_rect.location, DATA_PTR(argv[0]), sizeof(RGSS_Point));
-                dst_rect.width = src->width;
-                dst_rect.height = src->height;
+                memcpy(&dst_rect->location, DATA_PTR(argv[0]), sizeof(RGSS_Point));
+                dst_rect->width = src->width;
+                dst_rect->height = src->height;
             }
             // (rect)
             else if (rb_obj_is_kind_of(argv[0], rb_cRect))
-                memcpy(&dst_rect, DATA_PTR(argv[0]), sizeof(RGSS_Rect));
+                memcpy(dst_rect, DATA_PTR(argv[0]), sizeof(RGSS_Rect));
             else 
                 rb_raise(rb_eTypeError, "given %s, expected Point or Rect", CLASS_NAME(argv[0]));
             break;
@@ -425,26 +854,26 @@ static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
             // (point, size)
             if (rb_obj_is_kind_of(argv[0], rb_cIVec2))
             {
-                memcpy(&dst_rect.location, DATA_PTR(argv[0]), sizeof(RGSS_Point));
-                memcpy(&dst_rect.size, DATA_PTR(argv[1]), sizeof(RGSS_Size));
+                memcpy(&dst_rect->location, DATA_PTR(argv[0]), sizeof(RGSS_Point));
+                memcpy(&dst_rect->size, DATA_PTR(argv[1]), sizeof(RGSS_Size));
             }
             // (x, y)
             else
             {
-                dst_rect.x = NUM2INT(argv[0]);
-                dst_rect.y = NUM2INT(argv[1]);
-                dst_rect.width = src->width;
-                dst_rect.height = src->height;
+                dst_rect->x = NUM2INT(argv[0]);
+                dst_rect->y = NUM2INT(argv[1]);
+                dst_rect->width = src->width;
+                dst_rect->height = src->height;
             }
             break;
         }
         case 4:
         {
             // (x, y, w, h)
-            dst_rect.x = NUM2INT(argv[0]);
-            dst_rect.y = NUM2INT(argv[1]);
-            dst_rect.width = NUM2INT(argv[2]);
-            dst_rect.height = NUM2INT(argv[3]);
+            dst_rect->x = NUM2INT(argv[0]);
+            dst_rect->y = NUM2INT(argv[1]);
+            dst_rect->width = NUM2INT(argv[2]);
+            dst_rect->height = NUM2INT(argv[3]);
             break;
         }
         default: rb_raise(rb_eArgError, "invalid arguments");
@@ -455,34 +884,65 @@ static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
     {
         case 0:
         {
-            src_rect = (RGSS_Rect) { 0, 0, src->width, src->height };
-            opacity = 1.0f;
+            *src_rect = (RGSS_Rect) { 0, 0, src->width, src->height };
+            *opacity = 1.0f;
             break;
         }
         case 1:
         {
             if (rb_obj_is_kind_of(argv[tex_index + 1], rb_cRect))
             {
-                memcpy(&src_rect, DATA_PTR(argv[tex_index + 1]), sizeof(RGSS_Rect));
-                opacity = 1.0f;
+                memcpy(src_rect, DATA_PTR(argv[tex_index + 1]), sizeof(RGSS_Rect));
+                *opacity = 1.0f;
             }
             else
             {
-                src_rect = (RGSS_Rect) { 0, 0, src->width, src->height };
-                opacity = glm_clamp(NUM2FLT(argv[tex_index + 1]), 0.0f, 1.0f);
+                *src_rect = (RGSS_Rect) { 0, 0, src->width, src->height };
+                *opacity = glm_clamp(NUM2FLT(argv[tex_index + 1]), 0.0f, 1.0f);
             }
             break;
         }
         case 2:
         {
-            memcpy(&src_rect, DATA_PTR(argv[tex_index + 1]), sizeof(RGSS_Rect));
-            opacity = glm_clamp(NUM2FLT(argv[tex_index + 1]), 0.0f, 1.0f);
+            memcpy(src_rect, DATA_PTR(argv[tex_index + 1]), sizeof(RGSS_Rect));
+            *opacity = glm_clamp(NUM2FLT(argv[tex_index + 2]), 0.0f, 1.0f);
             break;
         }
         default: rb_raise(rb_eArgError, "invalid arguments");
     }
 
-    RGSS_Texture_BlitImpl(dst, src, &src_rect, &dst_rect, opacity);
+    return argv[tex_index];
+}
+
+static VALUE RGSS_Texture_Blit(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Rect dst_rect, src_rect;
+    float opacity;
+    VALUE source = RGSS_Texture_ParseBlit(argc, argv, &dst_rect, &src_rect, &opacity);
+
+    RGSS_Texture_BlitImpl(DATA_PTR(self), source, &src_rect, &dst_rect, opacity);
+    return self;
+}
+
+static VALUE RGSS_Texture_Copy(int argc, VALUE *argv, VALUE self)
+{
+    VALUE x, y, texture, rect;
+    rb_scan_args(argc, argv, "31", &x, &y, &texture, &rect);
+
+    if (rb_obj_is_kind_of(texture, rb_cTexture) != Qtrue)
+        rb_raise(rb_eTypeError, "%s is not a Texture", CLASS_NAME(texture));
+
+    RGSS_Texture *dst = DATA_PTR(self), *src = DATA_PTR(texture);
+    RGSS_ASSERT_TEXTURE(dst);
+    RGSS_ASSERT_TEXTURE(src);
+
+    RGSS_Rect src_rect;
+    if (NIL_P(rect))
+        src_rect = (RGSS_Rect) { 0, 0, src->width, src->height };
+    else
+        memcpy(&src_rect, DATA_PTR(rect), sizeof(RGSS_Rect));
+
+    RGSS_Texture_CopyImpl(dst, src, &src_rect, NUM2INT(x), NUM2INT(y));
     return self;
 }
 
@@ -496,6 +956,10 @@ static VALUE RGSS_Texture_Target(int argc, VALUE *argv, VALUE self)
     RGSS_Texture *tex = DATA_PTR(self);
     RGSS_ASSERT_TEXTURE(tex);
 
+    if (tex->pending_reads > 0)
+        RGSS_Texture_FlushAll();
+    RGSS_Texture_Flush(tex);
+
     int x, y, w, h;
     if (NIL_P(area))
     {
@@ -523,6 +987,7 @@ static VALUE RGSS_Texture_Target(int argc, VALUE *argv, VALUE self)
     glScissor(x, y, w, h);
 
     rb_yield(Qundef);
+    RGSS_Texture_Invalidate(tex);
 
     glBindBuffer(GL_UNIFORM_BUFFER, RGSS_GAME.graphics.ubo);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, RGSS_MAT4_SIZE, RGSS_GAME.graphics.projection);
@@ -535,55 +1000,77 @@ static VALUE RGSS_Texture_Target(int argc, VALUE *argv, VALUE self)
 
 static inline void RGSS_Texture_Fill(RGSS_Texture *tex, float *color, RGSS_Rect *rect)
 {
-    RGSS_Texture_BindFramebuffer(tex);
-    glScissor(rect->x, rect->y, rect->width, rect->height);
-    glClearColor(color[0], color[1], color[2], color[3]);
-    glClear(GL_COLOR_BUFFER_BIT);
-    RGSS_Graphics_Restore(rb_mGraphics);
+    if (rect->width < 1 || rect->height < 1)
+        return;
+
+    RGSS_BlitCommand cmd;
+    cmd.source = NULL;
+    cmd.object = Qnil;
+    cmd.dst[0] = (GLfloat) rect->x;
+    cmd.dst[1] = (GLfloat) rect->y;
+    cmd.dst[2] = (GLfloat) rect->width;
+    cmd.dst[3] = (GLfloat) rect->height;
+    glm_vec4_zero(cmd.src);
+    glm_vec4_copy(color, cmd.color);
+
+    RGSS_Texture_Record(tex, NULL, &cmd);
 }
 
 static VALUE RGSS_Texture_Clear(VALUE self)
 {
     RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_ASSERT_TEXTURE(tex);
+
+    // Everything still pending is overwritten by clearing the entire texture
+    if (tex->pending_reads > 0)
+        RGSS_Texture_FlushAll();
+    RGSS_Texture_ClearCommands(tex);
+
     RGSS_Rect rect = {0, 0, tex->width, tex->height};
     float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     RGSS_Texture_Fill(tex, color, &rect);
     return self;
 }
 
-static VALUE RGSS_Texture_FillRect(int argc, VALUE *argv, VALUE self)
+float *RGSS_Texture_ParseFill(int argc, VALUE *argv, RGSS_Rect *rect)
 {
     VALUE a0, a1, a2, a3, a4;
     rb_scan_args(argc, argv, "23", &a0, &a1, &a2, &a3, &a4);
 
-    RGSS_Texture *tex = DATA_PTR(self);
     float *color;
-    RGSS_Rect rect;
 
     switch (argc)
     {
         case 2: {
-            memcpy(&rect, DATA_PTR(a0), sizeof(RGSS_Rect));
+            memcpy(rect, DATA_PTR(a0), sizeof(RGSS_Rect));
             color = DATA_PTR(a1);
             break;
         }
         case 3: {
-            memcpy(&rect.location, DATA_PTR(a0), sizeof(RGSS_Point));
-            memcpy(&rect.size, DATA_PTR(a1), sizeof(RGSS_Size));
+            memcpy(&rect->location, DATA_PTR(a0), sizeof(RGSS_Point));
+            memcpy(&rect->size, DATA_PTR(a1), sizeof(RGSS_Size));
             color = DATA_PTR(a2);
             break;
         }
         case 5: {
-            rect.x = NUM2INT(a0);
-            rect.y = NUM2INT(a1);
-            rect.width = NUM2INT(a2);
-            rect.height = NUM2INT(a3);
+            rect->x = NUM2INT(a0);
+            rect->y = NUM2INT(a1);
+            rect->width = NUM2INT(a2);
+            rect->height = NUM2INT(a3);
             color = DATA_PTR(a4);
             break;
         }
         default:
-            rb_raise(rb_eArgError, "wrong number of arguments (given %d, expexted 2, 3, or 5)");
+            rb_raise(rb_eArgError, "wrong number of arguments (given %d, expexted 2, 3, or 5)", argc);
     }
+    return color;
+}
+
+static VALUE RGSS_Texture_FillRect(int argc, VALUE *argv, VALUE self)
+{
+    RGSS_Texture *tex = DATA_PTR(self);
+    RGSS_Rect rect;
+    float *color = RGSS_Texture_ParseFill(argc, argv, &rect);
 
     RGSS_Texture_Fill(tex, color, &rect);
     return self;
@@ -607,10 +1094,15 @@ void RGSS_Init_Texture(VALUE parent)
     rb_define_methodm1(rb_cTexture, "bind", RGSS_Texture_Bind, -1);
     rb_define_methodm1(rb_cTexture, "target", RGSS_Texture_Target, -1);
     rb_define_methodm1(rb_cTexture, "blit", RGSS_Texture_Blit, -1);
+    rb_define_methodm1(rb_cTexture, "copy", RGSS_Texture_Copy, -1);
+    rb_define_method0(rb_cTexture, "flush", RGSS_Texture_FlushRB, 0);
+    rb_define_method0(rb_cTexture, "generate_mipmaps", RGSS_Texture_GenerateMipmaps, 0);
+    rb_define_method0(rb_cTexture, "mipmaps?", RGSS_Texture_IsMipmapped, 0);
 
 
     rb_define_method0(rb_cTexture, "clear", RGSS_Texture_Clear, 0);
     rb_define_methodm1(rb_cTexture, "fill_rect", RGSS_Texture_FillRect, -1);
+    rb_define_methodm1(rb_cTexture, "draw_text", RGSS_Texture_DrawText, -1);
 
     rb_define_alias(rb_cTexture, "bounds", "rect");
     rb_define_alias(rb_cTexture, "blt", "blit");
@@ -620,6 +1112,5 @@ void RGSS_Init_Texture(VALUE parent)
     rb_define_singleton_method1(rb_cTexture, "unbind", RGSS_Texture_Unbind, 1);
     rb_define_singleton_method3(rb_cTexture, "wrap", RGSS_Texture_FromID, 3);
 
-    glm_vec4_zero(RGSS_VEC4_ZERO);
-    glm_mat4_identity(RGSS_BLIT_MODEL);
+    vec_init(&RGSS_PENDING_TEXTURES);
 }
\ No newline at end of file
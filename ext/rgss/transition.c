@@ -0,0 +1,234 @@
+#include "graphics.h"
+#include "game.h"
+
+#define RGSS_TRANSITION_DURATION 0.5 /** The default length of a transition, in seconds. */
+
+typedef struct
+{
+    GLuint fbo;     /** The framebuffer the texture is attached to. */
+    GLuint texture; /** The color attachment of the framebuffer. */
+    int width;      /** The width of the texture, in pixels. */
+    int height;     /** The height of the texture, in pixels. */
+} RGSS_RenderTarget;
+
+static struct
+{
+    RGSS_RenderTarget from; /** The snapshot of the screen taken when frozen. */
+    RGSS_RenderTarget to;   /** The scene being transitioned to. */
+    RGSS_Shader fade;       /** The built-in cross-fade program, used when no transition is given. */
+    GLuint vao;             /** The vertex array of the fullscreen quad. */
+    GLuint vbo;             /** The vertex buffer of the fullscreen quad. */
+    int frozen;             /** Flag indicating if the snapshot is drawn in place of the scene. */
+} RGSS_TRANSITION;
+
+/**
+ * @brief The corners of a quad covering the screen in normalized device coordinates, drawn as a triangle strip.
+ */
+static const GLfloat RGSS_TRANSITION_QUAD[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+
+static void RGSS_RenderTarget_Resize(RGSS_RenderTarget *target, int width, int height)
+{
+    // Targets are pooled, and only reallocated when the internal resolution changes
+    if (target->fbo != GL_NONE && target->width == width && target->height == height)
+        return;
+
+    if (target->texture == GL_NONE)
+        glGenTextures(1, &target->texture);
+    glBindTexture(GL_TEXTURE_2D, target->texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+    if (target->fbo == GL_NONE)
+    {
+        glGenFramebuffers(1, &target->fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, target->fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->texture, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, RGSS_GRAPHICS.target);
+    }
+
+    target->width = width;
+    target->height = height;
+}
+
+static void RGSS_RenderTarget_Delete(RGSS_RenderTarget *target)
+{
+    if (target->fbo != GL_NONE)
+        glDeleteFramebuffers(1, &target->fbo);
+    if (target->texture != GL_NONE)
+        glDeleteTextures(1, &target->texture);
+    memset(target, 0, sizeof(RGSS_RenderTarget));
+}
+
+void RGSS_Transition_Init(void)
+{
+    memset(&RGSS_TRANSITION, 0, sizeof(RGSS_TRANSITION));
+    RGSS_Program_Begin(&RGSS_TRANSITION.fade, TRANSITION_VERT_SRC, TRANSITION_FRAG_SRC, NULL);
+
+    glGenVertexArrays(1, &RGSS_TRANSITION.vao);
+    glBindVertexArray(RGSS_TRANSITION.vao);
+    RGSS_TRANSITION.vbo =
+        RGSS_CreateBuffer(GL_ARRAY_BUFFER, sizeof(RGSS_TRANSITION_QUAD), RGSS_TRANSITION_QUAD, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, SIZEOF_FLOAT * 2, NULL);
+    glBindVertexArray(GL_NONE);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_NONE);
+}
+
+void RGSS_Transition_Deinit(void)
+{
+    RGSS_RenderTarget_Delete(&RGSS_TRANSITION.from);
+    RGSS_RenderTarget_Delete(&RGSS_TRANSITION.to);
+    RGSS_Program_Delete(&RGSS_TRANSITION.fade);
+    glDeleteBuffers(1, &RGSS_TRANSITION.vbo);
+    glDeleteVertexArrays(1, &RGSS_TRANSITION.vao);
+    RGSS_TRANSITION.frozen = false;
+}
+
+int RGSS_Transition_DrawFrozen(void)
+{
+    if (!RGSS_TRANSITION.frozen)
+        return false;
+
+    RGSS_RenderTarget *from = &RGSS_TRANSITION.from;
+    RGSS_Rect *vp = &RGSS_GRAPHICS.viewport;
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, from->fbo);
+    glBlitFramebuffer(0, 0, from->width, from->height, vp->x, vp->y, vp->x + vp->width, vp->y + vp->height,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, GL_NONE);
+    return true;
+}
+
+static VALUE RGSS_Transition_DrawScene(VALUE target)
+{
+    RGSS_GRAPHICS.target = NUM2UINT(target);
+    RGSS_Graphics_Restore(rb_mGraphics);
+    RGSS_Graphics_RenderScene(0.0);
+    return Qnil;
+}
+
+static VALUE RGSS_Transition_DrawScreen(VALUE unused)
+{
+    RGSS_GRAPHICS.target = GL_NONE;
+    RGSS_Graphics_Restore(rb_mGraphics);
+    return Qnil;
+}
+
+static void RGSS_Transition_Run(RGSS_Shader *shader, double duration)
+{
+    RGSS_Program_Use(shader);
+    GLint progress = RGSS_Program_Locate(shader, "progress");
+    glUniform1i(RGSS_Program_Locate(shader, "from"), 0);
+    glUniform1i(RGSS_Program_Locate(shader, "to"), 1);
+    glUniform1f(RGSS_Program_Locate(shader, "ratio"), RGSS_GRAPHICS.resolution[0] / RGSS_GRAPHICS.resolution[1]);
+
+    // The quad is already in normalized device coordinates
+    mat4 identity;
+    glm_mat4_identity(identity);
+    RGSS_Graphics_SetProjection(identity);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, RGSS_TRANSITION.to.texture);
+    glBindSampler(1, GL_NONE);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, RGSS_TRANSITION.from.texture);
+    glBindSampler(0, GL_NONE);
+    glBindVertexArray(RGSS_TRANSITION.vao);
+    glDisable(GL_BLEND);
+
+    // Both frames are already on the GPU, so each frame of the transition is a single draw without calling into Ruby
+    double start = glfwGetTime();
+    double t;
+    do
+    {
+        t = RGSS_MIN((glfwGetTime() - start) / duration, 1.0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glUniform1f(progress, (GLfloat)t);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+        RGSS_GAME.time.fps_count++;
+        RGSS_GAME.time.total_frames++;
+        glfwSwapBuffers(RGSS_GAME.window);
+        glfwPollEvents();
+    } while (t < 1.0 && !glfwWindowShouldClose(RGSS_GAME.window));
+
+    glEnable(GL_BLEND);
+    glBindVertexArray(GL_NONE);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, GL_NONE);
+    RGSS_Graphics_SetProjection(RGSS_GRAPHICS.projection);
+}
+
+static VALUE RGSS_Graphics_Freeze(VALUE graphics)
+{
+    RGSS_ASSERT_GAME;
+    if (RGSS_TRANSITION.frozen)
+        return Qnil;
+
+    // The contents of the front buffer are undefined once presented, so the scene is drawn again into the snapshot
+    RGSS_RenderTarget *from = &RGSS_TRANSITION.from;
+    RGSS_RenderTarget_Resize(from, (int)RGSS_GRAPHICS.resolution[0], (int)RGSS_GRAPHICS.resolution[1]);
+    rb_ensure(RGSS_Transition_DrawScene, UINT2NUM(from->fbo), RGSS_Transition_DrawScreen, Qnil);
+
+    RGSS_TRANSITION.frozen = true;
+    return Qnil;
+}
+
+static VALUE RGSS_Graphics_IsFrozen(VALUE graphics)
+{
+    return RB_BOOL(RGSS_TRANSITION.frozen);
+}
+
+static VALUE RGSS_Graphics_Transition(int argc, VALUE *argv, VALUE graphics)
+{
+    RGSS_ASSERT_GAME;
+    VALUE duration, transition;
+    rb_scan_args(argc, argv, "02", &duration, &transition);
+
+    double seconds = NIL_P(duration) ? RGSS_TRANSITION_DURATION : NUM2DBL(duration);
+    RGSS_Shader *shader = &RGSS_TRANSITION.fade;
+    if (!NIL_P(transition))
+    {
+        // Built-in transitions may be given by name, and are compiled the first time they are used
+        if (SYMBOL_P(transition) || RB_TYPE_P(transition, T_STRING))
+        {
+            VALUE klass = rb_const_get(rb_mRGSS, rb_intern("Transition"));
+            transition = rb_funcall(klass, rb_intern("[]"), 1, transition);
+        }
+        if (!rb_obj_is_kind_of(transition, rb_cShader))
+            rb_raise(rb_eTypeError, "%s is not a Shader", CLASS_NAME(transition));
+        shader = DATA_PTR(transition);
+        RGSS_ASSERT_SHADER(shader->id);
+    }
+
+    if (!RGSS_TRANSITION.frozen)
+        return Qnil;
+
+    if (seconds > 0.0)
+    {
+        // The new scene is drawn once, and the transition blends between the two snapshots
+        RGSS_RenderTarget *to = &RGSS_TRANSITION.to;
+        RGSS_RenderTarget_Resize(to, (int)RGSS_GRAPHICS.resolution[0], (int)RGSS_GRAPHICS.resolution[1]);
+        rb_ensure(RGSS_Transition_DrawScene, UINT2NUM(to->fbo), RGSS_Transition_DrawScreen, Qnil);
+        RGSS_Transition_Run(shader, seconds);
+    }
+
+    // Prevent the game loop from trying to catch up on ticks missed during the transition
+    RGSS_TRANSITION.frozen = false;
+    RGSS_GAME.time.last = glfwGetTime();
+    return Qnil;
+}
+
+void RGSS_Init_Transition(VALUE parent)
+{
+    rb_define_singleton_method0(parent, "freeze", RGSS_Graphics_Freeze, 0);
+    rb_define_singleton_method0(parent, "frozen?", RGSS_Graphics_IsFrozen, 0);
+    rb_define_singleton_methodm1(parent, "transition", RGSS_Graphics_Transition, -1);
+}
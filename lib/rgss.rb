@@ -3,6 +3,8 @@ $RGSS_DEBUG = true # TODO
 require_relative 'rgss/version'
 require_relative 'rgss/log'
 require_relative 'rgss/rgss'
+require_relative 'rgss/archive'
+require_relative 'rgss/transition'
 
 module RGSS
 
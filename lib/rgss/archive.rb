@@ -0,0 +1,21 @@
+module RGSS
+
+  class Archive
+
+    ##
+    # Packs every file within a directory into a new archive, using paths relative to the directory.
+    # @param output [String] the path of the archive to create.
+    # @param dir [String] the directory containing the files to pack.
+    # @param pattern [String] a glob pattern relative to `dir` selecting which files are packed.
+    # @param compress [Boolean] `true` to compress files where it is worthwhile, otherwise `false` to store all files.
+    # @return [void]
+    def self.pack(output, dir, pattern: '**/*', compress: true)
+      files = {}
+      Dir.glob(pattern, base: dir).sort.each do |name|
+        source = File.join(dir, name)
+        files[name] = source if File.file?(source)
+      end
+      create(output, files, compress: compress)
+    end
+  end
+end
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 uv;
+in vec4 tint;
+out vec4 result;
+
+uniform sampler2D image;
+uniform bool textured;
+
+void main() {
+    // Blits modulate the source texture, fills write the color as-is
+    result = textured ? texture(image, uv) * tint : tint;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(location = 0) in vec4 vertex;
+layout(location = 1) in vec4 dst_rect;
+layout(location = 2) in vec4 src_rect;
+layout(location = 3) in vec4 blend;
+
+out vec2 uv;
+out vec4 tint;
+
+uniform vec2 target_size;
+
+void main() {
+    uv = mix(src_rect.xy, src_rect.zw, vertex.zw);
+    tint = blend;
+    vec2 position = dst_rect.xy + vertex.xy * dst_rect.zw;
+    gl_Position = vec4(position / target_size * 2.0 - 1.0, 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#version 330 core
+
+in vec2 uv;
+in vec4 tint;
+flat in vec4 bounds;
+flat in vec2 texel;
+out vec4 result;
+
+uniform sampler2D atlas;
+uniform vec4 color;
+uniform vec4 tone;
+uniform vec4 flash;
+uniform float opacity = 1.0;
+uniform float hue;
+
+uniform float spread;
+uniform vec4 outline_color;
+uniform float outline_width;
+uniform vec4 shadow_color;
+uniform vec2 shadow_offset;
+
+const vec3 k = vec3(0.57735, 0.57735, 0.57735);
+
+vec4 over(vec4 top, vec4 bottom) {
+    float a = top.a + bottom.a * (1.0 - top.a);
+    if (a <= 0.0)
+        return vec4(0.0);
+    return vec4((top.rgb * top.a + bottom.rgb * bottom.a * (1.0 - top.a)) / a, a);
+}
+
+float sampleDistance(vec2 coord) {
+    // Neighboring glyphs must not be sampled, anything outside of the glyph is far from its outline
+    if (any(lessThan(coord, bounds.xy)) || any(greaterThan(coord, bounds.zw)))
+        return 0.0;
+    return texture(atlas, coord).r;
+}
+
+void main() {
+
+    // The atlas stores the distance to the outline, which is at 0.5 and increases towards the inside
+    float field = texture(atlas, uv).r;
+    float aa = max(fwidth(field) * 0.5, 0.0001);
+    vec4 glyph = vec4(tint.rgb, tint.a * smoothstep(0.5 - aa, 0.5 + aa, field));
+
+    // The outline grows the glyph outwards, limited by how far the distance field reaches
+    float edge = 0.5;
+    if (outline_width > 0.0) {
+        edge = max(0.5 - outline_width * texel.x / (2.0 * spread), aa);
+        float outline = smoothstep(edge - aa, edge + aa, field);
+        glyph = over(glyph, vec4(outline_color.rgb, outline_color.a * tint.a * outline));
+    }
+
+    // The shadow is the shape of the glyph and its outline, sampled at an offset
+    if (shadow_color.a > 0.0) {
+        float shadow = smoothstep(edge - aa, edge + aa, sampleDistance(uv - shadow_offset * texel));
+        glyph = over(glyph, vec4(shadow_color.rgb, shadow_color.a * tint.a * shadow));
+    }
+    result = glyph;
+
+    // Apply hue shift
+    float angle = cos(radians(hue));
+    vec3 rgb = vec3(result.rgb * angle + cross(k, result.rgb) * sin(radians(hue)) + k * dot(k, result.rgb) * (1.0 - angle));
+    result = vec4(rgb, result.a);
+
+    // Apply color blending
+    result = vec4(mix(result.rgb, color.rgb, color.a), result.a);
+
+    // Apply tone blending
+    float avg = (result.r + result.g + result.b) / 3.0;
+    result.r  = result.r - ((result.r - avg) * tone.a);
+    result.g  = result.g - ((result.g - avg) * tone.a);
+    result.b  = result.b - ((result.b - avg) * tone.a);
+    result = vec4(clamp(result.rgb + tone.rgb, 0.0, 1.0), result.a);
+
+    // Flash effect color blending
+    result = vec4(mix(result.rgb, flash.rgb, flash.a), result.a);
+
+    // Apply opacity
+    result *= opacity;
+}
@@ -0,0 +1,37 @@
+#version 330 core
+
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec4 dst_rect;
+layout(location = 2) in vec4 src_rect;
+layout(location = 3) in vec4 glyph_color;
+layout(location = 4) in float glyph_index;
+
+out vec2 uv;
+out vec4 tint;
+flat out vec4 bounds;
+flat out vec2 texel;
+
+layout (std140) uniform RGSS
+{
+    mat4 projection;
+};
+
+uniform mat4 model;
+uniform float reveal;
+uniform float reveal_fade;
+
+void main() {
+    // Each instance is a glyph, positioned in pixels relative to the origin of the text
+    uv = mix(src_rect.xy, src_rect.zw, corner);
+    tint = glyph_color;
+
+    // Glyphs are revealed in the order of the text, each fading in over the given number of glyphs
+    if (reveal_fade > 0.0)
+        tint.a *= clamp((reveal - glyph_index) / reveal_fade, 0.0, 1.0);
+    else
+        tint.a *= step(glyph_index + 1.0, reveal);
+
+    bounds = src_rect;
+    texel = (src_rect.zw - src_rect.xy) / dst_rect.zw;
+    gl_Position = projection * model * vec4(dst_rect.xy + corner * dst_rect.zw, 0.0, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 330 core
+
+in vec2 _uv;
+out vec4 result;
+
+uniform sampler2D from, to;
+uniform float progress, ratio;
+
+vec4 getFromColor(vec2 uv) {
+    return texture(from, uv);
+}
+
+vec4 getToColor(vec2 uv) {
+    return texture(to, uv);
+}
+
+// The built-in cross-fade used when no transition is given
+vec4 transition(vec2 uv) {
+    return mix(getFromColor(uv), getToColor(uv), progress);
+}
+
+void main() {
+    result = transition(_uv);
+}
\ No newline at end of file
@@ -7,9 +7,9 @@ uniform sampler2D from, to;
 uniform float progress, ratio;
 
 vec4 getFromColor(vec2 uv) {
-    return texture2D(from, uv);
+    return texture(from, uv);
 }
 
 vec4 getToColor(vec2 uv) {
-    return texture2D(to, uv);
+    return texture(to, uv);
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #version 330 core
 
-in vec2 _p;
+layout(location = 0) in vec2 _p;
 out vec2 _uv;
 
 layout (std140) uniform RGSS
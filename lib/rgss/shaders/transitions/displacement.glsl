@@ -9,7 +9,7 @@ uniform float strength = 0.5;
 
 vec4 transition(vec2 uv) {
     
-    float displacement = texture2D(map, uv).r * strength;
+    float displacement = texture(map, uv).r * strength;
 
     vec2 uvFrom = vec2(uv.x + progress * displacement, uv.y);
     vec2 uvTo = vec2(uv.x - (1.0 - progress) * displacement, uv.y);
@@ -30,6 +30,14 @@ module RGSS
     # Multiply this by the number of pixels that represent a meter in your world to apply.
     EARTH_GRAVITY = 9.81
 
+    ##
+    # New particles are not emitted when the emitter is full.
+    OVERFLOW_DROP = 0
+
+    ##
+    # New particles replace the oldest particles alive when the emitter is full.
+    OVERFLOW_REPLACE = 1
+
     ##
     # The source texture used for particles. When `nil`, it defaults to simply using circular
     # "point sprites".
@@ -71,6 +79,16 @@ module RGSS
     attr_accessor :radius
     attr_accessor :rate
     attr_accessor :lifespan
+
+    ##
+    # The colors particles are randomly given when emitted. A {Color} gives every particle the same color, an Array
+    # of colors picks one of them, and a Range of colors picks a color between its ends. When `nil`, each particle is
+    # given a random opaque color.
+    #
+    # The value is resolved into a table of colors when assigned, so changes made to the colors afterwards are not
+    # seen until the spectrum is assigned again.
+    #
+    # @return [Color,Array<Color>,Range(Color,Color),NilClass] the colors of new particles.
     attr_accessor :spectrum
     attr_accessor :friction
     attr_accessor :force
@@ -84,6 +102,120 @@ module RGSS
     attr_accessor :frequency
     attr_reader :interval
 
+    ##
+    # @return [Integer] the maximum number of particles that can be alive at once.
+    attr_reader :capacity
+
+    ##
+    # @return [Integer] the number of particles currently alive.
+    attr_reader :count
+
+    ##
+    # The amount added to the depth of each particle every tick, which determines the order particles are drawn in.
+    # Particles are sorted by depth each update unless this is `0`, in which case they are drawn in no particular
+    # order, which is slightly faster for emitters where the order is not noticeable.
+    #
+    # Emitters are unordered by default. Set this to `ORDER_YOUNGEST` to draw new particles on top of older ones, as
+    # emitters did by default before.
+    #
+    # @return [Integer] one of the `ORDER_*` constants, or `0` to not sort particles, which is the default.
+    attr_accessor :order
+
+    ##
+    # Determines what happens to new particles when all of the particles of the emitter are alive. Dropping them is
+    # cheaper, while replacing the oldest keeps a continuous stream at the cost of a pass over the live particles on
+    # each emission that overflows. Either way, the particles are counted in the `:overflows` of {#stats}.
+    #
+    # @return [Integer] one of the `OVERFLOW_*` constants, `OVERFLOW_DROP` by default.
+    attr_accessor :overflow
+
+    ##
+    # Updates several emitters at once, which is the same as calling {#update} on each of them, except that their
+    # particles are simulated in parallel with the GVL released. Each emitter has its own stream of random numbers,
+    # so the result does not depend on how the work is divided between threads. While they are simulated, other
+    # threads that update, prewarm, dispose, or change the emission settings of any of the emitters raise an error.
+    #
+    # @param emitters [Array<Emitter>] the emitters to update.
+    # @param delta [Float] the amount of time that has passed, in ticks.
+    # @return [Array<Emitter>] the emitters.
+    def self.update_all(emitters, delta)
+    end
+
+    ##
+    # Fast-forwards the emitter by a number of ticks, so that effects such as fog or fireflies start out already
+    # filled in instead of appearing gradually. Only the particles are advanced, {#update} is not called, and the
+    # particles are uploaded once after the last tick.
+    #
+    # @param ticks [Integer] the number of ticks to advance.
+    # @return [self]
+    def prewarm(ticks)
+    end
+
+    ##
+    # An emitter is culled when neither its spawn area nor its live particles, extended by the furthest distance a
+    # particle can travel in its lifespan, are within its viewport, or the screen when it has none. Culled emitters
+    # are not simulated, uploaded, or drawn, and their particles resume from where they were once they can be seen.
+    #
+    # @return [Boolean] `true` if the emitter was culled during the last update, otherwise `false`.
+    def culled?
+    end
+
+    ##
+    # @return [Integer,NilClass] the number of particles alive across all emitters to stay within, or `nil` for no
+    #   limit. When exceeded, the rate of all emitters is scaled down until it is no longer.
+    def self.budget
+    end
+
+    ##
+    # @param value [Integer,NilClass] the number of live particles to stay within, or `nil` for no limit.
+    def self.budget=(value)
+    end
+
+    ##
+    # @return [Float,NilClass] the time spent simulating particles each tick to stay within in milliseconds, or
+    #   `nil` for no limit. When exceeded, the rate of all emitters is scaled down until it is no longer.
+    def self.time_budget
+    end
+
+    ##
+    # @param value [Float,NilClass] the time in milliseconds to stay within, or `nil` for no limit.
+    def self.time_budget=(value)
+    end
+
+    ##
+    # The distance from the center of the view at which an emitter is scaled down as if it had half its {#priority},
+    # so that distant emitters give up their particles first. The view is the viewport of the emitter, or the screen.
+    #
+    # @return [Float,NilClass] the distance in pixels, or `nil` to use half the diagonal of the view.
+    def self.lod_distance
+    end
+
+    ##
+    # @param value [Float,NilClass] the distance in pixels, or `nil` to use half the diagonal of the view.
+    def self.lod_distance=(value)
+    end
+
+    ##
+    # @return [Hash{Symbol=>Numeric}] the number of particles alive across all emitters as `:live`, the time spent
+    #   simulating them during the last tick in milliseconds as `:time`, and the factor emission is currently scaled
+    #   by to stay within the budget as `:scale`.
+    def self.budget_stats
+    end
+
+    ##
+    # Emitters with a higher priority keep more of their rate when emission is scaled down to stay within the
+    # budget. An emitter with a priority of `0.0` stops emitting whenever the budget is exceeded.
+    #
+    # @return [Float] the importance of the emitter, `1.0` by default.
+    attr_accessor :priority
+
+    ##
+    # @return [Hash{Symbol=>Numeric}] the `:count` of particles alive, the `:capacity`, the number of particles
+    #   that were dropped or replaced because the emitter was full as `:overflows`, and the factor its rate is scaled
+    #   by to stay within the budget as `:scale`.
+    def stats
+    end
+
     def size=(value) # TODO Change to particle_size
     end
   end
@@ -0,0 +1,54 @@
+module RGSS
+
+  ##
+  # An independent stream of random numbers, using the same Xoshiro256** generator as {RGSS.rand}.
+  #
+  # Each stream is split from the global generator (or its seed) by jumping ahead, so streams never overlap, and
+  # each may be used from its own thread without locking. Filling a buffer generates the numbers in bulk, several at a
+  # time with SIMD instructions where available, which is much faster than calling {#rand} for each of them.
+  class RNG
+
+    ##
+    # Creates a new instance of the {RNG} class.
+    #
+    # @param seed [Integer,NilClass] a seed to always generate the same sequence from, or `nil` to take a new stream
+    #   from the global generator.
+    def initialize(seed = nil)
+    end
+
+    ##
+    # @overload rand
+    #   @return [Float] a random number between `0.0` and `1.0`.
+    # @overload rand(min, max)
+    #   @param min [Integer] the lower bound (inclusive).
+    #   @param max [Integer] the upper bound (inclusive).
+    #   @return [Integer] a random integer between `min` and `max`.
+    def rand(*args)
+    end
+
+    ##
+    # Fills a buffer with random numbers. Integers are generated when both bounds are Integers, otherwise floats.
+    #
+    # @overload fill(buffer)
+    #   @param buffer [String,Array] the buffer to fill with floats between `0.0` and `1.0`.
+    # @overload fill(buffer, min, max)
+    #   @param buffer [String,Array] the buffer to fill.
+    #   @param min [Numeric] the lower bound (inclusive).
+    #   @param max [Numeric] the upper bound, which is inclusive for integers and exclusive for floats.
+    #
+    # A String is filled with as many native 32-bit values as fit in its length, the same as `Array#pack` with
+    # `"f*"` or `"l*"`, without creating a Ruby object for each number. Each element of an Array is replaced.
+    #
+    # @return [String,Array] the buffer.
+    def fill(buffer, min = nil, max = nil)
+    end
+
+    ##
+    # Creates a new stream from the numbers this one would generate next, which continues after them.
+    # Streams split from a seeded {RNG} are also reproducible.
+    #
+    # @return [RNG] the new stream.
+    def split
+    end
+  end
+end
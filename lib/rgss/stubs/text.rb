@@ -0,0 +1,114 @@
+module RGSS
+
+  ##
+  # Draws a string of text or Pango markup with a {Font}.
+  #
+  # The text is shaped once when it changes, and each glyph is drawn as an instanced quad from a glyph atlas that
+  # is shared by all text objects. Glyphs are only rasterized the first time a font uses them at a given size, so
+  # changing the text only rewrites a small buffer of glyph positions, and never creates or deletes textures.
+  class Text < Renderable
+
+    ##
+    # @return [Font] the font the text is laid out with.
+    attr_accessor :font
+
+    ##
+    # @return [String,NilClass] the text or markup being drawn.
+    attr_accessor :text
+
+    ##
+    # @return [Integer] the alignment of lines, one of the `Font::ALIGN_*` constants.
+    attr_accessor :align
+
+    ##
+    # @return [Integer,NilClass] the width in pixels lines are wrapped at, or `nil` to not wrap.
+    attr_accessor :wrap_width
+
+    ##
+    # @return [Color] the color of the outline drawn around glyphs. Only used when drawn with distance fields.
+    attr_accessor :outline_color
+
+    ##
+    # @return [Float] the width of the outline in pixels, or `0.0` to not draw one. The width is limited by how far
+    #   the distance field of a glyph reaches, which is about a sixth of the font size.
+    attr_accessor :outline_width
+
+    ##
+    # @return [Color] the color of the drop shadow. Only used when drawn with distance fields.
+    attr_accessor :shadow_color
+
+    ##
+    # @return [Vec2] the offset of the drop shadow in pixels, which should stay within the outline width limit.
+    attr_accessor :shadow_offset
+
+    ##
+    # The number of glyphs shown, counted in the order of the text, for revealing a message a character at a time
+    # without laying it out again. Fractional values partially fade in the next glyph when {#reveal_fade} is used.
+    # Glyphs without ink, such as spaces, are not counted.
+    #
+    # @return [Float,NilClass] the number of glyphs shown, or `nil` to show all of them.
+    attr_accessor :reveal
+
+    ##
+    # @return [Float] the number of glyphs the fade-in of a revealed glyph spans, or `0.0` to show each at once.
+    attr_accessor :reveal_fade
+
+    ##
+    # @return [Float] the number of glyphs {#reveal} is advanced by each update, or `0.0` to only change it manually.
+    attr_accessor :reveal_speed
+
+    ##
+    # Creates a new instance of the {Text} class.
+    #
+    # @param font [Font] the font to lay out the text with.
+    # @param viewport [Viewport,NilClass] the viewport the text is drawn in, or `nil` to draw it on the screen.
+    # @param opts [Hash] the options to create the text with.
+    # @option opts [String] :text the text or markup to draw.
+    # @option opts [Integer] :width the width in pixels lines are wrapped at.
+    # @option opts [Integer] :align the alignment of lines, one of the `Font::ALIGN_*` constants.
+    # @option opts [Boolean] :plain (false) `true` to draw the text as-is instead of parsing it as markup.
+    # @option opts [Boolean] :sdf (false) `true` to draw glyphs from distance fields, see {#sdf?}.
+    def initialize(font, viewport = nil, **opts)
+    end
+
+    ##
+    # @return [Boolean] `true` if the text is drawn as-is, or `false` if it is parsed as markup.
+    def plain?
+    end
+
+    ##
+    # @param value [Boolean] `true` to draw the text as-is, or `false` to parse it as markup.
+    def plain=(value)
+    end
+
+    ##
+    # Glyphs drawn from distance fields are generated once from a reference size, and stay sharp at any size,
+    # scale, or rotation of the text. They also support outlines and shadows, which are computed by the shader.
+    # Small text drawn at its own size is slightly sharper without them.
+    #
+    # @return [Boolean] `true` if glyphs are drawn from distance fields, otherwise `false`.
+    def sdf?
+    end
+
+    ##
+    # @param value [Boolean] `true` to draw glyphs from distance fields, or `false` to draw them as rasterized.
+    def sdf=(value)
+    end
+
+    ##
+    # @return [Boolean] `true` if all glyphs are shown and have completely faded in, otherwise `false`.
+    def revealed?
+    end
+
+    ##
+    # Lays out the text again, which is only required after changing the properties of its font.
+    # @return [self]
+    def refresh
+    end
+
+    ##
+    # @return [Integer] the number of glyphs drawn, which excludes whitespace and other glyphs without ink.
+    def glyph_count
+    end
+  end
+end
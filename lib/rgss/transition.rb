@@ -1,17 +1,35 @@
-
 module RGSS
 
-  class Transition < Shader
+  class Transition < Graphics::Shader
 
     BASE_PATH = File.join(__dir__, 'shaders', 'transitions')
 
+    ##
+    # Retrieves a built-in transition by name. Transitions are only compiled the first time they are requested, and
+    # the same instance is returned afterwards.
+    # @param name [String, Symbol] the name of the transition, such as `:burn` or `"circle-open"`.
+    # @return [Transition] the transition.
+    def self.[](name)
+      @transitions ||= {}
+      @transitions[name.to_s] ||= load(name.to_s)
+    end
+
+    ##
+    # @return [Array<String>] the names of all built-in transitions, without compiling any of them.
+    def self.names
+      Dir.glob('*.glsl', base: BASE_PATH).map { |file| File.basename(file, '.glsl') } - %w[base-fragment base-vertex]
+    end
+
     def self.load(path, **opts)
 
       raise(ArgumentError, "path cannot be nil") unless path
-        
+      frag_src = Archive.read(path)
+      return new(frag_src, **opts) if frag_src
+
       unless File.exist?(path)
         temp = File.join(BASE_PATH, path)
-        raise(Errno::ENOENT, path) unless File.exist?(temp_path)
+        temp += '.glsl' if File.extname(temp).empty?
+        raise(Errno::ENOENT, path) unless File.exist?(temp)
         path = temp
       end
 
@@ -22,19 +40,12 @@ module RGSS
     def initialize(frag_source, **opts)
 
       vert_src = File.read(File.join(BASE_PATH, 'base-vertex.glsl'))
-      frag_src = sprintf(File.read(File.join(BASE_PATH, 'base-fragment.glsl')), frag_source)
-
-      super(vert_src, frag_source)
+      frag_src = File.read(File.join(BASE_PATH, 'base-fragment.glsl'))
 
-      uniforms.each_pair do |name, type|
-        location = locate(name.to_s)
- 
-        define_method(name) do |value|
-          uniform(location, value)
-        end
-      end
-
-      private_constant :BASE_PATH
+      # The program is compiled in the background where supported, and waited on when first used
+      super(vert_src, "#{frag_src}\n#{frag_source}\nvoid main() {\n    result = transition(_uv);\n}\n")
     end
+
+    private_constant :BASE_PATH
   end
-end
\ No newline at end of file
+end
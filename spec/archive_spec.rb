@@ -0,0 +1,94 @@
+RSpec.describe RGSS::Archive do
+
+  let(:dir) { Dir.mktmpdir('rgss') }
+  let(:path) { File.join(dir, 'test.rgss') }
+
+  after { FileUtils.remove_entry(dir) }
+
+  def write(name, contents)
+    source = File.join(dir, name)
+    File.binwrite(source, contents)
+    source
+  end
+
+  let(:contents) do
+    {
+      'Data/Map001.rxdata' => 'map' * 1000,
+      'Graphics/Title.png' => Random.new(1).bytes(4096),
+      'readme.txt' => 'hello',
+      'empty.dat' => ''
+    }
+  end
+
+  [true, false].each do |compress|
+    context "when created with compress: #{compress}" do
+      subject(:archive) do
+        files = contents.each_with_index.to_h { |(name, data), i| [name, write("source#{i}", data)] }
+        described_class.create(path, files, compress: compress)
+        described_class.new(path)
+      end
+
+      after { archive.close }
+
+      it 'reads back the contents of every file' do
+        contents.each { |name, data| expect(archive.read(name).b).to eq(data.b) }
+      end
+
+      it 'lists every entry by its normalized path' do
+        expect(archive.entries).to match_array(contents.keys.map(&:downcase))
+        expect(archive.size).to eq(contents.size)
+      end
+
+      it 'matches paths case-insensitively with either separator' do
+        expect(archive.include?('data\\MAP001.rxdata')).to be(true)
+        expect(archive.include?('./graphics/title.png')).to be(true)
+        expect(archive.read('README.TXT')).to eq('hello')
+      end
+
+      it 'returns nil for missing files' do
+        expect(archive.include?('missing.txt')).to be(false)
+        expect(archive.read('missing.txt')).to be_nil
+      end
+    end
+  end
+
+  it 'creates an empty archive' do
+    described_class.create(path, {})
+    archive = described_class.new(path)
+    expect(archive.size).to eq(0)
+    expect(archive.entries).to eq([])
+    archive.close
+  end
+
+  it 'rejects keys that normalize to the same path' do
+    source = write('source', 'data')
+    files = { 'Data/File.txt' => source, 'data\\file.TXT' => source }
+    expect { described_class.create(path, files) }.to raise_error(ArgumentError, /duplicate/)
+  end
+
+  it 'rejects empty paths' do
+    expect { described_class.create(path, { './' => write('source', 'data') }) }.to raise_error(ArgumentError)
+  end
+
+  it 'raises when a source cannot be read' do
+    files = { 'missing.txt' => File.join(dir, 'missing.txt') }
+    expect { described_class.create(path, files) }.to raise_error(SystemCallError)
+  end
+
+  it 'packs a directory' do
+    root = File.join(dir, 'game')
+    FileUtils.mkdir_p(File.join(root, 'Audio'))
+    File.binwrite(File.join(root, 'Audio', 'theme.ogg'), 'ogg' * 100)
+    File.binwrite(File.join(root, 'main.rb'), 'puts 1')
+
+    described_class.pack(path, root)
+    archive = described_class.new(path)
+    expect(archive.entries).to match_array(%w[audio/theme.ogg main.rb])
+    expect(archive.read('Audio/theme.ogg')).to eq('ogg' * 100)
+    archive.close
+  end
+
+  it 'refuses to open a file that is not an archive' do
+    expect { described_class.new(write('bogus.rgss', 'not an archive')) }.to raise_error(RGSS::RGSSError)
+  end
+end
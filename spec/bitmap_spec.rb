@@ -0,0 +1,54 @@
+RSpec.describe RGSS::Bitmap do
+
+  # Bitmaps are backed by a texture, so a (hidden) window is required for a GL context
+  before(:all) do
+    begin
+      RGSS::Game.create(64, 64, 'RGSS Spec', visible: false)
+    rescue RuntimeError => e
+      skip("no OpenGL context available: #{e.message}")
+    end
+    @dir = Dir.mktmpdir('rgss-bitmap')
+    @image = RGSS::Image.new(3, 2, ([255, 0, 0, 255] * 6).pack('C*'))
+    @path = File.join(@dir, 'red.png')
+    @image.save(@path)
+  end
+
+  after(:all) do
+    FileUtils.remove_entry(@dir) if @dir
+  end
+
+  let(:opts) { { mipmaps: true } }
+
+  def expect_bitmap(bitmap, width, height)
+    expect(bitmap.width).to eq(width)
+    expect(bitmap.height).to eq(height)
+    expect(bitmap.mipmaps?).to be(true)
+    bitmap.dispose
+  end
+
+  describe '.new' do
+    it 'creates an empty bitmap from a size and options' do
+      expect_bitmap(described_class.new(5, 4, **opts), 5, 4)
+    end
+
+    it 'loads a bitmap from a path and options' do
+      expect_bitmap(described_class.new(@path, **opts), 3, 2)
+    end
+
+    it 'copies a bitmap from an image and options' do
+      expect_bitmap(described_class.new(@image, **opts), 3, 2)
+    end
+
+    it 'loads a bitmap from a path without options' do
+      bitmap = described_class.new(@path)
+      expect([bitmap.width, bitmap.height]).to eq([3, 2])
+      bitmap.dispose
+    end
+  end
+
+  describe '.load' do
+    it 'passes the options to the new bitmap' do
+      expect_bitmap(described_class.load(@path, **opts), 3, 2)
+    end
+  end
+end
@@ -0,0 +1,85 @@
+RSpec.describe RGSS::Image do
+
+  # Each pixel holds its own index, so any misplaced pixel is detected
+  def numbered(width, height)
+    described_class.new(width, height, (1..width * height).to_a.pack('L*'))
+  end
+
+  def rows(image)
+    image.pixels.unpack('L*').each_slice(image.width).to_a
+  end
+
+  def solid(width, height, r, g, b)
+    described_class.new(width, height, ([r, g, b, 255] * (width * height)).pack('C*'))
+  end
+
+  describe '#flip' do
+    sizes = [[1, 1], [2, 2], [3, 3], [4, 5], [5, 4], [7, 1], [1, 7], [33, 17], [64, 3]]
+
+    sizes.each do |width, height|
+      context "with a #{width}x#{height} image" do
+        let(:image) { numbered(width, height) }
+        let(:original) { rows(image) }
+
+        it 'leaves the image unchanged with FLIP_NONE' do
+          expected = original
+          image.flip(described_class::FLIP_NONE)
+          expect(rows(image)).to eq(expected)
+        end
+
+        it 'mirrors each row with FLIP_X' do
+          expected = original.map(&:reverse)
+          image.flip(described_class::FLIP_X)
+          expect(rows(image)).to eq(expected)
+        end
+
+        it 'reverses the order of rows with FLIP_Y' do
+          expected = original.reverse
+          image.flip(described_class::FLIP_Y)
+          expect(rows(image)).to eq(expected)
+        end
+
+        it 'mirrors both ways with FLIP_BOTH' do
+          expected = original.reverse.map(&:reverse)
+          image.flip(described_class::FLIP_BOTH)
+          expect(rows(image)).to eq(expected)
+        end
+
+        it 'restores the image when flipped twice' do
+          expected = original
+          2.times { image.flip(described_class::FLIP_BOTH) }
+          expect(rows(image)).to eq(expected)
+        end
+      end
+    end
+
+    it 'returns the image' do
+      image = numbered(2, 2)
+      expect(image.flip(described_class::FLIP_X)).to be(image)
+    end
+
+    it 'raises when the image is disposed' do
+      image = numbered(2, 2)
+      image.dispose
+      expect { image.flip(described_class::FLIP_X) }.to raise_error(RuntimeError)
+    end
+  end
+
+  describe '#blit' do
+    let(:image) { solid(4, 4, 255, 0, 0) }
+    let(:source) { solid(2, 2, 0, 0, 255) }
+
+    it 'copies an opaque source at full opacity' do
+      image.blit(1, 1, source, nil, 1.0)
+      blue = [0, 0, 255, 255].pack('C*').unpack1('L')
+      expect(rows(image)[1][1, 2]).to eq([blue, blue])
+      expect(rows(image)[0]).to all(eq([255, 0, 0, 255].pack('C*').unpack1('L')))
+    end
+
+    it 'leaves the image unchanged at zero opacity' do
+      expected = image.pixels
+      image.blit(0, 0, source, nil, 0.0)
+      expect(image.pixels).to eq(expected)
+    end
+  end
+end
@@ -0,0 +1,131 @@
+RSpec.describe RGSS::RNG do
+
+  def floats(rng, count, *bounds)
+    rng.fill("\0" * (count * 4), *bounds).unpack('f*')
+  end
+
+  def ints(rng, count, min, max)
+    rng.fill("\0" * (count * 4), min, max).unpack('l*')
+  end
+
+  describe '#fill' do
+    it 'generates the same floats from the same seed' do
+      expect(floats(described_class.new(42), 100)).to eq(floats(described_class.new(42), 100))
+    end
+
+    it 'generates the same integers from the same seed' do
+      expect(ints(described_class.new(42), 100, -50, 50)).to eq(ints(described_class.new(42), 100, -50, 50))
+    end
+
+    it 'generates different numbers from different seeds' do
+      expect(floats(described_class.new(1), 16)).not_to eq(floats(described_class.new(2), 16))
+    end
+
+    it 'continues the sequence on each call' do
+      rng = described_class.new(7)
+      first = floats(rng, 8)
+      second = floats(rng, 8)
+      expect(second).not_to eq(first)
+      expect(first + second).to eq(floats(described_class.new(7), 16))
+    end
+
+    it 'generates the same sequence regardless of the count' do
+      # Counts that are not a multiple of the SIMD width finish with the scalar path
+      [1, 3, 5, 7, 13].each do |count|
+        expect(floats(described_class.new(9), count)).to eq(floats(described_class.new(9), 16).first(count))
+      end
+    end
+
+    it 'generates the same numbers for a String and an Array' do
+      expected = floats(described_class.new(3), 10)
+      expect(described_class.new(3).fill(Array.new(10))).to eq(expected)
+
+      expected = ints(described_class.new(3), 10, 1, 6)
+      expect(described_class.new(3).fill(Array.new(10), 1, 6)).to eq(expected)
+    end
+
+    it 'keeps floats within the bounds' do
+      values = floats(described_class.new(5), 1000, -2.0, 3.0)
+      expect(values).to all(be >= -2.0)
+      expect(values).to all(be < 3.0)
+    end
+
+    it 'generates floats between 0 and 1 by default' do
+      expect(floats(described_class.new(5), 1000)).to all(be_between(0.0, 1.0).inclusive)
+    end
+
+    it 'keeps integers within the inclusive bounds' do
+      values = ints(described_class.new(5), 1000, -3, 3)
+      expect(values).to all(be_between(-3, 3))
+      expect(values.uniq.sort).to eq((-3..3).to_a)
+    end
+
+    it 'generates a single value when the bounds are equal' do
+      expect(ints(described_class.new(5), 10, 4, 4)).to all(eq(4))
+    end
+
+    it 'generates integers across the full 32-bit range' do
+      values = ints(described_class.new(5), 100, -2**31, 2**31 - 1)
+      expect(values.uniq.size).to be > 1
+    end
+
+    it 'fills only whole values of a String' do
+      buffer = described_class.new(5).fill('x' * 10)
+      expect(buffer.bytesize).to eq(10)
+      expect(buffer[8, 2]).to eq('xx')
+    end
+
+    it 'replaces each element of an Array' do
+      values = described_class.new(5).fill([nil, 'a', :b], 0, 9)
+      expect(values.size).to eq(3)
+      expect(values).to all(be_an(Integer))
+    end
+
+    it 'returns the buffer' do
+      buffer = Array.new(4)
+      expect(described_class.new.fill(buffer)).to be(buffer)
+    end
+
+    it 'raises when the upper bound is less than the lower bound' do
+      expect { described_class.new.fill(Array.new(4), 5, 1) }.to raise_error(ArgumentError)
+    end
+
+    it 'raises when only one bound is given' do
+      expect { described_class.new.fill(Array.new(4), 5) }.to raise_error(ArgumentError)
+    end
+
+    it 'raises for other buffers' do
+      expect { described_class.new.fill(nil) }.to raise_error(TypeError)
+    end
+  end
+
+  describe '#split' do
+    it 'creates reproducible streams from a seeded generator' do
+      a = described_class.new(11)
+      b = described_class.new(11)
+      expect(floats(a.split, 32)).to eq(floats(b.split, 32))
+      expect(floats(a.split, 32)).to eq(floats(b.split, 32))
+      expect(floats(a, 32)).to eq(floats(b, 32))
+    end
+
+    it 'creates streams that differ from each other and the parent' do
+      rng = described_class.new(11)
+      first, second = rng.split, rng.split
+      sequences = [floats(rng, 32), floats(first, 32), floats(second, 32)]
+      expect(sequences.uniq.size).to eq(3)
+    end
+  end
+
+  describe '#rand' do
+    it 'generates the same numbers from the same seed' do
+      a = described_class.new(13)
+      b = described_class.new(13)
+      expect(Array.new(10) { a.rand }).to eq(Array.new(10) { b.rand })
+    end
+
+    it 'keeps integers within the inclusive bounds' do
+      rng = described_class.new(13)
+      expect(Array.new(500) { rng.rand(1, 6) }.uniq.sort).to eq((1..6).to_a)
+    end
+  end
+end
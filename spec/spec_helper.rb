@@ -0,0 +1,16 @@
+$LOAD_PATH.unshift(File.expand_path('../lib', __dir__))
+
+# Only the extension and its support files are loaded, as lib/rgss.rb starts a game when required
+require 'rgss/version'
+require 'rgss/log'
+require 'rgss/rgss'
+require 'rgss/archive'
+
+require 'fileutils'
+require 'tmpdir'
+
+RSpec.configure do |config|
+  config.disable_monkey_patching!
+  config.order = :random
+  Kernel.srand(config.seed)
+end